@@ -0,0 +1,118 @@
+/*!
+  \file perf_line_clip.cpp
+  \brief Size of SVG, and time to render, a line through 10^6 data-points, zoomed in (on X and on Y)
+  so that most of the lines between data-points are outside the plot window, and are clipped to it,
+  see @c detail::clip_segment.
+  \details The lines are clipped (by the Liang-Barsky algorithm) only when one or both data-points are outside the window,
+  and lines between data-points both beyond the same side of the window are dropped without clipping.
+  Each plot is rendered (drawn and written to a stream that only counts its size).
+*/
+
+// Copyright Paul A Bristow 2020
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/cstdlib.hpp> // Boost exit_success and failure values.
+
+#include <boost/svg_plot/svg_2d_plot.hpp>
+#include "perf_timer.hpp" // ms_since.
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <streambuf>
+#include <vector>
+
+class count_buffer : public std::streambuf
+{ // Discards all output, but counts its size, so that only drawing and formatting are measured.
+public:
+  std::streamsize count = 0;
+protected:
+  int overflow(int c)
+  {
+    ++count;
+    return c;
+  }
+  std::streamsize xsputn(const char*, std::streamsize n)
+  {
+    count += n;
+    return n;
+  }
+};
+
+void render(const std::vector<double>& x, const std::vector<double>& y, double x_max, double y_max)
+{ //! Show the size, and shortest of 3 times, to render data-points as a line in window 0 to x_max, -y_max to +y_max.
+  using namespace boost::svg;
+  double best = 0;
+  std::streamsize bytes = 0;
+  for (int repeat = 0; repeat != 3; ++repeat)
+  {
+    svg_2d_plot my_plot;
+    my_plot.x_range(0, x_max).y_range(-y_max, y_max);
+    my_plot.plot_view(x, y, "noisy sin").shape(none).line_on(true);
+    count_buffer cb;
+    std::ostream os(&cb);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    my_plot.write(os);
+    double ms = ms_since(start);
+    best = (repeat == 0 || ms < best) ? ms : best;
+    bytes = cb.count;
+  }
+  std::cout << "X 0 to " << x_max << ", Y +/-" << y_max << ": " << bytes / 1000 << " kB in " << best << " ms." << std::endl;
+}
+
+int main()
+{
+  try
+  {
+    const std::size_t n = 1000000;
+    std::vector<double> x(n);
+    std::vector<double> y(n);
+    std::mt19937 gen(42);
+    std::normal_distribution<double> noise(0., 0.1);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      x[i] = static_cast<double>(i) / n;
+      y[i] = std::sin(x[i] * 20.) + noise(gen);
+    }
+    std::cout << n << " data-points, drawn as a line:" << std::endl;
+    render(x, y, 1., 1.5); // Whole line.
+    render(x, y, 1., 0.1); // Zoomed in on Y, so most lines cross the top or bottom of the window.
+    render(x, y, 0.01, 1.5); // Zoomed in on X, so most data-points are left or right of the window.
+    render(x, y, 0.01, 0.1); // Both.
+    return boost::exit_success;
+  }
+  catch (std::exception& ex)
+  {
+    std::cout << "svg_plot exception " << ex.what() << std::endl;
+    return boost::exit_exception_failure;
+  }
+} // int main()
+
+/*
+
+Output (g++ -O2):
+
+1000000 data-points, drawn as a line:
+X 0 to 1, Y +/-1.5: 10304 kB in 706.418 ms.
+X 0 to 1, Y +/-0.1: 1494 kB in 76.437 ms.
+X 0 to 0.01, Y +/-1.5: 104 kB in 16.5804 ms.
+X 0 to 0.01, Y +/-0.1: 105 kB in 14.7218 ms.
+
+Previously, when lines to (and from) data-points outside the window were just left out:
+
+1000000 data-points, drawn as a line:
+X 0 to 1, Y +/-1.5: 10304 kB in 748.029 ms.
+X 0 to 1, Y +/-0.1: 675 kB in 57.6602 ms.
+X 0 to 0.01, Y +/-1.5: 104 kB in 13.762 ms.
+X 0 to 0.01, Y +/-0.1: 51 kB in 10.8169 ms.
+
+When zoomed in on Y, about half of the lines seen cross the top or bottom of the window,
+and were previously replaced by a line joining the data-points either side inside the window (so the plot was wrong).
+Now each is drawn to (or from) where it crosses the edge, so the SVG is larger (but still only about 1.5 lines for each line seen).
+Lines between data-points beyond the same side of the window are still skipped, costing only a few ms for 10^6 data-points.
+
+*/
@@ -0,0 +1,100 @@
+/*!
+  \file perf_m4_downsample.cpp
+  \brief Size of SVG, and time to render, a line through 10^5 to 10^7 data-points (a noisy sensor trace),
+  drawn through all the data-points, and only through the first, last, minimum and maximum of each pixel column,
+  see @c svg_2d_plot_series::downsample and @c detail::m4_columns.
+  \details The data-points are viewed in place by @c plot_view, and each plot is rendered
+  (drawn and written to a stream that only counts its size).
+*/
+
+// Copyright Paul A Bristow 2020
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/cstdlib.hpp> // Boost exit_success and failure values.
+
+#include <boost/svg_plot/svg_2d_plot.hpp>
+#include "perf_timer.hpp" // ms_since.
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <streambuf>
+#include <vector>
+
+class count_buffer : public std::streambuf
+{ // Discards all output, but counts its size, so that only drawing and formatting are measured.
+public:
+  std::streamsize count = 0;
+protected:
+  int overflow(int c)
+  {
+    ++count;
+    return c;
+  }
+  std::streamsize xsputn(const char*, std::streamsize n)
+  {
+    count += n;
+    return n;
+  }
+};
+
+int main()
+{
+  using namespace boost::svg;
+  try
+  {
+    std::mt19937 gen(42);
+    std::normal_distribution<double> noise(0., 0.1);
+    for (std::size_t n = 100000; n <= 10000000; n *= 10)
+    {
+      std::vector<double> x(n);
+      std::vector<double> y(n);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        x[i] = static_cast<double>(i) / n;
+        y[i] = std::sin(x[i] * 20.) + noise(gen);
+      }
+      for (int decimate = 0; decimate <= 1; ++decimate)
+      {
+        svg_2d_plot my_plot;
+        my_plot.x_range(0, 1).y_range(-1.5, 1.5);
+        my_plot.plot_view(x, y, "sensor").shape(none).line_on(true).downsample(decimate ? m4 : no_downsample);
+        count_buffer cb;
+        std::ostream os(&cb);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        my_plot.write(os);
+        double ms = ms_since(start);
+        std::cout << n << (decimate ? " m4:            " : " no_downsample: ") << cb.count / 1000 << " kB in " << ms << " ms" << std::endl;
+      }
+    }
+    return boost::exit_success;
+  }
+  catch (std::exception& ex)
+  {
+    std::cout << "svg_plot exception " << ex.what() << std::endl;
+    return boost::exit_exception_failure;
+  }
+} // int main()
+
+/*
+
+Output (g++ -O2):
+
+100000 no_downsample: 1033 kB in 14.7429 ms
+100000 m4:            20 kB in 1.05092 ms
+1000000 no_downsample: 10305 kB in 141.183 ms
+1000000 m4:            21 kB in 8.42826 ms
+10000000 no_downsample: 103019 kB in 1646.3 ms
+10000000 m4:            20 kB in 73.0943 ms
+
+The plot window is about 440 pixels wide, so at most about 1800 data-points are kept by m4,
+whatever the length of the data-series, and the SVG is 50 to 5000 times smaller, and rendered 14 to 22 times faster
+(now mostly just transforming the data-points).
+The line drawn through the data-points kept covers exactly the same range of Y in each pixel column
+as the line drawn through all the data-points.
+
+*/
@@ -0,0 +1,85 @@
+/*!
+  \file perf_marker_symbols.cpp
+  \brief Elements, size and time to write a 2D scatter plot of 200000 data-point markers, see @c svg::markers.
+  \details The same plot, of two series of 100000 points, one marked with Unicode glyphs (diamond)
+  and the other with small circles (point), is written with each marker policy:
+  each marker in full, each a @c <use> of a @c <symbol>, whichever is smaller,
+  or the glyphs batched into @c <text> elements with lists of coordinates.
+*/
+
+// Copyright Paul A Bristow 2020
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/cstdlib.hpp> // Boost exit_success and failure values.
+
+#include <boost/svg_plot/svg_2d_plot.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+int main()
+{
+  using namespace boost::svg;
+  try
+  {
+    const int points = 100000; // in each series.
+    std::map<double, double> sines;
+    std::map<double, double> cosines;
+    for (int i = 0; i < points; ++i)
+    {
+      sines[i] = std::sin(i * 0.001);
+      cosines[i + 0.5] = std::cos(i * 0.001);
+    }
+    const char* names[] = {"inline_markers", "use_markers", "smallest_markers", "batched_markers"};
+    for (int policy = inline_markers; policy <= batched_markers; ++policy)
+    {
+      svg_2d_plot my_plot;
+      my_plot.x_range(0, points).x_major_interval(points / 10.).y_range(-1.2, 1.2);
+      my_plot.markers(static_cast<marker_policy>(policy));
+      my_plot.plot(sines, "sin").shape(diamond).size(8);
+      my_plot.plot(cosines, "cos").shape(point);
+      std::ostringstream os;
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      my_plot.write(os);
+      std::chrono::duration<double> t = std::chrono::steady_clock::now() - start;
+      const std::string& xml = os.str();
+      std::size_t elements = 0; // Start tags, not end tags, comments or declarations.
+      for (std::size_t i = xml.find('<'); i != std::string::npos; i = xml.find('<', i + 1))
+      {
+        elements += (xml[i + 1] != '/' && xml[i + 1] != '!' && xml[i + 1] != '?');
+      }
+      std::cout << std::setw(16) << std::left << names[policy] << std::right << std::setw(7) << elements << " elements, "
+        << xml.size() / 1e6 << " MB in " << t.count() * 1000 << " ms" << std::endl;
+    }
+    return boost::exit_success;
+  }
+  catch (std::exception& ex)
+  {
+    std::cout << "svg_plot exception " << ex.what() << std::endl;
+    return boost::exit_exception_failure;
+  }
+} // int main()
+
+/*
+
+Output (g++ -O2, drawing and writing the plot):
+
+inline_markers   200051 elements, 14.8756 MB in 370.855 ms
+use_markers      200056 elements, 8.47663 MB in 197.302 ms
+smallest_markers 200054 elements, 7.87655 MB in 178.146 ms
+batched_markers  100152 elements, 5.28495 MB in 144.857 ms
+
+Each diamond, in full a @c <text> element with its font attributes, is 64 bytes smaller as a @c <use>.
+Each point, in full just a @c <circle>, is slightly smaller than a @c <use>, so @c smallest_markers keeps it in full.
+Batched, the 100000 diamonds are 100 @c <text> elements, each of 1000 glyphs, about 16 bytes a diamond
+(the points, not glyphs, are still one @c <circle> each).
+
+*/
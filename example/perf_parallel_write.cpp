@@ -0,0 +1,99 @@
+/*!
+  \file perf_parallel_write.cpp
+  \brief Time writing an SVG image of many data-points with 1, 2, 4 ... threads, see @c svg::write_threads.
+  \details The image has four layers, like the data-point markers and value labels of a plot,
+  each of half a million elements, and is written with increasing numbers of threads,
+  checking that the SVG XML written is exactly the same.
+*/
+
+// Copyright Paul A Bristow 2020
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/cstdlib.hpp> // Boost exit_success and failure values.
+
+#include <boost/svg_plot/svg.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+int main()
+{
+  using namespace boost::svg;
+  try
+  {
+    const int layers = 4; // Like data-points, lines and X and Y value labels of a plot.
+    const int points = 500000; // in each layer.
+    svg image;
+    image.x_size(1000);
+    image.y_size(500);
+    for (int layer = 0; layer < layers; ++layer)
+    { // Layers of data-point markers, each a group of many elements.
+      g_element& g = image.add_g_element();
+      g.style().stroke_color(blue);
+      for (int i = 0; i < points; ++i)
+      {
+        double x = 50. + 900. * i / points;
+        double y = 250. + 200. * std::sin(i * 0.0001 + layer);
+        if (layer % 2 == 0)
+        {
+          g.circle(x, y, 2);
+        }
+        else
+        {
+          g.text(x, y, "1.23");
+        }
+      }
+    }
+
+    std::string expected;
+    const unsigned int hardware = std::thread::hardware_concurrency();
+    std::cout << hardware << " hardware threads." << std::endl;
+    for (unsigned int threads = 1; threads <= (std::max)(4U, hardware); threads *= 2)
+    {
+      image.write_threads(threads);
+      std::ostringstream os;
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      image.write(os);
+      std::chrono::duration<double> t = std::chrono::steady_clock::now() - start;
+      std::cout << threads << " threads: " << os.str().size() / 1e6 << " MB in " << t.count() * 1000 << " ms" << std::endl;
+      if (threads == 1)
+      {
+        expected = os.str();
+      }
+      else if (os.str() != expected)
+      {
+        std::cout << "Parallel write differs!" << std::endl;
+        return boost::exit_failure;
+      }
+    }
+    return boost::exit_success;
+  }
+  catch (std::exception& ex)
+  {
+    std::cout << "svg_plot exception " << ex.what() << std::endl;
+    return boost::exit_exception_failure;
+  }
+} // int main()
+
+/*
+
+Output (g++ -O2, on a machine with a single hardware thread):
+
+1 hardware threads.
+1 threads: 75.4407 MB in 757.251 ms
+2 threads: 75.4407 MB in 935.117 ms
+4 threads: 75.4407 MB in 935.853 ms
+
+With only one hardware thread, the extra copy of each segment from its buffer costs about 20%.
+With more hardware threads, the segments (of about 1/8 of the document per thread) are written concurrently,
+so write time falls towards that of the copy.
+
+*/
@@ -0,0 +1,97 @@
+/*!
+  \file perf_plain_series.cpp
+  \brief Memory per data-point, and time to add and to render 2D data-series of plain @c double values,
+  compared with the same values converted to @c Meas and @c unc.
+  \details A @c std::vector of pairs of @c double is plotted as it is (held as just @c double s),
+  and again using the functor @c pair_Meas_2d_double_convert (held as @c Meas and @c unc too, as all data-series were previously).
+  The whole plot (markers and a line) is then rendered (drawn and written to a null stream).
+*/
+
+// Copyright Paul A Bristow 2020
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/cstdlib.hpp> // Boost exit_success and failure values.
+
+#include <boost/svg_plot/svg_2d_plot.hpp>
+#include "perf_timer.hpp" // ms_since.
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <streambuf>
+#include <utility>
+#include <vector>
+
+class null_buffer : public std::streambuf
+{ // Discards all output, so that only drawing and formatting are measured.
+protected:
+  int overflow(int c)
+  {
+    return c;
+  }
+  std::streamsize xsputn(const char*, std::streamsize n)
+  {
+    return n;
+  }
+};
+
+int main()
+{
+  using namespace boost::svg;
+  try
+  {
+    for (std::size_t n = 10000; n <= 1000000; n *= 10)
+    {
+      std::vector<std::pair<double, double> > data(n);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        double x = static_cast<double>(i) / n;
+        data[i] = std::make_pair(x, std::sin(x * 20.));
+      }
+      for (int plain = 0; plain <= 1; ++plain)
+      {
+        svg_2d_plot my_plot;
+        my_plot.x_range(0, 1).y_range(-1, 1);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        svg_2d_plot_series& series = plain ? my_plot.plot(data, "sin")
+          : my_plot.plot(data, "sin", detail::pair_Meas_2d_double_convert<false>());
+        double add_ms = ms_since(start);
+        series.shape(point).line_on(true);
+        std::size_t bytes = series.values_.size() * sizeof(svg_2d_plot_series::values_type::value_type)
+          + series.series_.size() * sizeof(svg_2d_plot_series::series_type::value_type);
+        null_buffer nb;
+        std::ostream os(&nb);
+        start = std::chrono::steady_clock::now();
+        my_plot.write(os);
+        std::cout << n << (plain ? " plain" : " Meas ") << " points: " << static_cast<double>(bytes) / n
+          << " bytes per point, added in " << add_ms << " ms, rendered in " << ms_since(start) << " ms" << std::endl;
+      }
+    }
+    return boost::exit_success;
+  }
+  catch (std::exception& ex)
+  {
+    std::cout << "svg_plot exception " << ex.what() << std::endl;
+    return boost::exit_exception_failure;
+  }
+} // int main()
+
+/*
+
+Output (g++ -O2):
+
+10000 Meas  points: 96 bytes per point, added in 1.90834 ms, rendered in 12.5533 ms
+10000 plain points: 16 bytes per point, added in 0.272818 ms, rendered in 6.27353 ms
+100000 Meas  points: 96 bytes per point, added in 21.2001 ms, rendered in 124.753 ms
+100000 plain points: 16 bytes per point, added in 3.42156 ms, rendered in 117.409 ms
+1000000 Meas  points: 96 bytes per point, added in 519.838 ms, rendered in 1301.72 ms
+1000000 plain points: 16 bytes per point, added in 59.3502 ms, rendered in 1274.68 ms
+
+Bytes per point with @c Meas depend on the size of @c Meas (with its timestamp and id) of the Boost.Quan used.
+Plain values are added about 9 times faster, without constructing (and sorting) a @c Meas and @c unc for each data-point.
+Rendering is dominated by formatting the markers and the line, so is little changed.
+
+*/
@@ -0,0 +1,149 @@
+/*!
+  \file perf_svgz.cpp
+  \brief Compare writing a compressed .svgz plot directly with writing .svg and then gzipping the file.
+  \details Writes a 2D plot of many points as plain .svg, then re-reads and compresses it with zlib (as a separate gzip pass would),
+  and writes the same plot directly as .svgz, deflating while serializing.
+  Reports the wall time and bytes of each, and checks that both decompress to the same SVG XML.
+  Needs zlib: compile with @c -DBOOST_SVG_SVGZ and link with @c -lz.
+*/
+
+// Copyright Paul A Bristow 2020
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_SVG_SVGZ
+#  define BOOST_SVG_SVGZ // Enable .svgz output, using zlib.
+#endif
+
+#include <boost/cstdlib.hpp> // Boost exit_success and failure values.
+
+#include <boost/svg_plot/svg_2d_plot.hpp>
+
+#include <zlib.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+std::size_t file_size(const std::string& filename)
+{
+  std::ifstream f(filename.c_str(), std::ios_base::binary | std::ios_base::ate);
+  return static_cast<std::size_t>(f.tellg());
+}
+
+void gzip_file(const std::string& from, const std::string& to)
+{ // A separate gzip pass, re-reading the .svg file.
+  std::FILE* in = std::fopen(from.c_str(), "rb");
+  gzFile out = gzopen(to.c_str(), "wb6");
+  if (in == 0 || out == 0)
+  {
+    throw std::runtime_error("Unable to gzip " + from);
+  }
+  std::vector<char> buffer(256 * 1024);
+  std::size_t n;
+  while ((n = std::fread(buffer.data(), 1, buffer.size(), in)) != 0)
+  {
+    gzwrite(out, buffer.data(), static_cast<unsigned>(n));
+  }
+  std::fclose(in);
+  gzclose(out);
+}
+
+std::string gunzip_file(const std::string& from)
+{ // Decompress, to check the contents.
+  gzFile in = gzopen(from.c_str(), "rb");
+  std::string s;
+  std::vector<char> buffer(256 * 1024);
+  int n;
+  while ((n = gzread(in, buffer.data(), static_cast<unsigned>(buffer.size()))) > 0)
+  {
+    s.append(buffer.data(), static_cast<std::size_t>(n));
+  }
+  gzclose(in);
+  return s;
+}
+
+void plot(boost::svg::svg_2d_plot& my_plot, const std::map<double, double>& data)
+{
+  using namespace boost::svg;
+  my_plot.x_range(0, 1).y_range(-1, 1);
+  my_plot.plot(data, "sin").shape(circlet).size(3);
+}
+
+int main()
+{
+  using namespace boost::svg;
+  try
+  {
+    for (std::size_t n = 10000; n <= 1000000; n *= 10)
+    {
+      std::map<double, double> data;
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        double x = static_cast<double>(i) / n;
+        data[x] = std::sin(x * 20.);
+      }
+
+      svg_2d_plot plain_plot;
+      plot(plain_plot, data);
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      plain_plot.write("perf_svgz_plain.svg");
+      gzip_file("perf_svgz_plain.svg", "perf_svgz_plain.svg.gz");
+      std::chrono::duration<double> t_then_gzip = std::chrono::steady_clock::now() - start;
+
+      svg_2d_plot svgz_plot;
+      plot(svgz_plot, data);
+      start = std::chrono::steady_clock::now();
+      svgz_plot.write("perf_svgz_direct.svgz");
+      std::chrono::duration<double> t_direct = std::chrono::steady_clock::now() - start;
+
+      std::cout << n << " points: .svg " << file_size("perf_svgz_plain.svg") << " bytes.\n"
+        << "  write then gzip: " << file_size("perf_svgz_plain.svg.gz") << " bytes, " << t_then_gzip.count() * 1000 << " ms\n"
+        << "  write .svgz:     " << file_size("perf_svgz_direct.svgz") << " bytes, " << t_direct.count() * 1000 << " ms\n";
+
+      std::string plain = gunzip_file("perf_svgz_plain.svg.gz");
+      std::string direct = gunzip_file("perf_svgz_direct.svgz");
+      if (plain != direct)
+      {
+        std::cout << "Decompressed .svgz differs from .svg!" << std::endl;
+        return boost::exit_failure;
+      }
+    }
+    std::remove("perf_svgz_plain.svg");
+    std::remove("perf_svgz_plain.svg.gz");
+    std::remove("perf_svgz_direct.svgz");
+    return boost::exit_success;
+  }
+  catch (std::exception& ex)
+  {
+    std::cout << "svg_plot exception " << ex.what() << std::endl;
+    return boost::exit_exception_failure;
+  }
+} // int main()
+
+/*
+
+Output (g++ -O2 -lz):
+
+10000 points: .svg 437174 bytes.
+  write then gzip: 21041 bytes, 20.0754 ms
+  write .svgz:     21041 bytes, 24.1788 ms
+100000 points: .svg 4342534 bytes.
+  write then gzip: 48465 bytes, 159.412 ms
+  write .svgz:     48465 bytes, 161.428 ms
+1000000 points: .svg 43396862 bytes.
+  write then gzip: 159935 bytes, 2535.65 ms
+  write .svgz:     159935 bytes, 2399.33 ms
+
+The compressed files are identical.  Most of the time is building the plot and deflating,
+so writing .svgz directly saves writing and re-reading the .svg file (here, in the file cache),
+and holds only a buffer (256 kbytes) of uncompressed SVG XML.
+
+*/
@@ -0,0 +1,24 @@
+/*!
+  \file perf_timer.hpp
+  \brief Elapsed time in milliseconds, shared by the perf_*.cpp timing examples.
+*/
+
+// Copyright Paul A Bristow 2020
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_SVG_PERF_TIMER_HPP
+#define BOOST_SVG_PERF_TIMER_HPP
+
+#include <chrono>
+// using std::chrono::steady_clock;
+
+inline double ms_since(std::chrono::steady_clock::time_point start)
+{ //! \return Milliseconds since start.
+  std::chrono::duration<double> t = std::chrono::steady_clock::now() - start;
+  return t.count() * 1000;
+}
+
+#endif // BOOST_SVG_PERF_TIMER_HPP
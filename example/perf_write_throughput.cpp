@@ -0,0 +1,128 @@
+/*!
+  \file perf_write_throughput.cpp
+  \brief Measure the throughput (MB/s) of writing SVG of a path of a million points.
+  \details Compares formatting the coordinates using iostream @c operator<< with @c detail::coord
+  (used by all element write() functions), and times write() of a whole path element,
+  with the default and compact path data (see @c svg::compact_paths).
+*/
+
+// Copyright Paul A Bristow 2020
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/cstdlib.hpp> // Boost exit_success and failure values.
+
+#include <boost/svg_plot/svg.hpp>
+#include <boost/svg_plot/detail/number_format.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <streambuf>
+#include <vector>
+
+class counting_buffer : public std::streambuf
+{ // Discards all output, counting the chars, so that only formatting is measured.
+public:
+  std::size_t count;
+  counting_buffer() : count(0)
+  {
+  }
+protected:
+  int overflow(int c)
+  {
+    ++count;
+    return c;
+  }
+  std::streamsize xsputn(const char*, std::streamsize n)
+  {
+    count += static_cast<std::size_t>(n);
+    return n;
+  }
+};
+
+void report(const char* what, std::size_t bytes, std::chrono::duration<double> t)
+{
+  std::cout << what << bytes / 1000000. << " MB in " << t.count() * 1000 << " ms, "
+    << bytes / 1e6 / t.count() << " MB/s" << std::endl;
+}
+
+int main()
+{
+  using namespace boost::svg;
+  try
+  {
+    const std::size_t n = 1000000;
+    std::vector<double> xs(n);
+    std::vector<double> ys(n);
+    for (std::size_t i = 0; i < n; ++i)
+    { // Typical SVG coordinates of a plot 500 by 400 pixels.
+      xs[i] = 50. + 400. * i / n;
+      ys[i] = 200. + 150. * std::sin(i * 0.001);
+    }
+
+    counting_buffer iostream_buf;
+    std::ostream iostream_os(&iostream_buf);
+    iostream_os.precision(3); // Default svg::coord_precision().
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      iostream_os << xs[i] << "," << ys[i] << " ";
+    }
+    report("iostream << double:   ", iostream_buf.count, std::chrono::steady_clock::now() - start);
+
+    counting_buffer coord_buf;
+    std::ostream coord_os(&coord_buf);
+    coord_os.precision(3);
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      coord_os << detail::coord(xs[i]) << "," << detail::coord(ys[i]) << " ";
+    }
+    report("detail::coord:        ", coord_buf.count, std::chrono::steady_clock::now() - start);
+
+    path_element path;
+    path.reserve(n);
+    path.M(xs[0], ys[0]);
+    for (std::size_t i = 1; i < n; ++i)
+    {
+      path.L(xs[i], ys[i]);
+    }
+    counting_buffer path_buf;
+    std::ostream path_os(&path_buf);
+    path_os.precision(3);
+    start = std::chrono::steady_clock::now();
+    path.write(path_os);
+    report("path_element write(): ", path_buf.count, std::chrono::steady_clock::now() - start);
+
+    counting_buffer compact_buf;
+    std::ostream compact_os(&compact_buf);
+    compact_os.precision(3);
+    compact_os.iword(detail::compact_paths_index()) = true; // As set by svg::compact_paths(true).
+    start = std::chrono::steady_clock::now();
+    path.write(compact_os);
+    report("compact path write(): ", compact_buf.count, std::chrono::steady_clock::now() - start);
+
+    return boost::exit_success;
+  }
+  catch (std::exception& ex)
+  {
+    std::cout << "svg_plot exception " << ex.what() << std::endl;
+    return boost::exit_exception_failure;
+  }
+} // int main()
+
+/*
+
+Output (g++ -O2):
+
+iostream << double:   8.30309 MB in 869.627 ms, 9.54788 MB/s
+detail::coord:        8.30309 MB in 168.188 ms, 49.3679 MB/s
+path_element write(): 10.3031 MB in 172.609 ms, 59.6907 MB/s
+compact path write(): 2.40989 MB in 175.274 ms, 13.7493 MB/s
+
+Compact path data are less than a quarter of the size, in about the same time.
+
+*/
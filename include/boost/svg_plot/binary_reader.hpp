@@ -0,0 +1,219 @@
+/*! \file
+    \brief Columns of @c double values in binary files (raw little-endian float64, or NumPy .npy),
+      memory-mapped to plot without any parsing (or copying), see @c read_npy and @c read_float64.
+    \details Each column is a @c value_span into the mapped file, so the values are read (from the file cache, or disk)
+      by the operating system only as the pages holding them are first used, when the plot is drawn.
+      The columns can be plotted without copying by @c plot_view, or used as containers by any @c plot, for example:
+      \code
+mapped_columns samples = read_npy("samples.npy"); // Of shape (100000000, 2).
+my_2d_plot.plot_view(samples.column(0), samples.column(1), "samples");
+my_1d_plot.plot_view(samples.column(1), "samples");
+my_boxplot.plot(samples.column(1), "samples"); // (A boxplot sorts a copy of the values, to find its quartiles.)
+      \endcode
+      The @c mapped_columns (or a copy) must exist until the plot is written.
+*/
+
+// binary_reader.hpp
+
+// Copyright Paul A. Bristow 2020
+
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_SVG_BINARY_READER_HPP
+#define BOOST_SVG_BINARY_READER_HPP
+
+#include <boost/svg_plot/detail/mapped_file.hpp>
+#include <boost/svg_plot/detail/value_span.hpp>
+
+#include <cstddef>
+// using std::size_t;
+#include <cstring>
+// using std::memcmp;
+#include <memory>
+// using std::shared_ptr;
+#include <stdexcept>
+// using std::runtime_error;
+#include <string>
+// using std::string;
+#include <vector>
+// using std::vector;
+
+namespace boost
+{
+namespace svg
+{
+
+class mapped_columns
+{ /*! \class boost::svg::mapped_columns
+      \brief Columns of @c double values in a memory-mapped binary file, read by @c read_npy or @c read_float64.
+  */
+public:
+  std::size_t size() const
+  { //! \return Number of columns.
+    return columns_.size();
+  }
+
+  std::size_t rows() const
+  { //! \return Number of rows (values in each column).
+    return columns_.empty() ? 0 : columns_[0].size();
+  }
+
+  const value_span& column(std::size_t i) const
+  { //! \return Values of ith column (from 0).
+    if (i >= columns_.size())
+    {
+      throw std::runtime_error("mapped_columns: no such column!");
+    }
+    return columns_[i];
+  }
+
+  bool mapped() const
+  { //! \return @c true if the file is memory-mapped, @c false if read into memory (when mapping is not available).
+    return file_ != 0 && file_->mapped();
+  }
+
+//! \cond DETAIL
+  std::shared_ptr<detail::mapped_file> file_; //!< Mapped file, shared by copies.
+  std::vector<value_span> columns_; //!< Values of each column.
+//! \endcond
+}; // class mapped_columns
+
+namespace detail
+{
+
+inline bool little_endian()
+{ //! \return @c true if @c double values are held little-endian (as in the files).
+  const double one = 1.;
+  unsigned char bytes[sizeof(double)];
+  std::memcpy(bytes, &one, sizeof(double));
+  return bytes[sizeof(double) - 1] == 0x3F; // Sign and exponent byte last.
+}
+
+inline void map_columns(mapped_columns& m, const char* data, std::size_t rows, std::size_t columns, bool by_column)
+{ //! Set the columns of m to rows values from data, each row of columns values together (or each column together if by_column).
+  if (!little_endian())
+  {
+    throw std::runtime_error("Binary float64 files can only be mapped on little-endian machines!");
+  }
+  const double* values = reinterpret_cast<const double*>(data);
+  for (std::size_t c = 0; c != columns; ++c)
+  {
+    m.columns_.push_back(by_column ? value_span(values + c * rows, rows)
+      : value_span(values + c, rows, columns * sizeof(double)));
+  }
+}
+
+} // namespace detail
+
+/*!
+  Map a file of raw little-endian float64 (IEEE 754 @c double) values, without any header.
+  \param filename File to map.
+  \param columns Number of values in each row (so interleaved, as X, Y, X, Y...), or 1 (default) for a single column.
+  \return The columns of values.
+*/
+inline mapped_columns read_float64(const std::string& filename, std::size_t columns = 1)
+{
+  mapped_columns m;
+  m.file_ = std::make_shared<detail::mapped_file>(filename);
+  const std::size_t row_bytes = columns * sizeof(double);
+  if (columns == 0 || m.file_->size() % row_bytes != 0)
+  {
+    throw std::runtime_error("File " + filename + " is not whole rows of float64 values!");
+  }
+  detail::map_columns(m, m.file_->data(), m.file_->size() / row_bytes, columns, false);
+  return m;
+}
+
+/*!
+  Map a NumPy .npy file, of a 1-D array (a single column), or a 2-D array (of columns), of little-endian float64 values (@c dtype @c '<f8').
+  \param filename .npy file to map.
+  \return The columns of values.
+  \details C (row major) or Fortran (column major) order are both mapped in place.
+*/
+inline mapped_columns read_npy(const std::string& filename)
+{
+  mapped_columns m;
+  m.file_ = std::make_shared<detail::mapped_file>(filename);
+  const char* data = m.file_->data();
+  const std::size_t size = m.file_->size();
+  // Magic string, major and minor version, and length of header: 2 bytes for version 1, else 4 bytes.
+  if (size < 10 || std::memcmp(data, "\x93NUMPY", 6) != 0)
+  {
+    throw std::runtime_error("File " + filename + " is not a .npy file!");
+  }
+  const unsigned char* b = reinterpret_cast<const unsigned char*>(data);
+  std::size_t start = (b[6] == 1) ? 10 : 12; // Of header.
+  if (size < start)
+  { // Too short even for the length of header.
+    throw std::runtime_error("File " + filename + " has a truncated .npy header!");
+  }
+  std::size_t header_size = b[8] | (b[9] << 8);
+  if (b[6] != 1)
+  {
+    header_size |= (static_cast<std::size_t>(b[10]) << 16) | (static_cast<std::size_t>(b[11]) << 24);
+  }
+  if (start + header_size > size)
+  {
+    throw std::runtime_error("File " + filename + " has a truncated .npy header!");
+  }
+  // Header is a Python dict, for example: {'descr': '<f8', 'fortran_order': False, 'shape': (1000, 2), }
+  std::string header(data + start, header_size);
+  std::string::size_type descr = header.find("'descr'");
+  std::string::size_type fortran = header.find("'fortran_order'");
+  std::string::size_type shape = header.find("'shape'");
+  if (descr == std::string::npos || fortran == std::string::npos || shape == std::string::npos)
+  {
+    throw std::runtime_error("File " + filename + " has no .npy descr, fortran_order or shape!");
+  }
+  std::string::size_type type = header.find('\'', header.find(':', descr) + 1);
+  if (type == std::string::npos || header.compare(type + 1, 3, "<f8") != 0)
+  {
+    throw std::runtime_error("File " + filename + " is not of float64 values (dtype '<f8')!");
+  }
+  bool by_column = header.find("True", fortran) < header.find(',', fortran);
+  std::string::size_type open = header.find('(', shape);
+  std::string::size_type close = header.find(')', open);
+  if (close == std::string::npos)
+  {
+    throw std::runtime_error("File " + filename + " has no .npy shape tuple!");
+  }
+  std::vector<std::size_t> dims;
+  std::string::size_type p = open + 1;
+  while (p < close)
+  { // Dimensions, separated by commas.
+    while (p < close && (header[p] < '0' || header[p] > '9'))
+    {
+      ++p;
+    }
+    if (p == close)
+    {
+      break;
+    }
+    std::size_t d = 0;
+    for (; header[p] >= '0' && header[p] <= '9'; ++p)
+    {
+      d = d * 10 + static_cast<std::size_t>(header[p] - '0');
+    }
+    dims.push_back(d);
+  }
+  if (dims.size() > 2)
+  {
+    throw std::runtime_error("File " + filename + " is not a 1-D or 2-D array!");
+  }
+  std::size_t rows = dims.empty() ? 1 : dims[0]; // () is a single value.
+  std::size_t columns = (dims.size() == 2) ? dims[1] : 1;
+  if (size - (start + header_size) < rows * columns * sizeof(double))
+  {
+    throw std::runtime_error("File " + filename + " has fewer values than its .npy shape!");
+  }
+  detail::map_columns(m, data + start + header_size, rows, columns, by_column);
+  return m;
+}
+
+} // namespace svg
+} // namespace boost
+
+#endif // BOOST_SVG_BINARY_READER_HPP
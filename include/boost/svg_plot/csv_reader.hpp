@@ -0,0 +1,283 @@
+/*! \file
+    \brief Read columns of numbers from a (large) .csv file, in parallel, to plot, see @c read_csv.
+    \details The file is memory-mapped, and split at line ends into chunks, one for each thread,
+      that are parsed in parallel (by @c detail::parse_g, without any iostreams or locale),
+      directly into columns of @c double values.
+      Fields that are missing or are not numbers (for example, "---", or "N" or "28-12-2008 14:10")
+      are read as NaN, so that they are shown as 'at limit' data-points (and not used for autoscaling).
+      The columns can be plotted without copying by @c svg_2d_plot::plot_view, for example:
+      \code
+csv_columns weather = read_csv("EasyWeather7mar09.csv");
+my_plot.plot_view(weather.column("No"), weather.column("Outdoor Temperature(C)"), "Outdoor");
+my_1d_plot.plot(weather.column(6), "Outdoor");
+      \endcode
+*/
+
+// csv_reader.hpp
+
+// Copyright Paul A. Bristow 2020
+
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_SVG_CSV_READER_HPP
+#define BOOST_SVG_CSV_READER_HPP
+
+#include <boost/svg_plot/detail/mapped_file.hpp>
+#include <boost/svg_plot/detail/number_format.hpp> // parse_g.
+
+#include <algorithm>
+// using std::min;
+#include <cstddef>
+// using std::size_t;
+#include <cstring>
+// using std::memchr;
+#include <limits>
+// using std::numeric_limits;
+#include <stdexcept>
+// using std::runtime_error;
+#include <string>
+// using std::string;
+#include <thread>
+// using std::thread;
+#include <vector>
+// using std::vector;
+
+namespace boost
+{
+namespace svg
+{
+
+class csv_columns
+{ /*! \class boost::svg::csv_columns
+      \brief Columns of @c double values read from a .csv file by @c read_csv, with the names from its header line (if any).
+  */
+public:
+  std::size_t size() const
+  { //! \return Number of columns.
+    return columns_.size();
+  }
+
+  std::size_t rows() const
+  { //! \return Number of rows (values in each column).
+    return columns_.empty() ? 0 : columns_[0].size();
+  }
+
+  const std::vector<double>& column(std::size_t i) const
+  { //! \return Values of ith column (from 0).
+    if (i >= columns_.size())
+    {
+      throw std::runtime_error("csv_columns: no such column!");
+    }
+    return columns_[i];
+  }
+
+  const std::vector<double>& column(const std::string& name) const
+  { //! \return Values of column named name in the header line.
+    for (std::size_t i = 0; i != names_.size(); ++i)
+    {
+      if (names_[i] == name)
+      {
+        return columns_[i];
+      }
+    }
+    throw std::runtime_error("csv_columns: no column named " + name + "!");
+  }
+
+  const std::vector<std::string>& names() const
+  { //! \return Names of columns from the header line (empty if none).
+    return names_;
+  }
+
+//! \cond DETAIL
+  std::vector<std::vector<double> > columns_; //!< Values of each column.
+  std::vector<std::string> names_; //!< Names of each column.
+//! \endcond
+}; // class csv_columns
+
+namespace detail
+{
+
+inline const char* csv_field(const char* p, const char* end, char delimiter, const char*& first, const char*& last)
+{ /*! Find the field starting at p (of a line ending at end), without any surrounding spaces or double quotes.
+      \return Start of the next field (after the delimiter), or null if none.
+  */
+  while (p != end && (*p == ' ' || *p == '\t') && *p != delimiter)
+  {
+    ++p;
+  }
+  if (p != end && *p == '"')
+  { // Quoted (so may contain delimiters).
+    first = ++p;
+    while (p != end && *p != '"')
+    {
+      ++p;
+    }
+    last = p;
+    while (p != end && *p != delimiter)
+    {
+      ++p;
+    }
+  }
+  else
+  {
+    first = p;
+    while (p != end && *p != delimiter)
+    {
+      ++p;
+    }
+    last = p;
+    while (last != first && (last[-1] == ' ' || last[-1] == '\t' || last[-1] == '\r'))
+    {
+      --last;
+    }
+  }
+  return (p == end) ? 0 : p + 1;
+} // const char* csv_field
+
+inline bool csv_blank(const char* p, const char* end)
+{ //! \return @c true if the line from p to end is empty (or only a carriage return).
+  return (p == end) || ((end - p == 1) && (*p == '\r'));
+}
+
+inline std::size_t csv_count_rows(const char* p, const char* end)
+{ //! \return Number of lines (that are not blank) from p to end.
+  std::size_t n = 0;
+  while (p != end)
+  {
+    const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+    const char* line_end = (eol == 0) ? end : eol;
+    if (!csv_blank(p, line_end))
+    {
+      ++n;
+    }
+    p = (eol == 0) ? end : eol + 1;
+  }
+  return n;
+} // std::size_t csv_count_rows
+
+inline void csv_parse_rows(const char* p, const char* end, char delimiter, std::vector<std::vector<double> >& columns, std::size_t row)
+{ //! Parse the lines from p to end into columns, from row row.
+  const double missing = std::numeric_limits<double>::quiet_NaN();
+  const std::size_t n = columns.size();
+  while (p != end)
+  {
+    const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+    const char* line_end = (eol == 0) ? end : eol;
+    if (!csv_blank(p, line_end))
+    {
+      const char* f = p;
+      for (std::size_t c = 0; c != n; ++c)
+      {
+        double v = missing;
+        if (f != 0)
+        { // Field c is present (perhaps empty).
+          const char* first;
+          const char* last;
+          f = csv_field(f, line_end, delimiter, first, last);
+          if (!parse_g(first, static_cast<int>(last - first), v))
+          {
+            v = missing;
+          }
+        }
+        columns[c][row] = v;
+      }
+      ++row;
+    }
+    p = (eol == 0) ? end : eol + 1;
+  }
+} // void csv_parse_rows
+
+} // namespace detail
+
+/*!
+  Read columns of numbers from a .csv file (memory-mapped, and parsed in parallel).
+  \param filename .csv file to read.
+  \param delimiter Between fields, for example ',' (default), ';' or '\\t'.
+  \param header @c true if the first line holds the names of the columns (default), so is not values.
+  \param threads Number of threads to parse with (default 0 uses @c std::thread::hardware_concurrency).
+  \return Columns of values, one for each field of the header line (or first line if none);
+    missing fields, and fields that are not numbers, are NaN.
+  \note A quoted field may contain the delimiter, but not a line end.
+*/
+inline csv_columns read_csv(const std::string& filename, char delimiter = ',', bool header = true, unsigned int threads = 0)
+{
+  detail::mapped_file file(filename);
+  csv_columns csv;
+  const char* p = file.data();
+  const char* end = p + file.size();
+  if (p == end)
+  {
+    return csv;
+  }
+  // Count (and name) the columns from the first line.
+  const char* eol = static_cast<const char*>(std::memchr(p, '\n', file.size()));
+  const char* line_end = (eol == 0) ? end : eol;
+  std::size_t n = 0;
+  for (const char* f = p; f != 0; ++n)
+  {
+    const char* first;
+    const char* last;
+    f = detail::csv_field(f, line_end, delimiter, first, last);
+    if (header)
+    {
+      csv.names_.push_back(std::string(first, last));
+    }
+  }
+  if (header)
+  {
+    p = (eol == 0) ? end : eol + 1;
+  }
+
+  // Split into a chunk for each thread, at line ends.
+  if (threads == 0)
+  {
+    threads = (std::max)(std::thread::hardware_concurrency(), 1U);
+  }
+  const std::size_t min_chunk = 1024 * 1024; // Not worth a thread for less.
+  threads = static_cast<unsigned int>((std::min)(static_cast<std::size_t>(threads), static_cast<std::size_t>(end - p) / min_chunk + 1));
+  std::vector<const char*> starts(threads + 1, end);
+  starts[0] = p;
+  for (unsigned int t = 1; t < threads; ++t)
+  {
+    const char* s = (std::max)(starts[t - 1], p + static_cast<std::size_t>(end - p) / threads * t);
+    const char* nl = (s == end) ? 0 : static_cast<const char*>(std::memchr(s, '\n', static_cast<std::size_t>(end - s)));
+    starts[t] = (nl == 0) ? end : nl + 1;
+  }
+
+  // Count the rows of each chunk, then parse each chunk into its rows of the columns.
+  std::vector<std::size_t> first_row(threads + 1, 0);
+  std::vector<std::thread> pool;
+  for (unsigned int t = 1; t < threads; ++t)
+  {
+    pool.push_back(std::thread([&, t]() { first_row[t + 1] = detail::csv_count_rows(starts[t], starts[t + 1]); }));
+  }
+  first_row[1] = detail::csv_count_rows(starts[0], starts[1]);
+  for (std::size_t t = 0; t < pool.size(); ++t)
+  {
+    pool[t].join();
+  }
+  for (unsigned int t = 1; t <= threads; ++t)
+  {
+    first_row[t] += first_row[t - 1];
+  }
+  csv.columns_.assign(n, std::vector<double>(first_row[threads]));
+  pool.clear();
+  for (unsigned int t = 1; t < threads; ++t)
+  {
+    pool.push_back(std::thread([&, t]() { detail::csv_parse_rows(starts[t], starts[t + 1], delimiter, csv.columns_, first_row[t]); }));
+  }
+  detail::csv_parse_rows(starts[0], starts[1], delimiter, csv.columns_, 0);
+  for (std::size_t t = 0; t < pool.size(); ++t)
+  {
+    pool[t].join();
+  }
+  return csv;
+} // csv_columns read_csv
+
+} // namespace svg
+} // namespace boost
+
+#endif // BOOST_SVG_CSV_READER_HPP
@@ -137,6 +137,64 @@ namespace boost
         return ((a < b) ? a : (a < c) ? a : c);
       }
 
+      //! \enum window_bits Where a data-point lies, as marked by @c axis_plot_frame::transform_values.
+      enum window_bits
+      {
+        inside_window = 1, //!< Inside the plot window (not on its edge), so a marker is drawn.
+        near_window = 2, //!< Inside the plot window, or not too far outside (within its margin), so a line is drawn to it.
+        was_limit = 4, //!< SVG coordinate X and/or Y reached max, min, infinity or NaN, so needs @c axis_plot_frame::adjust_limits.
+        left_of_window = 8, //!< Left of the plot window (and its margin).
+        right_of_window = 16, //!< Right of the plot window (and its margin).
+        above_window = 32, //!< Above the plot window (and its margin).
+        below_window = 64, //!< Below the plot window (and its margin).
+        beyond_window = left_of_window | right_of_window | above_window | below_window //!< Which sides outside (so a line between two data-points both on the same side is not seen).
+      };
+
+      inline bool clip_segment(double x0, double y0, double x1, double y1,
+        double left, double top, double right, double bottom, double& t0, double& t1)
+      { /*! Clip the line from (x0, y0) to (x1, y1) to a window (by the Liang-Barsky algorithm).
+            \return @c false if no part is inside the window, else @c true, and in t0 and t1 (from 0 to 1 along the line)
+            the start and end of the part that is inside.
+        */
+        t0 = 0.;
+        t1 = 1.;
+        const double p[4] = {x0 - x1, x1 - x0, y0 - y1, y1 - y0}; // Towards left, right, top and bottom.
+        const double q[4] = {x0 - left, right - x0, y0 - top, bottom - y0}; // Distance inside each side.
+        for (int k = 0; k != 4; ++k)
+        {
+          if (p[k] == 0.)
+          { // Parallel to this side.
+            if (q[k] < 0.)
+            {
+              return false;
+            }
+          }
+          else
+          {
+            const double r = q[k] / p[k]; // Where the line crosses this side.
+            if (p[k] < 0.)
+            { // Entering.
+              if (r > t1)
+              {
+                return false;
+              }
+              t0 = (r > t0) ? r : t0;
+            }
+            else
+            { // Leaving.
+              if (r < t0)
+              {
+                return false;
+              }
+              t1 = (r < t1) ? r : t1;
+            }
+          }
+        }
+        return true;
+      } // bool clip_segment
+
+      constexpr std::size_t transform_block_size = 1024; //!< Data-points transformed at a time by @c transform_values (so all stay in cache).
+
       template <class Derived>
       class axis_plot_frame
       {
@@ -151,6 +209,8 @@ namespace boost
          void transform_point(double &x, double &y); // Scale & shift both X & Y to graph Cartesian coordinates.
          void transform_x(double &x); // Scale & shift both X to graph Cartesian coordinates.
          void transform_y(double &y); // Scale & shift both Y to graph Cartesian coordinates.
+         bool transform_values(double* x, double* y, std::size_t n, double window_margin, unsigned char* where); // Scale & shift arrays of X & Y, and mark where they lie.
+         unsigned char where_in_window(double x, double y, double window_margin); // window_bits of a data-point in SVG coordinates.
          void draw_x_minor_tick(double j, path_element& tick_path, path_element& grid_path); // (& grid).
          void draw_x_major_tick(double i, path_element& tick_path, path_element& grid_path); // (& grid).
          void draw_x_axis();
@@ -163,6 +223,8 @@ namespace boost
         // void draw_plot_point(double x, double y, g_element& g_ptr, const plot_point_style& sty); // No X and Y uncertainty info.
          // Might be better to split the code to provide this simple case of just markers?
          void draw_plot_point(double x, double y, g_element& g_ptr, plot_point_style& sty, unc<false> ux, unc<false> uy);
+         void draw_marker(double x, double y, g_element& g_ptr, plot_point_style& sty, unc<false> ux, unc<false> uy); // Marker in full.
+         void draw_glyph(double x, double y, g_element& g_ptr, const std::string& glyph, const text_style& sty, align_style align); // Glyph marker.
          void draw_plot_point_value(double x, double y, g_element& g_ptr, value_style& val_style, plot_point_style& point_style, Meas uvalue);
          // Might provide explicit code to match this specification?
          void draw_plot_point_values(double x, double y, g_element& x_g_ptr, g_element& y_g_ptr, const value_style& x_sty, const value_style& y_sty, Meas uncx, Meas uncy);
@@ -183,7 +245,7 @@ namespace boost
          void clear_x_axis(); //!< Clear the X axis layer of the SVG plot.
          void clear_y_axis(); //! Clear the Y-axis layer of the SVG plot.
          void clear_title(); //!< Clear the plot title layer of the SVG plot.
-         void clear_points(); //!< Clear the data-points layer of the SVG plot.
+         void clear_points(); //!< Clear the data-series layers of the SVG plot.
          void clear_plot_background(); //!< Clear the plot area background layer of the SVG plot.
          void clear_grids(); //!< Clear the  grids layer of the SVG plot.
 
@@ -265,6 +327,18 @@ namespace boost
               particularly if there are very many data-points.
            */
           int coord_precision(); //!<  \return  precision of SVG coordinates in decimal digits.
+          Derived& compact_paths(bool b); //!< Set @c true to write path data (for example, data lines) as briefly as possible, see @c svg::compact_paths.
+          bool compact_paths(); //!< \return @c true if path data are to be written as briefly as possible.
+          Derived& compress_on(bool b); //!< Set @c true to write files compressed as .svgz, see @c svg::compress_on.
+          bool compress_on(); //!< \return @c true if files are to be written compressed as .svgz.
+          Derived& compact_output(bool b); //!< Set @c true to write SVG XML as small as possible (minified), see @c svg::compact_output.
+          bool compact_output(); //!< \return @c true if SVG XML is to be written minified.
+          Derived& css_classes(bool b); //!< Set @c true to write repeated group styles once, as CSS classes, see @c svg::css_classes.
+          bool css_classes(); //!< \return @c true if repeated group styles are to be written as CSS classes.
+          Derived& markers(marker_policy policy); //!< Set to write data-point markers in full, as a @c <use> of a symbol, whichever is smaller, or batched, see @c svg::markers.
+          marker_policy markers(); //!< \return How data-point markers are written.
+          Derived& write_threads(unsigned int threads); //!< Set number of threads used to write the plot (default 1, 0 for all hardware threads), see @c svg::write_threads.
+          unsigned int write_threads(); //!< \return Number of threads used to write the plot.
           /*! Set precision of X-tick label values in decimal digits (default 3).
               3 decimal digits precision is sufficient for small images.
               4 or 5 decimal digits precision will give more cluttered plots.
@@ -611,6 +685,8 @@ namespace boost
 
           //!<autoscale set & get parameters,
           //!<Note: all these *MUST* preceed x_autoscale(data) call.
+          Derived& arena_on(bool); //!< Set to allocate plot elements from an arena owned by the SVG image, freed in one shot by @c clear_all().
+          bool arena_on(); //!< \return true if plot elements are allocated from an arena owned by the SVG image.
           Derived& autoscale_plusminus(double); //!< Set how many std_dev or standard-deviations to allow for ellipses when autoscaling.
           double autoscale_plusminus(); //!< \return How many std_dev or standard-deviations allowed for ellipses when autoscaling.
 
@@ -745,6 +821,10 @@ namespace boost
         clear_points();
         clear_plot_background();
         clear_grids();
+        if (derived().image_.arena_on())
+        { // Free all elements drawn by the previous update_image() in one shot.
+          derived().image_.arena_release();
+        }
       }
 
       std::string strip_if(double v, const value_style& sty, bool);
@@ -763,8 +843,17 @@ namespace boost
 
       template <class Derived>
       void axis_plot_frame<Derived>::clear_points()
-      {  //!< Clear the data-points layer of the SVG plot.
+      {  //!< Clear the data-series layers of the SVG plot (lines, uncertainty ellipses, markers and value-labels),
+         //!< and the symbols of its markers, so that writing a plot again does not repeat them.
+        derived().image_.gs(PLOT_DATA_LINES).clear();
+        derived().image_.gs(PLOT_DATA_UNC3).clear();
+        derived().image_.gs(PLOT_DATA_UNC2).clear();
+        derived().image_.gs(PLOT_DATA_UNC1).clear();
         derived().image_.gs(PLOT_DATA_POINTS).clear();
+        derived().image_.gs(PLOT_LIMIT_POINTS).clear();
+        derived().image_.gs(PLOT_X_POINT_VALUES).clear();
+        derived().image_.gs(PLOT_Y_POINT_VALUES).clear();
+        derived().image_.clear_markers();
       }
 
       template <class Derived>
@@ -778,6 +867,7 @@ namespace boost
       { //!< Clear the legend layer of the SVG plot.
         derived().image_.gs(PLOT_LEGEND_BACKGROUND).clear();
         derived().image_.gs(PLOT_LEGEND_POINTS).clear();
+        derived().image_.gs(PLOT_LEGEND_LINES).clear();
         derived().image_.gs(PLOT_LEGEND_TEXT).clear();
       }
 
@@ -798,6 +888,7 @@ namespace boost
         derived().image_.gs(PLOT_Y_MINOR_TICKS).clear();
         derived().image_.gs(PLOT_Y_MAJOR_TICKS).clear();
         derived().image_.gs(PLOT_Y_LABEL).clear();
+        derived().image_.gs(PLOT_Y_TICKS_VALUES).clear();
       }
 
       template <class Derived>
@@ -836,6 +927,86 @@ namespace boost
         y = derived().y_scale_ * y + derived().y_shift_;
       }
 
+      template <class Derived>
+      unsigned char axis_plot_frame<Derived>::where_in_window(double x, double y, double window_margin)
+      { //!< \return @c window_bits (except @c was_limit) of a data-point at SVG coordinates x and y.
+        const Derived& d = derived();
+        unsigned char where = 0;
+        if ((x > d.plot_left_) && (x < d.plot_right_) && (y > d.plot_top_) && (y < d.plot_bottom_))
+        {
+          where |= inside_window;
+        }
+        where |= (x < d.plot_left_ - window_margin) ? left_of_window : 0;
+        where |= (x > d.plot_right_ + window_margin) ? right_of_window : 0;
+        where |= (y < d.plot_top_ - window_margin) ? above_window : 0;
+        where |= (y > d.plot_bottom_ + window_margin) ? below_window : 0;
+        if ((where & beyond_window) == 0)
+        {
+          where |= near_window;
+        }
+        return where;
+      }
+
+      template <class Derived>
+      bool axis_plot_frame<Derived>::transform_values(double* x, double* y, std::size_t n, double window_margin, unsigned char* where)
+      { /*!< Scale and shift n X and Y values (in place) to SVG coordinates, exactly as @c transform_x and @c transform_y,
+            2 data-points at a time by SSE2 (where available), and mark @c where each lies (as @c where_in_window)
+            in the same pass, so that a whole data-series can be transformed a block at a time.
+            \return @c true if any X or Y reached a limit (so marked @c was_limit), and must be adjusted (as @c transform_point does).
+        */
+        const Derived& d = derived();
+        unsigned char any = 0;
+        std::size_t i = 0;
+#ifdef BOOST_SVG_HAS_SSE2
+        const __m128d x_scale = _mm_set1_pd(d.x_scale_);
+        const __m128d x_shift = _mm_set1_pd(d.x_shift_);
+        const __m128d y_scale = _mm_set1_pd(d.y_scale_);
+        const __m128d y_shift = _mm_set1_pd(d.y_shift_);
+        const __m128d sign_off = _mm_castsi128_pd(_mm_srli_epi64(_mm_set1_epi32(-1), 1)); // All bits but the sign.
+        const __m128d limit = _mm_set1_pd((std::numeric_limits<double>::max)() / detail::margin);
+        const __m128d left = _mm_set1_pd(d.plot_left_);
+        const __m128d right = _mm_set1_pd(d.plot_right_);
+        const __m128d top = _mm_set1_pd(d.plot_top_);
+        const __m128d bottom = _mm_set1_pd(d.plot_bottom_);
+        const __m128d far_left = _mm_set1_pd(d.plot_left_ - window_margin);
+        const __m128d far_right = _mm_set1_pd(d.plot_right_ + window_margin);
+        const __m128d far_top = _mm_set1_pd(d.plot_top_ - window_margin);
+        const __m128d far_bottom = _mm_set1_pd(d.plot_bottom_ + window_margin);
+        for (; i + 2 <= n; i += 2)
+        {
+          __m128d vx = _mm_add_pd(_mm_mul_pd(x_scale, _mm_loadu_pd(x + i)), x_shift);
+          __m128d vy = _mm_add_pd(_mm_mul_pd(y_scale, _mm_loadu_pd(y + i)), y_shift);
+          _mm_storeu_pd(x + i, vx);
+          _mm_storeu_pd(y + i, vy);
+          // Not (magnitude <= limit) so including NaN.
+          int limits = _mm_movemask_pd(_mm_or_pd(_mm_cmpnle_pd(_mm_and_pd(vx, sign_off), limit), _mm_cmpnle_pd(_mm_and_pd(vy, sign_off), limit)));
+          int inside = _mm_movemask_pd(_mm_and_pd(_mm_and_pd(_mm_cmpgt_pd(vx, left), _mm_cmplt_pd(vx, right)),
+            _mm_and_pd(_mm_cmpgt_pd(vy, top), _mm_cmplt_pd(vy, bottom))));
+          const int l = _mm_movemask_pd(_mm_cmplt_pd(vx, far_left)); // Sides of window beyond which each data-point lies.
+          const int r = _mm_movemask_pd(_mm_cmpgt_pd(vx, far_right));
+          const int t = _mm_movemask_pd(_mm_cmplt_pd(vy, far_top));
+          const int b = _mm_movemask_pd(_mm_cmpgt_pd(vy, far_bottom));
+          const int first = (l & 1) | ((r & 1) << 1) | ((t & 1) << 2) | ((b & 1) << 3); // of 1st data-point,
+          const int second = (l >> 1) | (r & 2) | ((t & 2) << 1) | ((b & 2) << 2); // and of 2nd.
+          where[i] = static_cast<unsigned char>((inside & 1) | ((first == 0) << 1) | ((limits & 1) << 2) | (first << 3));
+          where[i + 1] = static_cast<unsigned char>(((inside >> 1) & 1) | ((second == 0) << 1) | ((limits & 2) << 1) | (second << 3));
+          any |= static_cast<unsigned char>(limits);
+        }
+#endif // BOOST_SVG_HAS_SSE2
+        for (; i != n; ++i)
+        { // Remaining data-points, one at a time.
+          x[i] = d.x_scale_ * x[i] + d.x_shift_;
+          y[i] = d.y_scale_ * y[i] + d.y_shift_;
+          where[i] = where_in_window(x[i], y[i], window_margin);
+          if (detail::is_limit(x[i]) || detail::is_limit(y[i]))
+          {
+            where[i] |= was_limit;
+            any = 1;
+          }
+        }
+        return any != 0;
+      } // bool transform_values
+
       template <class Derived>
       void axis_plot_frame<Derived>::draw_x_minor_tick(double value, path_element& tick_path, path_element& grid_path)
       { //!< Draw X-axis minor ticks, and optional grid. (Value is NOT (yet) shown beside the minor tick).
@@ -1826,6 +1997,7 @@ namespace boost
        // Use height of whichever is the biggest of data-point marker shape and text-font, derived().biggest_point_marker_font_size_
       // for vertical spacing, (assuming horizontal line markers have neglible height so fill use marker text font-size).
 
+      derived().legend_height_ = 0.; // Not added to the height found by any drawing before.
       //derived().legend_height_ = derived().legend_box_.margin_; // Always allow a tiny margin top and bottom.
       if (derived().legend_box_.border_on_ == true)
       {  // If a legend box border, allow for its width top side.
@@ -2243,6 +2415,39 @@ namespace boost
       legend_y_pos += derived().vertical_marker_spacing_; // Fraction of biggest font, ready for next line.
     } // void draw_legend()
 
+    inline void marker_key(const plot_point_style& point_style, std::string& key)
+    { /*! Describe the data-point marker of point_style in key, the same for all markers that are drawn the same.
+        Colors are inherited from the group, so the marker depends only on its shape, size, fill (or not) and font.
+        (Built for every data-point, so appended piece by piece, rather than using a slower @c std::ostringstream).
+      */
+      const text_style& font = point_style.symbols_style_;
+      key.assign(1, static_cast<char>('A' + point_style.shape_));
+      key += (point_style.fill_color_ != blank) ? '+' : '-';
+      key += std::to_string(point_style.size_);
+      key += ' ';
+      key += std::to_string(font.font_size_);
+      key += ' ';
+      key += font.font_family_;
+      key += ' ';
+      key += font.weight_;
+      key += ' ';
+      key += font.font_style_;
+      key += ' ';
+      key += font.stretch_;
+      key += ' ';
+      key += font.decoration_;
+      if (font.text_length_ > 0)
+      {
+        key += ' ';
+        key += std::to_string(font.text_length_);
+      }
+      if (point_style.shape_ == symbol)
+      { // Only the symbol shape has the user's symbols.
+        key += ' ';
+        key += point_style.symbols_;
+      }
+    } // void marker_key
+
     template <class Derived>
     void axis_plot_frame<Derived>::draw_plot_point(double x, double y, // X and Y values (in SVG coordinates).
       g_element& g_ptr,
@@ -2251,6 +2456,59 @@ namespace boost
     { /*! Draw a plot data-point marker shape or symbol
         whose size and stroke and fill colors are specified in plot_point_style style,
         possibly including uncertainty ellipses showing multiples of standard-deviation.
+        The marker is written in full, or as a @c <use> of a symbol defining it, see @c svg::markers.
+      */
+      svg& image = derived().image_;
+      if (image.markers() == inline_markers || image.markers() == batched_markers
+        || point_style.shape_ == none || point_style.shape_ == unc_ellipse)
+      { // Uncertainty ellipses differ for each data-point, so are always in full.
+        draw_marker(x, y, g_ptr, point_style, ux, uy);
+        return;
+      }
+      point_style.symbols_style_.font_size(point_style.size_); // As draw_marker.
+      std::string key;
+      marker_key(point_style, key);
+      const std::string* id = image.marker_id(key);
+      if (id == 0)
+      { // A new marker: define its symbol, with the marker at the origin.
+        symbol_element& marker_symbol = image.add_marker_symbol(key);
+        draw_marker(0., 0., marker_symbol, point_style, ux, uy);
+        if (image.markers() == smallest_markers)
+        { // Compare the marker in full with a use of the symbol, both at this data-point.
+          g_element full;
+          draw_marker(x, y, full, point_style, ux, uy);
+          use_element use(x, y, marker_symbol.id());
+          std::ostringstream full_xml;
+          std::ostringstream use_xml;
+          full_xml.precision(image.coord_precision());
+          use_xml.precision(image.coord_precision());
+          full.write_children(full_xml, 0, full.size());
+          use.write(use_xml);
+          if (full_xml.str().size() <= use_xml.str().size())
+          { // The symbol is not needed after all.
+            image.inline_marker(key);
+          }
+        }
+        id = image.marker_id(key);
+      }
+      if (id->empty())
+      { // Marker is smaller in full.
+        draw_marker(x, y, g_ptr, point_style, ux, uy);
+      }
+      else
+      {
+        g_ptr.use(x, y, *id);
+      }
+    } // void draw_plot_point
+
+    template <class Derived>
+    void axis_plot_frame<Derived>::draw_marker(double x, double y, // X and Y values (in SVG coordinates).
+      g_element& g_ptr,
+      plot_point_style& point_style,
+      unc<false> ux, unc<false> uy)
+    { /*! Draw a plot data-point marker shape or symbol in full,
+        whose size and stroke and fill colors are specified in plot_point_style style,
+        possibly including uncertainty ellipses showing multiples of standard-deviation.
       */
       /*!
         For 1-D plots, the points do not *need* to be centered on the X-axis,
@@ -2426,7 +2684,7 @@ namespace boost
         // std::cout << "square point_style.symbols_style_ = " << point_style.symbols_style_ << std::endl;
         // square point_style.symbols_style_ = text_style(14, "Lucida Sans Unicode", "", "", "", "")
 
-        g_ptr.text(x, y + third_height, "&#x25A0;", point_style.symbols_style_, align_style::center_align, horizontal);
+        draw_glyph(x, y + third_height, g_ptr, "&#x25A0;", point_style.symbols_style_, align_style::center_align);
         // https://unicode.org/charts/PDF/U25A0.pdf Geometric Shapes
         // 25A1 white-center square - but fill always white.
         // Other possible symbols 20DE  enclosing square (white center) but larger than 25A0.
@@ -2448,12 +2706,12 @@ namespace boost
         // but if the font info is already in a g_element, the avoid repeating for each point by using no_text_style.
         //g_ptr.text(x, y + third_height, point_style.symbols_, no_text_style, align_style::center_align, horizontal);  OK but redundant anchor
 
-        g_ptr.text(x, y + third_height, point_style.symbols_, no_text_style, align_style::no_align, horizontal);
+        draw_glyph(x, y + third_height, g_ptr, point_style.symbols_, no_text_style, align_style::no_align);
 
         // symbol(s), size and center.
         break;
       case diamond:
-        g_ptr.text(x, y + third_height, "&#x2666;", point_style.symbols_style_, align_style::center_align, horizontal);
+        draw_glyph(x, y + third_height, g_ptr, "&#x2666;", point_style.symbols_style_, align_style::center_align);
 
 #ifdef BOOST_SVG_POINT_DIAGNOSTICS
       std::cout << "sty.symbols_style_ " << point_style.symbols_style_ << std::endl;
@@ -2468,24 +2726,24 @@ namespace boost
         // U+FE61 SMALL ASTERISK centers OK but is small.
         // 2732 is open center asterisk.
         // 273C is open center TEARDROP-SPOKED ASTERISK
-        g_ptr.text(x, y + third_height, "&#x273C;", point_style.symbols_style_, align_style::center_align, horizontal);
+        draw_glyph(x, y + third_height, g_ptr, "&#x273C;", point_style.symbols_style_, align_style::center_align);
         // asterisk is black filled.
         break;
       case lozenge:
-        g_ptr.text(x, y + third_height, "&#x25CA;", point_style.symbols_style_, align_style::center_align, horizontal);
+        draw_glyph(x, y + third_height, g_ptr, "&#x25CA;", point_style.symbols_style_, align_style::center_align);
         // size / 3 to get tip of lozenge just on the X-axis.
         // lozenge seems not to fill?
         break;
       case club:
-        g_ptr.text(x, y + third_height, "&#x2663;", point_style.symbols_style_, align_style::center_align, horizontal);
+        draw_glyph(x, y + third_height, g_ptr, "&#x2663;", point_style.symbols_style_, align_style::center_align);
         // x, y, puts club just on the X-axis.
         break;
       case spade:
-        g_ptr.text(x, y + third_height, "&#x2660;", point_style.symbols_style_, align_style::center_align, horizontal);
+        draw_glyph(x, y + third_height, g_ptr, "&#x2660;", point_style.symbols_style_, align_style::center_align);
         //
         break;
       case heart:
-        g_ptr.text(x, y + third_height , "&#x2665;", point_style.symbols_style_, align_style::center_align, horizontal);
+        draw_glyph(x, y + third_height, g_ptr, "&#x2665;", point_style.symbols_style_, align_style::center_align);
         break;
       case outside_window: // Pointing down triangle used only to show data-points that are outside plot window.
         {
@@ -2503,32 +2761,32 @@ namespace boost
         // or &#x25BA for white center point right triangle.
       case cone: // Synonym for cone_point_up
       case cone_point_up: // pointing-up triangle, white centre.
-        g_ptr.text(x, y + third_height, "&#x25BD;", point_style.symbols_style_, align_style::center_align, horizontal);
+        draw_glyph(x, y + third_height, g_ptr, "&#x25BD;", point_style.symbols_style_, align_style::center_align);
         // https://unicode.org/charts/PDF/U25A0.pdf
         break;
 
       case cone_point_down: // pointing-down triangle, white centre.
-          g_ptr.text(x, y + third_height, "&#x25BF;", point_style.symbols_style_, align_style::center_align, horizontal);
+          draw_glyph(x, y + third_height, g_ptr, "&#x25BF;", point_style.symbols_style_, align_style::center_align);
           // https://unicode.org/charts/PDF/U25A0.pdf
           break;
 
       case cone_point_right: // small pointing-right triangle, white centre (or 25b7 for bigger one).
-          g_ptr.text(x, y + third_height, "&#x25B9;", point_style.symbols_style_, align_style::center_align, horizontal);
+          draw_glyph(x, y + third_height, g_ptr, "&#x25B9;", point_style.symbols_style_, align_style::center_align);
           // <text x="489" y="109" text-anchor="middle" font-size="10" font-family="Lucida Sans Unicode">&#x25B9</text>
           break;
 
       case cone_point_left: // small pointing-left triangle, white centre.
-          g_ptr.text(x, y + third_height, "&#x25C3;", point_style.symbols_style_, align_style::center_align, horizontal);
+          draw_glyph(x, y + third_height, g_ptr, "&#x25C3;", point_style.symbols_style_, align_style::center_align);
           // https://unicode.org/charts/PDF/U25A0.pdf  Or larger triangle 25C1
           break;
 
       case triangle: // Pointing-up triangle, white centre.
-          g_ptr.text(x, y  + third_height, "&#x25B4;", point_style.symbols_style_, align_style::center_align, horizontal);
+          draw_glyph(x, y + third_height, g_ptr, "&#x25B4;", point_style.symbols_style_, align_style::center_align);
             // Also could use &#x25BC for pointing down triangle, or &#x25B4 for small up-pointing triangle.
             // https://unicode.org/charts/PDF/U25A0.pdf
           break;
         case star:
-          g_ptr.text(x, y  + third_height, "&#x2605;", point_style.symbols_style_, align_style::center_align, horizontal);
+          draw_glyph(x, y + third_height, g_ptr, "&#x2605;", point_style.symbols_style_, align_style::center_align);
           break;
 
       case cross: // Not X. Size is full font-size for other options see https://unicode-search.net/unicode-namesearch.pl?term=CROSS
@@ -2537,10 +2795,30 @@ namespace boost
         // Cross is pretty useless for 1-D because the horizontal line is on the X-axis.
         // g_ptr.text(x, y  + third_height, "&#x274C;", point_style.symbols_style_, center_align, horizontal);
         // Offset of third_height to try to center symbol on both the X and Y axes.
-        g_ptr.text(x, y  + third_height, "&#x272F;", point_style.symbols_style_, align_style::center_align, horizontal);
+        draw_glyph(x, y + third_height, g_ptr, "&#x272F;", point_style.symbols_style_, align_style::center_align);
         break;
       }
-    } // void draw_plot_point
+    } // void draw_marker
+
+    template <class Derived>
+    void axis_plot_frame<Derived>::draw_glyph(double x, double y, // SVG coordinates of glyph.
+      g_element& g_ptr, const std::string& glyph, const text_style& sty, align_style align)
+    { /*! Draw a data-point marker that is a Unicode glyph (symbol), as a @c <text> element of its own,
+        or, with @c batched_markers, by adding the position to the last element of g_ptr,
+        if a @c glyphs_element of the same glyph and font with room for more, else to a new @c glyphs_element.
+      */
+      if (derived().image_.markers() != batched_markers)
+      {
+        g_ptr.text(x, y, glyph, sty, align, horizontal);
+        return;
+      }
+      glyphs_element* run = (g_ptr.size() == 0) ? 0 : dynamic_cast<glyphs_element*>(&g_ptr[static_cast<unsigned int>(g_ptr.size() - 1)]);
+      if (run == 0 || !run->same(glyph, sty, align) || run->size() >= glyphs_element::max_size)
+      {
+        run = &g_ptr.glyphs(glyph, sty, align);
+      }
+      run->P(x, y);
+    } // void draw_glyph
 
       template <class Derived>
       void axis_plot_frame<Derived>::draw_plot_point_value(double x, double y, g_element& g_ptr, value_style& val_style, plot_point_style& point_style, Meas uvalue)
@@ -3485,6 +3763,102 @@ namespace boost
             return derived().image_.coord_precision();
           }
 
+          template <class Derived>
+          Derived& axis_plot_frame<Derived>::compact_paths(bool b)
+          { /*! Set @c true to write path data (for example, data lines) as briefly as possible,
+              using relative and horizontal or vertical line-to commands, and omitting repeated command letters,
+              for exactly the same path. Dense plots of very many data-points will have much smaller .svg files.
+           */
+            derived().image_.compact_paths(b);
+            return derived();
+          }
+
+          template <class Derived>
+          bool axis_plot_frame<Derived>::compact_paths()
+          { //! \return @c true if path data are to be written as briefly as possible.
+            return derived().image_.compact_paths();
+          }
+
+          template <class Derived>
+          Derived& axis_plot_frame<Derived>::compress_on(bool b)
+          { /*! Set @c true to write files compressed in gzip format (default suffix .svgz),
+              deflating the SVG XML as it is written. (Files named .svgz are always compressed, if @c BOOST_SVG_SVGZ is defined).
+              Needs zlib: define @c BOOST_SVG_SVGZ and link with zlib.
+           */
+            derived().image_.compress_on(b);
+            return derived();
+          }
+
+          template <class Derived>
+          bool axis_plot_frame<Derived>::compress_on()
+          { //! \return @c true if files are to be written compressed as .svgz.
+            return derived().image_.compress_on();
+          }
+
+          template <class Derived>
+          Derived& axis_plot_frame<Derived>::compact_output(bool b)
+          { /*! Set @c true to write the compact output profile: SVG XML without comments or layout whitespace,
+              with colors as @c \#rrggbb and without attributes that have the same value anyway,
+              and compact path data, for exactly the same image.
+           */
+            derived().image_.compact_output(b);
+            return derived();
+          }
+
+          template <class Derived>
+          bool axis_plot_frame<Derived>::compact_output()
+          { //! \return @c true if SVG XML is to be written minified.
+            return derived().image_.compact_output();
+          }
+
+          template <class Derived>
+          Derived& axis_plot_frame<Derived>::css_classes(bool b)
+          { /*! Set @c true to write each set of style attributes repeated by the plot's groups (layers and data-series)
+              once, as a class in a CSS stylesheet, with each group referring to it by @c class="s0".
+           */
+            derived().image_.css_classes(b);
+            return derived();
+          }
+
+          template <class Derived>
+          bool axis_plot_frame<Derived>::css_classes()
+          { //! \return @c true if repeated group styles are to be written as CSS classes.
+            return derived().image_.css_classes();
+          }
+
+          template <class Derived>
+          Derived& axis_plot_frame<Derived>::markers(marker_policy policy)
+          { /*! Set to write data-point markers in full (@c inline_markers, default),
+              define each marker once as a symbol, and each data-point as a @c <use> of it (@c use_markers),
+              whichever is smaller (@c smallest_markers), or the glyph markers of each data-series
+              as a few @c <text> elements with lists of X and Y coordinates (@c batched_markers).
+           */
+            derived().image_.markers(policy);
+            return derived();
+          }
+
+          template <class Derived>
+          marker_policy axis_plot_frame<Derived>::markers()
+          { //! \return How data-point markers are written: in full, as a @c <use> of a symbol, whichever is smaller, or batched.
+            return derived().image_.markers();
+          }
+
+          template <class Derived>
+          Derived& axis_plot_frame<Derived>::write_threads(unsigned int threads)
+          { /*! Set number of threads used to write the plot (default 1, 0 for one per hardware thread).
+              Layers of the plot, and large groups of data-points within them, are serialized in parallel,
+              for the same SVG XML, worthwhile for plots of very many data-points.
+           */
+            derived().image_.write_threads(threads);
+            return derived();
+          }
+
+          template <class Derived>
+          unsigned int axis_plot_frame<Derived>::write_threads()
+          { //! \return Number of threads used to write the plot.
+            return derived().image_.write_threads();
+          }
+
           template <class Derived>
           Derived& axis_plot_frame<Derived>::x_value_precision(int digits)
           { /*! Precision of X tick label values in decimal digits (default 3).
@@ -5415,6 +5789,26 @@ namespace boost
             return derived();
           }
 
+          template <class Derived>
+          Derived& axis_plot_frame<Derived>::arena_on(bool b)
+          { /*! Set to allocate the (many) elements drawn by update_image() from an arena owned by the SVG image,
+              rather than each by @c new, and free them all in one shot by @c clear_all() before the next redraw.
+              Default is false.
+              Useful for plots with very many data-points.
+            */
+            derived().image_.arena_on(b);
+            // Notes and functions are added by users, not redrawn, so must survive clear_all().
+            derived().image_.gs(PLOT_FUNCTIONS).arena(0);
+            derived().image_.gs(PLOT_NOTES).arena(0);
+            return derived();
+          }
+
+          template <class Derived>
+          bool axis_plot_frame<Derived>::arena_on()
+          { //! \return true if plot elements are allocated from an arena owned by the SVG image.
+            return derived().image_.arena_on();
+          }
+
           template <class Derived>
           Derived& axis_plot_frame<Derived>::autoscale_plusminus(double pm)
           { //! Set how many std_dev or standard-deviation to allow for ellipse when autoscaling.
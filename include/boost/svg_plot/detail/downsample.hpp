@@ -0,0 +1,273 @@
+/*! \file
+    \brief Downsampling of (very) long data-series, so that only the data-points that can be seen are drawn,
+      see @c svg_2d_plot_series::downsample.
+    \details @c m4_columns keeps, of the data-points (in SVG coordinates) in each pixel column of the plot window,
+      only the first, last, minimum and maximum (the M4 algorithm), so that a line joining them
+      is drawn with exactly the same pixels as a line joining all the data-points.\n
+      @c lttb_select chooses a fixed number of data-points that keep the shape of the data-series
+      (the Largest-Triangle-Three-Buckets algorithm), to draw as a line and/or as markers.
+*/
+
+// downsample.hpp
+
+// Copyright Paul A. Bristow 2020
+
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_SVG_DOWNSAMPLE_HPP
+#define BOOST_SVG_DOWNSAMPLE_HPP
+
+#include <algorithm>
+// using std::min;
+#include <cmath>
+// using std::floor; std::abs;
+#include <cstddef>
+// using std::size_t;
+#include <functional>
+// using std::function;
+#include <thread>
+// using std::thread;
+#include <vector>
+// using std::vector;
+
+namespace boost
+{
+namespace svg
+{
+namespace detail
+{
+
+class m4_columns
+{ /*! \class boost::svg::detail::m4_columns
+      \brief Keeps only the first, last, minimum and maximum of data-points in each pixel column (the M4 algorithm),
+      of data-points in SVG coordinates, added (in order of X) a block at a time, in one pass.
+  */
+public:
+  m4_columns() : count_(0), column_(0.)
+  {
+  }
+
+  /*! Add n data-points (in order of X), and put the data-points kept of each pixel column now complete
+      in kept_x, kept_y and kept_where (which must have room for n + 4).
+      \return Number of data-points kept.
+  */
+  std::size_t add(const double* x, const double* y, const unsigned char* where, std::size_t n,
+    double* kept_x, double* kept_y, unsigned char* kept_where)
+  {
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i != n; ++i)
+    {
+      const double column = std::floor(x[i]); // Pixel column.
+      if ((count_ == 0) || (column != column_))
+      { // First data-point of a new column.
+        kept += finish(kept_x + kept, kept_y + kept, kept_where + kept);
+        column_ = column;
+        first_ = min_ = max_ = last_ = point(x[i], y[i], where[i], 0);
+        count_ = 1;
+        continue;
+      }
+      last_ = point(x[i], y[i], where[i], count_);
+      if (y[i] < min_.y)
+      {
+        min_ = last_;
+      }
+      else if (y[i] > max_.y)
+      {
+        max_ = last_;
+      }
+      ++count_;
+    }
+    return kept;
+  } // std::size_t add
+
+  /*! Put the data-points kept of the last pixel column (if any) in kept_x, kept_y and kept_where (which must have room for 4).
+      \return Number of data-points kept.
+  */
+  std::size_t finish(double* kept_x, double* kept_y, unsigned char* kept_where)
+  {
+    std::size_t kept = 0;
+    if (count_ != 0)
+    { // First, then minimum and maximum in the order they were added, then last (each only once).
+      const point* keep[4] = {&first_, &min_, &max_, &last_};
+      if (max_.index < min_.index)
+      {
+        keep[1] = &max_;
+        keep[2] = &min_;
+      }
+      for (int k = 0; k != 4; ++k)
+      {
+        if ((k == 0) || (keep[k]->index != keep[k - 1]->index))
+        {
+          kept_x[kept] = keep[k]->x;
+          kept_y[kept] = keep[k]->y;
+          kept_where[kept] = keep[k]->where;
+          ++kept;
+        }
+      }
+      count_ = 0;
+    }
+    return kept;
+  } // std::size_t finish
+
+private:
+  struct point
+  { //! A data-point, and its index in its pixel column.
+    point() : x(0.), y(0.), where(0), index(0)
+    {
+    }
+    point(double x_, double y_, unsigned char where_, std::size_t index_) : x(x_), y(y_), where(where_), index(index_)
+    {
+    }
+    double x;
+    double y;
+    unsigned char where; //!< @c window_bits.
+    std::size_t index;
+  };
+
+  std::size_t count_; //!< data-points added to the current pixel column.
+  double column_; //!< Current pixel column.
+  point first_; //!< First data-point of the current column.
+  point min_; //!< data-point of minimum Y.
+  point max_; //!< data-point of maximum Y.
+  point last_; //!< Last data-point.
+}; // class m4_columns
+
+constexpr std::size_t lttb_block_size = 1024; //!< data-points read at a time by @c lttb_select.
+constexpr std::size_t lttb_chunk_size = 1 << 20; //!< data-points of a chunk of buckets chosen from by one thread.
+
+/*!
+  Choose points of size data-points (in order of X) that keep the shape of the data-series
+  (by the Largest-Triangle-Three-Buckets algorithm).
+  \tparam Series Has @c values(first, n, x, y) to copy the X and Y values of n data-points from first.
+  \param series data-points to choose from.
+  \param size Number of data-points.
+  \param points Number of data-points to choose (at least 3).
+  \param kept Set to the indices of the data-points chosen, in order (or empty if all are, if points >= size or points < 3).
+  \param threads Number of threads (default 0 uses @c std::thread::hardware_concurrency).
+  \details The first and last data-points are always chosen. The others are divided into points - 2 buckets,
+    and from each the data-point making the largest triangle with that chosen from the bucket before,
+    and with the average of the bucket after.\n
+    The averages of the buckets are found in parallel, and, for very large data-series, the buckets are chosen from
+    in parallel, in chunks of about @c lttb_chunk_size data-points, each starting from the average of the bucket before
+    (rather than the data-point chosen from it, as yet unknown).
+    The chunks do not depend on the number of threads, so neither do the data-points chosen.
+*/
+template <class Series>
+void lttb_select(const Series& series, std::size_t size, std::size_t points, std::vector<std::size_t>& kept,
+  unsigned int threads = 0)
+{
+  kept.clear();
+  if ((points >= size) || (points < 3))
+  {
+    return;
+  }
+  const std::size_t buckets = points - 2;
+  std::vector<std::size_t> begin(buckets + 1); // Of each bucket, and end of last.
+  for (std::size_t b = 0; b <= buckets; ++b)
+  {
+    begin[b] = 1 + b * (size - 2) / buckets;
+  }
+  if (threads == 0)
+  {
+    threads = (std::max)(std::thread::hardware_concurrency(), 1U);
+  }
+  threads = static_cast<unsigned int>((std::min)(static_cast<std::size_t>(threads), size / lttb_chunk_size + 1));
+  auto in_parallel = [&](std::size_t n, const std::function<void(std::size_t, std::size_t)>& f)
+  { // Call f(first, last) for ranges of 0 to n, one on each thread.
+    std::vector<std::thread> pool;
+    for (unsigned int t = 1; t < threads; ++t)
+    {
+      pool.push_back(std::thread(f, n * t / threads, n * (t + 1) / threads));
+    }
+    f(0, n / threads);
+    for (std::size_t t = 0; t < pool.size(); ++t)
+    {
+      pool[t].join();
+    }
+  };
+
+  // Average of each bucket.
+  std::vector<double> mean_x(buckets + 1);
+  std::vector<double> mean_y(buckets + 1);
+  in_parallel(buckets, [&](std::size_t first, std::size_t last)
+  {
+    double x[lttb_block_size];
+    double y[lttb_block_size];
+    for (std::size_t b = first; b != last; ++b)
+    {
+      double sum_x = 0.;
+      double sum_y = 0.;
+      for (std::size_t i = begin[b]; i != begin[b + 1];)
+      {
+        const std::size_t n = (std::min)(lttb_block_size, begin[b + 1] - i);
+        series.values(i, n, x, y);
+        for (std::size_t j = 0; j != n; ++j)
+        {
+          sum_x += x[j];
+          sum_y += y[j];
+        }
+        i += n;
+      }
+      mean_x[b] = sum_x / static_cast<double>(begin[b + 1] - begin[b]);
+      mean_y[b] = sum_y / static_cast<double>(begin[b + 1] - begin[b]);
+    }
+  });
+  series.values(size - 1, 1, &mean_x[buckets], &mean_y[buckets]); // Last data-point follows the last bucket.
+
+  // Choose from each bucket, in chunks of buckets.
+  kept.resize(points);
+  kept[0] = 0;
+  kept[points - 1] = size - 1;
+  const std::size_t chunk = (std::max)(static_cast<std::size_t>(1), lttb_chunk_size * buckets / size); // Buckets.
+  const std::size_t chunks = (buckets + chunk - 1) / chunk;
+  in_parallel(chunks, [&](std::size_t first, std::size_t last)
+  {
+    double x[lttb_block_size];
+    double y[lttb_block_size];
+    for (std::size_t k = first; k != last; ++k)
+    {
+      double a_x; // data-point chosen from the bucket before.
+      double a_y;
+      if (k == 0)
+      {
+        series.values(0, 1, &a_x, &a_y);
+      }
+      else
+      {
+        a_x = mean_x[k * chunk - 1];
+        a_y = mean_y[k * chunk - 1];
+      }
+      for (std::size_t b = k * chunk; b != (std::min)((k + 1) * chunk, buckets); ++b)
+      {
+        const double c_x = mean_x[b + 1]; // Average of the bucket after.
+        const double c_y = mean_y[b + 1];
+        double largest = -1.;
+        for (std::size_t i = begin[b]; i != begin[b + 1];)
+        {
+          const std::size_t n = (std::min)(lttb_block_size, begin[b + 1] - i);
+          series.values(i, n, x, y);
+          for (std::size_t j = 0; j != n; ++j)
+          { // Twice the area of the triangle.
+            const double area = std::abs((a_x - c_x) * (y[j] - a_y) - (a_x - x[j]) * (c_y - a_y));
+            if (area > largest)
+            {
+              largest = area;
+              kept[b + 1] = i + j;
+            }
+          }
+          i += n;
+        }
+        series.values(kept[b + 1], 1, &a_x, &a_y);
+      }
+    }
+  });
+} // void lttb_select
+
+} // namespace detail
+} // namespace svg
+} // namespace boost
+
+#endif // BOOST_SVG_DOWNSAMPLE_HPP
@@ -0,0 +1,200 @@
+/*! \file
+    \brief Optional monotonic arena from which SVG document tree elements can be allocated.
+    \details
+      Plots of many data-points add one small element (circle, text, line...)
+      per point to the SVG document tree, each allocated by a separate @c new.
+      An @c element_arena owned by class @c svg instead carves these elements
+      out of a few large blocks, and frees them all in one shot.
+*/
+
+// element_arena.hpp
+
+// Copyright Paul A. Bristow 2020
+
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_SVG_ELEMENT_ARENA_HPP
+#define BOOST_SVG_ELEMENT_ARENA_HPP
+
+#include <boost/ptr_container/clone_allocator.hpp>
+// using boost::heap_clone_allocator;
+
+#include <cstddef>
+// using std::size_t;
+#include <new>
+// using placement new.
+#include <utility>
+// using std::forward.
+#include <vector>
+// using std::vector;
+
+namespace boost
+{
+namespace svg
+{
+namespace detail
+{
+
+class element_arena
+{ /*! \class boost::svg::detail::element_arena
+     \brief Monotonic block allocator for SVG document elements.
+     \details Memory is handed out by bumping a pointer through large blocks,
+     and is only returned (all together) by @c release() or the destructor.
+     Objects placed in the arena must be destroyed (but not deleted) by their owner,
+     see @c arena_clone_allocator.
+  */
+public:
+  explicit element_arena(std::size_t block_size = 64 * 1024)
+    : block_size_(block_size), next_(0), current_(0), remaining_(0), used_(0)
+  { //! Construct an empty arena, no memory is allocated until the first element.
+  }
+
+  ~element_arena()
+  { //! Destructor frees all blocks.
+    release();
+    for (std::size_t i = 0; i < blocks_.size(); ++i)
+    {
+      ::operator delete(blocks_[i]);
+    }
+  }
+
+  void* allocate(std::size_t bytes, std::size_t align)
+  { //! \return Pointer to @c bytes of storage aligned to @c align (a power of two).
+    if (bytes + align > block_size_)
+    { // Oversized request gets a block of its own, freed by release().
+      char* q = static_cast<char*>(::operator new(bytes + align));
+      large_.push_back(q);
+      used_ += bytes;
+      return q + padding(q, align);
+    }
+    std::size_t pad = padding(current_, align);
+    if (pad + bytes > remaining_)
+    { // Move to the next block, re-using any kept by release().
+      if (next_ == blocks_.size())
+      {
+        blocks_.push_back(::operator new(block_size_));
+      }
+      current_ = static_cast<char*>(blocks_[next_++]);
+      remaining_ = block_size_;
+      pad = padding(current_, align);
+    }
+    void* p = current_ + pad;
+    current_ += pad + bytes;
+    remaining_ -= pad + bytes;
+    used_ += bytes;
+    return p;
+  }
+
+  void release()
+  { /*! Make all the memory available for re-use in one shot.
+      Blocks are kept (so that a re-drawn plot needs no new blocks), any oversized allocations are freed.
+      The caller must already have destroyed all objects placed in the arena.
+    */
+    for (std::size_t i = 0; i < large_.size(); ++i)
+    {
+      ::operator delete(large_[i]);
+    }
+    large_.clear();
+    next_ = 0;
+    current_ = 0;
+    remaining_ = 0;
+    used_ = 0;
+  }
+
+  std::size_t bytes_used() const
+  { //! \return Total bytes handed out since construction or the last @c release().
+    return used_;
+  }
+
+  std::size_t blocks() const
+  { //! \return Number of blocks currently held by the arena (excluding oversized allocations).
+    return blocks_.size();
+  }
+
+private:
+  element_arena(const element_arena&); // Not copyable.
+  element_arena& operator=(const element_arena&);
+
+  static std::size_t padding(const char* p, std::size_t align)
+  { // Bytes needed to round p up to a multiple of align.
+    return (align - (reinterpret_cast<std::size_t>(p) & (align - 1))) & (align - 1);
+  }
+
+  std::size_t block_size_; //!< Size of each block (bytes).
+  std::vector<void*> blocks_; //!< All blocks, in use and kept for re-use.
+  std::vector<void*> large_; //!< Oversized allocations, freed by release().
+  std::size_t next_; //!< Index of next block to use from @c blocks_.
+  char* current_; //!< Next free byte in current block.
+  std::size_t remaining_; //!< Bytes left in current block.
+  std::size_t used_; //!< Bytes handed out.
+}; // class element_arena
+
+struct arena_allocated
+{ /*! \struct boost::svg::detail::arena_allocated
+      \brief Base that records if an element was constructed in an @c element_arena
+      (and so must be destroyed, not deleted).
+      \details Copies are never in an arena, so the copy constructor and assignment do not copy the flag.
+   */
+  arena_allocated() : in_arena_(false)
+  {
+  }
+  arena_allocated(const arena_allocated&) : in_arena_(false)
+  {
+  }
+  arena_allocated& operator=(const arena_allocated&)
+  {
+    return *this;
+  }
+  bool in_arena_; //!< @c true if constructed in an @c element_arena.
+}; // struct arena_allocated
+
+struct arena_clone_allocator
+{ /*! \struct boost::svg::detail::arena_clone_allocator
+      \brief Boost.PtrContainer clone allocator for containers holding both heap and arena elements.
+      \details Clones always go on the heap; arena elements are only destroyed,
+      their memory is returned when the arena is released.
+  */
+  template <class U>
+  static U* allocate_clone(const U& r)
+  {
+    return heap_clone_allocator::allocate_clone(r);
+  }
+
+  template <class U>
+  static void deallocate_clone(const U* r)
+  {
+    if (r != 0 && r->in_arena_)
+    {
+      r->~U();
+    }
+    else
+    {
+      heap_clone_allocator::deallocate_clone(r);
+    }
+  }
+}; // struct arena_clone_allocator
+
+template <class Base, class T, class... Args>
+T* make_element(element_arena* arena, Args&&... args)
+{ /*! \return Pointer to a new element of type T constructed from @c args,
+      in the arena if one is provided, else on the heap.
+      \tparam Base Type held by the owning @c ptr_vector, whose flag @c in_arena_ is set
+      (@c tspan_element has two @c arena_allocated bases).
+  */
+  if (arena == 0)
+  {
+    return new T(std::forward<Args>(args)...);
+  }
+  T* p = new (arena->allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  static_cast<Base*>(p)->in_arena_ = true;
+  return p;
+}
+
+} // namespace detail
+} // namespace svg
+} // namespace boost
+
+#endif // BOOST_SVG_ELEMENT_ARENA_HPP
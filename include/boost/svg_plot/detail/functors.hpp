@@ -32,6 +32,9 @@
 #include <boost/quan/unc.hpp>
 #include <boost/quan/meas.hpp>
 
+#include <type_traits> // for std::is_arithmetic.
+#include <utility> // for std::pair.
+
 namespace boost {
 namespace svg {
 namespace detail
@@ -260,6 +263,22 @@ public:
   }
 }; // class pair_Meas_2d_double_convert
 
+/*! \brief @c true if data values of type T are plain arithmetic values (like @c double or @c int),
+   or @c std::pair s of them, so have no uncertainty, degrees of freedom, timestamp or other information.
+   \details Data-series of plain values are held as just @c double s, without conversion to @c Meas or @c unc.
+*/
+template <class T>
+struct is_plain_value : std::is_arithmetic<typename std::remove_cv<T>::type>
+{
+};
+
+//! A pair of X and Y data values is plain if both are plain (the X of a @c std::map is @c const).
+template <class T, class U>
+struct is_plain_value<std::pair<T, U> >
+  : std::integral_constant<bool, is_plain_value<T>::value && is_plain_value<U>::value>
+{
+};
+
 } // namespace detail
 } // namespace svg
 } // namespace boost
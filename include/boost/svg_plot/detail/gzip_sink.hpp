@@ -0,0 +1,223 @@
+/*! \file
+    \brief Output sink that writes a compressed .svgz file, deflating the SVG XML as it is written.
+    \details
+      An .svgz file is an SVG XML document compressed in gzip format (RFC 1952),
+      which all browsers and Inkscape display exactly like the .svg file.
+      SVG XML is very repetitive, so .svgz files are typically 5 to 10 times smaller.
+      A @c gzip_sink passes each buffer-full of output through zlib @c deflate while the document is serialized,
+      so the uncompressed text is never held in memory, nor written to (and re-read from) a file.
+
+      zlib is needed only for compressed output: define the macro @c BOOST_SVG_SVGZ
+      (before including any svg_plot header) and link with zlib (for example, @c -lz).
+      Without @c BOOST_SVG_SVGZ, constructing a @c gzip_sink throws @c std::runtime_error,
+      and files named .svgz are written uncompressed (unless @c compress_on(true), which then throws).
+*/
+
+// gzip_sink.hpp
+
+// Copyright Paul A. Bristow 2020
+
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_SVG_GZIP_SINK_HPP
+#define BOOST_SVG_GZIP_SINK_HPP
+
+#include "output_sink.hpp"
+
+#include <algorithm>
+// using std::min;
+#include <cstddef>
+// using std::size_t;
+#include <cstdio>
+// using std::FILE; std::fopen; std::fwrite; std::fclose;
+#include <stdexcept>
+// using std::runtime_error;
+#include <string>
+// using std::string;
+#include <vector>
+// using std::vector;
+
+#ifdef BOOST_SVG_SVGZ
+#  include <zlib.h>
+// using deflateInit2, deflate, deflateEnd.
+#endif
+
+namespace boost
+{
+namespace svg
+{
+namespace detail
+{
+  inline bool is_svgz(const std::string& filename)
+  { //! \return @c true if filename ends with the .svgz suffix of compressed SVG files.
+    const std::string suffix(".svgz");
+    return filename.size() >= suffix.size()
+      && filename.compare(filename.size() - suffix.size(), suffix.size(), suffix) == 0;
+  }
+
+  inline bool is_compressed(bool compress_on, const std::string& filename)
+  { //! \return @c true if file filename is to be written compressed: if @c compress_on, or (if zlib is available) if named .svgz.
+#ifdef BOOST_SVG_SVGZ
+    return compress_on || is_svgz(filename);
+#else
+    (void)filename;
+    return compress_on; // Throws for want of zlib, but a file named .svgz is written uncompressed, as always before.
+#endif
+  }
+} // namespace detail
+
+class gzip_sink : public output_sink
+{ /*! \class boost::svg::gzip_sink
+     \brief Writes output to a file compressed in gzip format (as .svgz), deflating each buffer-full as it is filled.
+     \details Used by @c write(filename) of svg and plots if the filename ends with .svgz (and @c BOOST_SVG_SVGZ is defined),
+     or if @c compress_on(true), but can also be used directly, for example:
+     \code
+       gzip_sink sink("my_plot.svgz");
+       my_plot.write(sink);
+       sink.close(); // Optional: throws if the file could not be completely written.
+     \endcode
+  */
+public:
+  explicit gzip_sink(const std::string& filename, int level = 6, std::size_t buffer_size = 256 * 1024)
+    : in_(buffer_size == 0 ? 1 : buffer_size), out_(in_.size() / 2 + 64), file_(0), open_(false)
+  { /*! Construct a sink writing to compressed file @c filename.
+      \param level zlib compression level, 1 (fastest) to 9 (smallest) (default 6, as gzip).
+      \param buffer_size Bytes of uncompressed output buffered before each deflate.
+    */
+#ifdef BOOST_SVG_SVGZ
+    file_ = std::fopen(filename.c_str(), "wb");
+    if (file_ == 0)
+    {
+      throw std::runtime_error("Unable to open file " + filename);
+    }
+    z_.zalloc = Z_NULL;
+    z_.zfree = Z_NULL;
+    z_.opaque = Z_NULL;
+    const int gzip_window_bits = 15 + 16; // Largest window, with gzip header and trailer (rather than zlib).
+    if (deflateInit2(&z_, level, Z_DEFLATED, gzip_window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+      std::fclose(file_);
+      throw std::runtime_error("Unable to initialize zlib deflate for " + filename);
+    }
+    open_ = true;
+    setp(in_.data(), in_.data() + in_.size());
+#else
+    (void)level;
+    throw std::runtime_error("Unable to write compressed file " + filename
+      + ": define BOOST_SVG_SVGZ and link with zlib for .svgz output.");
+#endif
+  }
+
+  ~gzip_sink()
+  { //! Destructor finishes the compressed file (if not already closed), ignoring any error.
+    try
+    {
+      close();
+    }
+    catch (...)
+    {
+    }
+  }
+
+  void close()
+  { //! Write any buffered output and the gzip trailer, and close the file, throwing @c std::runtime_error if unable.
+    if (!open_)
+    {
+      return;
+    }
+    open_ = false;
+    bool ok = deflate_buffer(true);
+#ifdef BOOST_SVG_SVGZ
+    deflateEnd(&z_);
+#endif
+    ok = (std::fclose(file_) == 0) && ok;
+    if (!ok)
+    {
+      throw std::runtime_error("Unable to write compressed file.");
+    }
+  }
+
+protected:
+  int_type overflow(int_type c)
+  { // Buffer is full: deflate it all.
+    if (!open_ || !deflate_buffer(false))
+    {
+      return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  std::streamsize xsputn(const char* s, std::streamsize n)
+  { // Copy into the buffer, deflating each time it fills.
+    std::streamsize done = 0;
+    while (done < n)
+    {
+      if (pptr() == epptr() && (!open_ || !deflate_buffer(false)))
+      {
+        break;
+      }
+      std::streamsize chunk = (std::min)(n - done, static_cast<std::streamsize>(epptr() - pptr()));
+      traits_type::copy(pptr(), s + done, static_cast<std::size_t>(chunk));
+      pbump(static_cast<int>(chunk));
+      done += chunk;
+    }
+    return done;
+  }
+
+  // sync() is not overridden: flushing the stream must not flush the compressor,
+  // which would reduce compression.
+
+private:
+  gzip_sink(const gzip_sink&); // Not copyable.
+  gzip_sink& operator=(const gzip_sink&);
+
+  bool deflate_buffer(bool finish)
+  { // Deflate the buffered chars (and finish the compressed stream if finish), writing the compressed output to the file.
+#ifdef BOOST_SVG_SVGZ
+    z_.next_in = reinterpret_cast<Bytef*>(pbase());
+    z_.avail_in = static_cast<uInt>(pptr() - pbase());
+    int result = Z_OK;
+    do
+    {
+      z_.next_out = reinterpret_cast<Bytef*>(out_.data());
+      z_.avail_out = static_cast<uInt>(out_.size());
+      result = deflate(&z_, finish ? Z_FINISH : Z_NO_FLUSH);
+      if (result == Z_STREAM_ERROR)
+      {
+        return false;
+      }
+      std::size_t n = out_.size() - z_.avail_out;
+      if (n != 0 && std::fwrite(out_.data(), 1, n, file_) != n)
+      {
+        return false;
+      }
+    } while (z_.avail_out == 0 || (finish && result != Z_STREAM_END));
+    setp(in_.data(), in_.data() + in_.size());
+    return true;
+#else
+    (void)finish;
+    return false;
+#endif
+  }
+
+  std::vector<char> in_; // Uncompressed output waiting to be deflated.
+  std::vector<char> out_; // Compressed output from deflate, written to file.
+  std::FILE* file_; // Written to.
+  bool open_; // true until closed.
+#ifdef BOOST_SVG_SVGZ
+  z_stream z_; // zlib deflate state.
+#endif
+}; // class gzip_sink
+
+} // namespace svg
+} // namespace boost
+
+#endif // BOOST_SVG_GZIP_SINK_HPP
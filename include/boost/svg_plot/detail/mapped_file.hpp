@@ -0,0 +1,186 @@
+/*! \file
+    \brief Read-only memory-mapped file, for loading large data files without copying them, see @c read_csv.
+    \details The whole file is mapped into memory (by @c mmap, or @c MapViewOfFile on Windows),
+      so is read by the operating system only as its pages are used, and never copied into a buffer.
+      Where memory-mapping is not available (or fails), the whole file is read into memory instead.
+*/
+
+// mapped_file.hpp
+
+// Copyright Paul A. Bristow 2020
+
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_SVG_MAPPED_FILE_HPP
+#define BOOST_SVG_MAPPED_FILE_HPP
+
+#include <cstddef>
+// using std::size_t;
+#include <fstream>
+// using std::ifstream;
+#include <stdexcept>
+// using std::runtime_error;
+#include <string>
+// using std::string;
+#include <vector>
+// using std::vector;
+
+#if defined(_WIN32)
+// Boost.WinAPI declares just the functions used, without including <windows.h> (and its macros) for every user.
+#  include <boost/winapi/access_rights.hpp>
+#  include <boost/winapi/file_management.hpp>
+#  include <boost/winapi/file_mapping.hpp>
+#  include <boost/winapi/handles.hpp>
+#  include <boost/winapi/page_protection_flags.hpp>
+#elif defined(__unix__) || defined(__APPLE__)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#  define BOOST_SVG_HAS_MMAP
+#endif
+
+namespace boost
+{
+namespace svg
+{
+namespace detail
+{
+
+class mapped_file
+{ /*! \class boost::svg::detail::mapped_file
+      \brief Contents of a whole file, read-only, memory-mapped (or read into memory if mapping is not available).
+  */
+public:
+  explicit mapped_file(const std::string& filename) : data_(0), size_(0), mapped_(false)
+  { //! Map the file filename, throwing @c std::runtime_error if it cannot be opened.
+#if defined(_WIN32)
+    namespace winapi = boost::winapi;
+    file_ = winapi::CreateFileA(filename.c_str(), winapi::GENERIC_READ_, winapi::FILE_SHARE_READ_, 0,
+      winapi::OPEN_EXISTING_, winapi::FILE_FLAG_SEQUENTIAL_SCAN_, 0);
+    mapping_ = 0;
+    if (file_ == winapi::INVALID_HANDLE_VALUE_)
+    {
+      throw std::runtime_error("Failed to open file " + filename);
+    }
+    winapi::LARGE_INTEGER_ size;
+    if (winapi::GetFileSizeEx(file_, &size) && size.QuadPart > 0)
+    {
+      size_ = static_cast<std::size_t>(size.QuadPart);
+      mapping_ = winapi::CreateFileMappingA(file_, 0, winapi::PAGE_READONLY_, 0, 0, 0);
+      if (mapping_ != 0)
+      {
+        data_ = static_cast<const char*>(winapi::MapViewOfFile(mapping_, winapi::FILE_MAP_READ_, 0, 0, 0));
+        mapped_ = (data_ != 0);
+      }
+    }
+    if (!mapped_)
+    { // Empty, or cannot be mapped, so close before reading instead.
+      if (mapping_ != 0)
+      {
+        winapi::CloseHandle(mapping_);
+        mapping_ = 0;
+      }
+      winapi::CloseHandle(file_);
+      file_ = winapi::INVALID_HANDLE_VALUE_;
+    }
+#elif defined(BOOST_SVG_HAS_MMAP)
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      throw std::runtime_error("Failed to open file " + filename);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+      size_ = static_cast<std::size_t>(st.st_size);
+      void* p = ::mmap(0, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p != MAP_FAILED)
+      {
+        ::madvise(p, size_, MADV_SEQUENTIAL); // Read ahead.
+        data_ = static_cast<const char*>(p);
+        mapped_ = true;
+      }
+    }
+    ::close(fd); // The mapping keeps the file open.
+#endif
+    if (!mapped_)
+    { // Read the whole file instead.
+      std::ifstream in(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+      if (!in.is_open())
+      {
+        throw std::runtime_error("Failed to open file " + filename);
+      }
+      in.seekg(0, std::ios_base::end);
+      std::streamoff size = in.tellg();
+      in.seekg(0, std::ios_base::beg);
+      buffer_.resize(size > 0 ? static_cast<std::size_t>(size) : 0);
+      if (!buffer_.empty() && !in.read(&buffer_[0], static_cast<std::streamsize>(buffer_.size())))
+      {
+        throw std::runtime_error("Failed to read file " + filename);
+      }
+      data_ = buffer_.empty() ? 0 : &buffer_[0];
+      size_ = buffer_.size();
+    }
+  }
+
+  ~mapped_file()
+  {
+#if defined(_WIN32)
+    if (mapped_)
+    {
+      boost::winapi::UnmapViewOfFile(data_);
+    }
+    if (mapping_ != 0)
+    {
+      boost::winapi::CloseHandle(mapping_);
+    }
+    if (file_ != boost::winapi::INVALID_HANDLE_VALUE_)
+    {
+      boost::winapi::CloseHandle(file_);
+    }
+#elif defined(BOOST_SVG_HAS_MMAP)
+    if (mapped_)
+    {
+      ::munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+  }
+
+  const char* data() const
+  { //! \return First char of the file (null if the file is empty).
+    return data_;
+  }
+
+  std::size_t size() const
+  { //! \return Size of the file in bytes.
+    return size_;
+  }
+
+  bool mapped() const
+  { //! \return @c true if the file is memory-mapped, @c false if read into memory.
+    return mapped_;
+  }
+
+private:
+  mapped_file(const mapped_file&); // Not copyable.
+  mapped_file& operator=(const mapped_file&);
+
+  const char* data_; //!< Contents of the file.
+  std::size_t size_; //!< Bytes in the file.
+  bool mapped_; //!< true if memory-mapped (rather than in buffer_).
+  std::vector<char> buffer_; //!< Contents of the file if not memory-mapped.
+#if defined(_WIN32)
+  boost::winapi::HANDLE_ file_; //!< Open file.
+  boost::winapi::HANDLE_ mapping_; //!< File mapping object, or null.
+#endif
+}; // class mapped_file
+
+} // namespace detail
+} // namespace svg
+} // namespace boost
+
+#endif // BOOST_SVG_MAPPED_FILE_HPP
@@ -0,0 +1,631 @@
+/*! \file
+    \brief Output sink that minifies SVG XML as it is written, for the compact output profile, see @c svg::compact_output.
+    \details
+      Elements write their SVG XML laid out for reading: each on a line of its own, indented by tabs,
+      with comments naming the program, file and license, and colors as @c rgb(r,g,b).
+      A @c minify_sink rewrites the XML as it passes through, keeping the image rendered exactly the same:
+      \li comments and the whitespace between tags are omitted,
+        and whitespace within tags and attribute values is reduced to single spaces (or none);
+      \li whitespace within text elements is reduced to what is rendered, following the SVG (and CSS) whitespace rules,
+        so spaces between text and tspans are kept (as a single space);
+      \li colors @c rgb(r,g,b) are written as @c \#rrggbb, or @c \#rgb when that is exact;
+      \li attributes that set an inherited property (fill, stroke, font-size, text-anchor...)
+        to the value it already has (from a parent group, or the SVG initial value) are omitted,
+        as are x, y, dx and dy of zero, and opacity of one, which are the defaults.
+
+      No attribute is omitted if the document has a stylesheet, nor within elements with a class or style attribute,
+      nor within definitions (defs, symbols, markers, clip paths...) that inherit from where they are used.
+*/
+
+// minify_sink.hpp
+
+// Copyright Paul A. Bristow 2020
+
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_SVG_MINIFY_SINK_HPP
+#define BOOST_SVG_MINIFY_SINK_HPP
+
+#include "output_sink.hpp"
+
+#include <cstddef>
+// using std::size_t;
+#include <stdexcept>
+// using std::runtime_error;
+#include <streambuf>
+// using std::streambuf;
+#include <string>
+// using std::string;
+#include <utility>
+// using std::pair;
+#include <vector>
+// using std::vector;
+
+namespace boost
+{
+namespace svg
+{
+namespace detail
+{
+  inline bool is_xml_space(char c)
+  { //! \return @c true if c is XML whitespace.
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+  }
+
+  inline bool is_inherited_property(const std::string& name)
+  { //! \return @c true if attribute name is an SVG presentation attribute for a property inherited by child elements.
+    static const char* const inherited[] =
+    {
+      "clip-rule", "color", "direction", "fill", "fill-opacity", "fill-rule",
+      "font-family", "font-size", "font-stretch", "font-style", "font-variant", "font-weight",
+      "letter-spacing", "stroke", "stroke-dasharray", "stroke-dashoffset", "stroke-linecap",
+      "stroke-linejoin", "stroke-miterlimit", "stroke-opacity", "stroke-width",
+      "text-anchor", "visibility", "word-spacing", "writing-mode"
+    };
+    for (std::size_t i = 0; i != sizeof(inherited) / sizeof(inherited[0]); ++i)
+    {
+      if (name == inherited[i])
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  inline bool is_initial_value(const std::string& name, const std::string& value)
+  { //! \return @c true if value is the SVG initial value of inherited property name (as written by a @c minify_sink).
+    static const char* const initial[][2] =
+    {
+      {"fill", "#000"}, {"fill", "black"}, {"fill-opacity", "1"}, {"fill-rule", "nonzero"},
+      {"font-stretch", "normal"}, {"font-style", "normal"}, {"font-variant", "normal"}, {"font-weight", "normal"},
+      {"letter-spacing", "normal"}, {"stroke", "none"}, {"stroke-dasharray", "none"}, {"stroke-dashoffset", "0"},
+      {"stroke-linecap", "butt"}, {"stroke-linejoin", "miter"}, {"stroke-miterlimit", "4"}, {"stroke-opacity", "1"},
+      {"stroke-width", "1"}, {"text-anchor", "start"}, {"visibility", "visible"}, {"word-spacing", "normal"}
+    };
+    for (std::size_t i = 0; i != sizeof(initial) / sizeof(initial[0]); ++i)
+    {
+      if (name == initial[i][0] && value == initial[i][1])
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  inline bool is_relative_value(const std::string& value)
+  { /*! \return @c true if value may be relative to the font size or viewport (like 50%, 1.2em, larger),
+      and so the same value may not be the same when inherited.
+    */
+    if (value.find('%') != std::string::npos || value == "larger" || value == "smaller")
+    {
+      return true;
+    }
+    const std::size_t n = value.size();
+    return n >= 2 && value[n - 2] == 'e' && (value[n - 1] == 'm' || value[n - 1] == 'x');
+  }
+
+  inline void hex_colors(std::string& value)
+  { //! Replace each color rgb(r,g,b) in value by #rrggbb, or #rgb if that is exact.
+    static const char hex[] = "0123456789abcdef";
+    std::size_t at = 0;
+    while ((at = value.find("rgb(", at)) != std::string::npos)
+    {
+      std::size_t p = at + 4;
+      int rgb[3];
+      bool ok = true;
+      for (int i = 0; i != 3 && ok; ++i)
+      { // Three decimal integers 0 to 255, separated by commas (and perhaps spaces).
+        while (p < value.size() && value[p] == ' ')
+        {
+          ++p;
+        }
+        std::size_t digits = 0;
+        rgb[i] = 0;
+        while (p < value.size() && value[p] >= '0' && value[p] <= '9' && digits < 4)
+        {
+          rgb[i] = rgb[i] * 10 + (value[p++] - '0');
+          ++digits;
+        }
+        while (p < value.size() && value[p] == ' ')
+        {
+          ++p;
+        }
+        ok = digits != 0 && rgb[i] <= 255 && p < value.size() && value[p++] == (i == 2 ? ')' : ',');
+      }
+      if (!ok)
+      {
+        at += 4;
+        continue;
+      }
+      std::string color(1, '#');
+      if (rgb[0] % 17 == 0 && rgb[1] % 17 == 0 && rgb[2] % 17 == 0)
+      { // Each of the two hex digits the same, like #ff00cc, so can be #f0c.
+        for (int i = 0; i != 3; ++i)
+        {
+          color += hex[rgb[i] / 17];
+        }
+      }
+      else
+      {
+        for (int i = 0; i != 3; ++i)
+        {
+          color += hex[rgb[i] / 16];
+          color += hex[rgb[i] % 16];
+        }
+      }
+      value.replace(at, p - at, color);
+      at += color.size();
+    }
+  } // void hex_colors
+} // namespace detail
+
+class minify_sink : public output_sink
+{ /*! \class boost::svg::minify_sink
+     \brief Minifies SVG XML written to it, passing the result on to another @c std::streambuf.
+     \details Used by @c write of svg and plots if @c compact_output(true), but can also be used directly, for example:
+     \code
+       std::ofstream f("my_plot.svg");
+       minify_sink sink(f.rdbuf());
+       my_plot.write(sink);
+       sink.close(); // Minify anything still buffered, and pass on to the ofstream.
+     \endcode
+  */
+public:
+  explicit minify_sink(std::streambuf* target, std::size_t buffer_size = 64 * 1024)
+    : target_(target), in_(buffer_size == 0 ? 1 : buffer_size), state_(content), quote_(0),
+    depth_(0), text_depth_(0), leading_(false), nonblank_(false), preserve_(false), styled_(false), closed_(false)
+  { /*! Construct a sink writing minified SVG XML to target (which must outlive the sink).
+      \param buffer_size Bytes of SVG XML buffered before each is minified and passed on.
+    */
+    setp(in_.data(), in_.data() + in_.size());
+    out_.reserve(in_.size());
+  }
+
+  ~minify_sink()
+  { //! Destructor passes on anything still buffered (if not already closed), ignoring any error.
+    try
+    {
+      close();
+    }
+    catch (...)
+    {
+    }
+  }
+
+  void reserve(std::size_t n)
+  { //! Pass on an estimate of the size of the document (before minifying, so an overestimate) to the target, if an @c output_sink.
+    if (output_sink* sink = dynamic_cast<output_sink*>(target_))
+    {
+      sink->reserve(n);
+    }
+  }
+
+  void close()
+  { //! Minify anything buffered, and pass it on to the target, throwing @c std::runtime_error if unable.
+    if (closed_)
+    {
+      return;
+    }
+    closed_ = true;
+    minify_buffer();
+    if (!write_out())
+    {
+      throw std::runtime_error("Unable to write minified SVG.");
+    }
+  }
+
+protected:
+  int_type overflow(int_type c)
+  { // Buffer is full: minify it all.
+    if (closed_ || !minify_buffer())
+    {
+      return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  int sync()
+  { // Minify the buffer (on flush, or std::endl), but only pass on when the output is large,
+    // because the document is flushed often.
+    return minify_buffer() ? 0 : -1;
+  }
+
+private:
+  enum state_type
+  {
+    content, //!< Between tags.
+    tag, //!< Within a tag (or the start of a comment, CDATA section, processing instruction or DOCTYPE).
+    comment, //!< Within a comment, which is omitted.
+    verbatim //!< Within a CDATA section, processing instruction or DOCTYPE, which is passed on unchanged.
+  };
+
+  struct element
+  { //! An element whose tag is open.
+    std::vector<std::pair<std::string, std::string> > inherited; //!< Inherited property attributes set by the element.
+    bool unknown; //!< Properties may be set other than by attributes (stylesheet or use of a definition), so none are omitted.
+    bool preserve; //!< Has xml:space="preserve" (or its parent has), so all whitespace is kept.
+  };
+
+  bool minify_buffer()
+  { // Minify the buffered chars, and pass on the output if it is large.
+    for (const char* p = pbase(); p != pptr(); ++p)
+    {
+      put(*p);
+    }
+    setp(in_.data(), in_.data() + in_.size());
+    return out_.size() < in_.size() || write_out();
+  }
+
+  bool write_out()
+  { // Pass on the minified output to the target.
+    const std::streamsize n = static_cast<std::streamsize>(out_.size());
+    const bool ok = n == 0 || target_->sputn(out_.data(), n) == n;
+    out_.clear();
+    return ok;
+  }
+
+  void put(char c)
+  { // Minify one more char.
+    switch (state_)
+    {
+    case content:
+      if (c == '<')
+      {
+        state_ = tag;
+        tag_.assign(1, c);
+        quote_ = 0;
+      }
+      else if (detail::is_xml_space(c))
+      {
+        space_ += c;
+      }
+      else
+      {
+        text();
+        out_ += c;
+      }
+      break;
+    case tag:
+      tag_ += c;
+      if (quote_ != 0)
+      { // Within an attribute value, which may contain > (and <).
+        if (c == quote_)
+        {
+          quote_ = 0;
+        }
+      }
+      else if (c == '"' || c == '\'')
+      {
+        quote_ = c;
+      }
+      else if (tag_.size() == 2 && c == '?')
+      { // Processing instruction, like <?xml version="1.0"?>.
+        start_verbatim("?>");
+      }
+      else if (tag_.size() == 4 && tag_ == "<!--")
+      {
+        state_ = comment;
+      }
+      else if (tag_.size() == 9 && tag_ == "<![CDATA[")
+      {
+        start_verbatim("]]>");
+      }
+      else if (c == '>')
+      {
+        state_ = content;
+        if (tag_[1] == '!')
+        { // DOCTYPE.
+          text();
+          out_ += tag_;
+        }
+        else
+        {
+          end_tag();
+        }
+      }
+      break;
+    case comment:
+      tag_ += c;
+      if (c == '>' && tag_.size() >= 7 && tag_.compare(tag_.size() - 3, 3, "-->") == 0)
+      { // Omit the comment (any whitespace either side is treated as one run).
+        state_ = content;
+      }
+      break;
+    case verbatim:
+      out_ += c;
+      if (c == end_[end_.size() - 1] && out_.size() >= end_.size()
+        && out_.compare(out_.size() - end_.size(), end_.size(), end_) == 0)
+      {
+        state_ = content;
+      }
+      break;
+    }
+  } // void put(char c)
+
+  void start_verbatim(const char* end)
+  { // Pass on the rest, until end, unchanged.
+    text();
+    out_ += tag_;
+    end_ = end;
+    state_ = verbatim;
+  }
+
+  void text()
+  { // Non-whitespace content follows any run of whitespace.
+    if (!space_.empty())
+    {
+      if (preserve_ || (text_depth_ == 0))
+      { // Outside text, whitespace within content (like a title) is kept.
+        out_ += space_;
+      }
+      else if (!leading_)
+      { // Leading whitespace of text is not rendered.
+        out_ += collapsed();
+      }
+      space_.clear();
+    }
+    leading_ = false;
+    nonblank_ = true;
+  }
+
+  void tag_space(bool text_end)
+  { // A tag follows any run of whitespace.
+    if (!space_.empty())
+    {
+      if (preserve_ || (text_depth_ == 0 && nonblank_))
+      { // Whitespace at the end of content (like a title) is kept.
+        out_ += space_;
+      }
+      else if (text_depth_ != 0 && !leading_ && !text_end)
+      { // Between text and a tspan, the whitespace is rendered as a space.
+        out_ += collapsed();
+      }
+      // else whitespace between tags, or leading or trailing whitespace of text, is not rendered.
+      space_.clear();
+    }
+    nonblank_ = false;
+  }
+
+  const char* collapsed() const
+  { /* Whitespace within text is rendered as one space, except that a newline (alone) is removed by the SVG 1.1 rules,
+       but is a space for CSS white-space:normal, so is kept as a newline.
+    */
+    return space_.find_first_of(" \t") != std::string::npos ? " " : "\n";
+  }
+
+  void end_tag()
+  { // Minify the complete tag in tag_.
+    std::size_t p = 1;
+    const bool closing = tag_[1] == '/';
+    if (closing)
+    {
+      ++p;
+    }
+    std::size_t begin = p;
+    while (p < tag_.size() && !detail::is_xml_space(tag_[p]) && tag_[p] != '/' && tag_[p] != '>')
+    {
+      ++p;
+    }
+    name_.assign(tag_, begin, p - begin);
+    const bool is_text = name_ == "text";
+    tag_space(closing && is_text);
+
+    if (closing)
+    {
+      out_ += "</";
+      out_ += name_;
+      out_ += '>';
+      if (depth_ != 0)
+      {
+        --depth_;
+      }
+      if (is_text && text_depth_ != 0)
+      {
+        --text_depth_;
+      }
+      leading_ = false;
+      preserve_ = depth_ != 0 && stack_[depth_ - 1].preserve;
+      return;
+    }
+
+    // Parse the attributes.
+    std::size_t n = 0; // Number of attributes.
+    bool unknown = styled_ || (depth_ != 0 && stack_[depth_ - 1].unknown)
+      || name_ == "defs" || name_ == "symbol" || name_ == "marker" || name_ == "clipPath"
+      || name_ == "mask" || name_ == "pattern" || name_ == "linearGradient" || name_ == "radialGradient";
+    bool preserve = preserve_;
+    while (true)
+    {
+      while (p < tag_.size() && detail::is_xml_space(tag_[p]))
+      {
+        ++p;
+      }
+      if (p >= tag_.size() || tag_[p] == '/' || tag_[p] == '>')
+      {
+        break;
+      }
+      if (n == attributes_.size())
+      {
+        attributes_.resize(n + 1);
+      }
+      std::string& name = attributes_[n].first;
+      std::string& value = attributes_[n].second;
+      ++n;
+      begin = p;
+      while (p < tag_.size() && !detail::is_xml_space(tag_[p]) && tag_[p] != '=' && tag_[p] != '/' && tag_[p] != '>')
+      {
+        ++p;
+      }
+      name.assign(tag_, begin, p - begin);
+      value.clear();
+      while (p < tag_.size() && detail::is_xml_space(tag_[p]))
+      {
+        ++p;
+      }
+      if (p >= tag_.size() || tag_[p] != '=')
+      { // No value (not well-formed XML), so written as empty.
+        continue;
+      }
+      ++p;
+      while (p < tag_.size() && detail::is_xml_space(tag_[p]))
+      {
+        ++p;
+      }
+      const char quote = tag_[p++];
+      bool space = false;
+      for (; p < tag_.size() && tag_[p] != quote; ++p)
+      { // Runs of whitespace reduced to one space, and leading and trailing whitespace removed.
+        if (detail::is_xml_space(tag_[p]))
+        {
+          space = !value.empty();
+        }
+        else
+        {
+          if (space)
+          {
+            value += ' ';
+            space = false;
+          }
+          value += tag_[p];
+        }
+      }
+      ++p; // Closing quote.
+      detail::hex_colors(value);
+      if (name == "class" || name == "style")
+      {
+        unknown = true;
+      }
+      else if (name == "xml:space")
+      {
+        preserve = value == "preserve";
+      }
+    } // while attributes
+    const bool empty = tag_[tag_.size() - 2] == '/'; // Like <rect .../>, so has no content or end tag.
+
+    // Write the tag, omitting attributes with the value they would have anyway.
+    if (!empty)
+    { // Push an element to record its inherited attributes.
+      if (depth_ == stack_.size())
+      {
+        stack_.resize(depth_ + 1);
+      }
+      stack_[depth_].inherited.clear();
+      stack_[depth_].unknown = unknown;
+      stack_[depth_].preserve = preserve;
+    }
+    out_ += '<';
+    out_ += name_;
+    for (std::size_t i = 0; i != n; ++i)
+    {
+      const std::string& name = attributes_[i].first;
+      const std::string& value = attributes_[i].second;
+      if (!unknown)
+      {
+        if (detail::is_inherited_property(name))
+        {
+          if (is_inherited_value(name, value))
+          {
+            continue;
+          }
+          if (!empty)
+          {
+            stack_[depth_].inherited.push_back(attributes_[i]);
+          }
+        }
+        else if (is_default_value(name, value))
+        {
+          continue;
+        }
+      }
+      out_ += ' ';
+      out_ += name;
+      const char quote = value.find('"') == std::string::npos ? '"' : '\'';
+      out_ += '=';
+      out_ += quote;
+      out_ += value;
+      out_ += quote;
+    }
+    out_ += empty ? "/>" : ">";
+
+    if (name_ == "style")
+    { // Stylesheet may set any property of any element, so no attribute can be omitted.
+      styled_ = true;
+    }
+    leading_ = false;
+    if (!empty)
+    {
+      ++depth_;
+      preserve_ = preserve;
+      if (is_text)
+      {
+        ++text_depth_;
+        leading_ = true;
+      }
+    }
+  } // void end_tag()
+
+  bool is_inherited_value(const std::string& name, const std::string& value) const
+  { // true if inherited property name already has value, from the nearest parent setting it, or the initial value.
+    if (detail::is_relative_value(value))
+    {
+      return false;
+    }
+    for (std::size_t d = depth_; d != 0; --d)
+    {
+      const std::vector<std::pair<std::string, std::string> >& inherited = stack_[d - 1].inherited;
+      for (std::size_t i = 0; i != inherited.size(); ++i)
+      {
+        if (inherited[i].first == name)
+        {
+          return inherited[i].second == value;
+        }
+      }
+    }
+    return detail::is_initial_value(name, value);
+  }
+
+  bool is_default_value(const std::string& name, const std::string& value) const
+  { // true if (not inherited) attribute name of element name_ has the same value when omitted.
+    if (value == "0" && (name == "x" || name == "y"))
+    { // But x and y of a tspan (when omitted) continue from the previous text.
+      return name_ == "rect" || name_ == "text" || name_ == "image" || name_ == "use";
+    }
+    if (value == "0" && (name == "dx" || name == "dy"))
+    {
+      return name_ == "text" || name_ == "tspan";
+    }
+    return name == "opacity" && value == "1";
+  }
+
+  std::streambuf* target_; // Minified output passed on to.
+  std::vector<char> in_; // SVG XML waiting to be minified.
+  std::string out_; // Minified output waiting to be passed on.
+  state_type state_; // Where the next char is.
+  std::string tag_; // Tag (or comment) so far.
+  char quote_; // Quote char if within an attribute value in tag_, else 0.
+  std::string end_; // End of verbatim section.
+  std::string space_; // Whitespace run so far, between content and tags.
+  std::string name_; // Name of element of tag.
+  std::vector<std::pair<std::string, std::string> > attributes_; // Names and values of attributes of tag (re-used).
+  std::vector<element> stack_; // Elements whose tag is open (re-used).
+  std::size_t depth_; // Number of elements whose tag is open.
+  int text_depth_; // Number of text elements open.
+  bool leading_; // Just after a text start tag, so whitespace is not rendered.
+  bool nonblank_; // Content since the last tag is not all whitespace.
+  bool preserve_; // Within an element with xml:space="preserve".
+  bool styled_; // Has a stylesheet.
+  bool closed_; // true when closed.
+}; // class minify_sink
+
+} // namespace svg
+} // namespace boost
+
+#endif // BOOST_SVG_MINIFY_SINK_HPP
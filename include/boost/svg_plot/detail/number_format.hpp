@@ -0,0 +1,306 @@
+/*! \file
+    \brief Fast formatting of SVG coordinates, without using iostream number formatting.
+    \details
+      Every coordinate, length and width in an SVG document is written with @c os @c << @c x
+      using the stream precision, set to @c svg::coord_precision() (default 3).
+      Formatting doubles through iostreams (locale, facets and @c printf) dominates the time taken by write().
+      @c format_g produces exactly the same characters as @c printf("%.*g", precision, value),
+      which is what @c std::ostream uses with its default floatfield,
+      by scaling and rounding the value to an integer of precision decimal digits.
+      The few values that are (too near to) exactly half-way between two results,
+      or outside the range of exactly representable powers of ten, are passed to @c snprintf.
+*/
+
+// number_format.hpp
+
+// Copyright Paul A. Bristow 2020
+
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_SVG_NUMBER_FORMAT_HPP
+#define BOOST_SVG_NUMBER_FORMAT_HPP
+
+#include <cmath>
+// using std::floor; std::log10; std::signbit;
+#include <cstdio>
+// using std::snprintf;
+#include <cstdlib>
+// using std::strtod;
+#include <cstring>
+// using std::memcpy;
+#include <ostream>
+// using std::ostream;
+#include <string>
+// using std::string;
+
+namespace boost
+{
+namespace svg
+{
+namespace detail
+{
+
+const int max_fast_precision = 15; //!< Largest precision for which @c format_g scales exactly (all decimal digits of a double).
+
+inline int format_g(char* buf, double value, int precision)
+{ /*! Format @c value into @c buf (at least 32 chars) exactly as @c snprintf(buf, 32, "%.*g", precision, value).
+      \param precision 0 to @c max_fast_precision (0 is treated as 1, as by printf).
+      \return Number of chars written (no terminating null).
+  */
+  static const double pow10[] =
+  { // All exactly representable as double.
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  const int max_pow10 = 22;
+
+  char* p = buf;
+  double v = value;
+  if (v != v || v - v != 0)
+  { // NaN or infinity.
+    return std::snprintf(buf, 32, "%.*g", precision, value);
+  }
+  if (std::signbit(v))
+  {
+    *p++ = '-';
+    v = -v;
+  }
+  if (v == 0)
+  {
+    *p++ = '0';
+    return static_cast<int>(p - buf);
+  }
+  const int digits = (precision == 0) ? 1 : precision;
+
+  // Scale v to an integer of digits decimal digits, by an exact power of ten, rounded once.
+  int e = static_cast<int>(std::floor(std::log10(v))); // Decimal exponent (perhaps off by one).
+  double scaled = 0.;
+  for (int tries = 0; ; ++tries)
+  {
+    int scale = digits - 1 - e;
+    if (scale > max_pow10 || scale < -max_pow10 || tries == 2)
+    { // Too big or small to scale exactly, or near a power of ten.
+      return std::snprintf(buf, 32, "%.*g", precision, value);
+    }
+    scaled = (scale >= 0) ? v * pow10[scale] : v / pow10[-scale];
+    if (scaled < pow10[digits - 1])
+    {
+      --e;
+    }
+    else if (scaled >= pow10[digits])
+    {
+      ++e;
+    }
+    else
+    {
+      break;
+    }
+  }
+  double whole = std::floor(scaled);
+  double fraction = scaled - whole; // Exact.
+  double tolerance = scaled * 2.3e-16; // About one ulp: rounding error of scaled is at most half an ulp.
+  if (std::abs(fraction - 0.5) <= tolerance)
+  { // Too near half-way to be sure which way the exact value rounds.
+    return std::snprintf(buf, 32, "%.*g", precision, value);
+  }
+  unsigned long long m = static_cast<unsigned long long>(whole) + (fraction > 0.5 ? 1 : 0);
+  if (m == static_cast<unsigned long long>(pow10[digits]))
+  { // Rounded up to the next power of ten.
+    m /= 10;
+    ++e;
+  }
+
+  char d[max_fast_precision]; // Decimal digits of m.
+  for (int i = digits - 1; i >= 0; --i)
+  {
+    d[i] = static_cast<char>('0' + m % 10);
+    m /= 10;
+  }
+  int nd = digits; // Significant digits, without trailing zeros.
+  while (nd > 1 && d[nd - 1] == '0')
+  {
+    --nd;
+  }
+
+  if (e < -4 || e >= digits)
+  { // Exponential format: 1.23e+09
+    *p++ = d[0];
+    if (nd > 1)
+    {
+      *p++ = '.';
+      for (int i = 1; i < nd; ++i)
+      {
+        *p++ = d[i];
+      }
+    }
+    *p++ = 'e';
+    *p++ = (e < 0) ? '-' : '+';
+    int ae = (e < 0) ? -e : e;
+    if (ae >= 100)
+    {
+      *p++ = static_cast<char>('0' + ae / 100);
+    }
+    *p++ = static_cast<char>('0' + ae / 10 % 10);
+    *p++ = static_cast<char>('0' + ae % 10);
+  }
+  else if (e >= 0)
+  { // Fixed format: 123.4
+    for (int i = 0; i <= e; ++i)
+    {
+      *p++ = d[i];
+    }
+    if (nd > e + 1)
+    {
+      *p++ = '.';
+      for (int i = e + 1; i < nd; ++i)
+      {
+        *p++ = d[i];
+      }
+    }
+  }
+  else
+  { // Fixed format with leading zeros: 0.00123
+    *p++ = '0';
+    *p++ = '.';
+    for (int i = -1; i > e; --i)
+    {
+      *p++ = '0';
+    }
+    for (int i = 0; i < nd; ++i)
+    {
+      *p++ = d[i];
+    }
+  }
+  return static_cast<int>(p - buf);
+} // int format_g(char* buf, double value, int precision)
+
+inline bool parse_g(const char* buf, int n, double& v)
+{ /*! Read the value of a number, for example formatted by @c format_g (or @c %g), or a field of a .csv file.
+      The result is the same as @c std::strtod,
+      but uses exact scaling by a power of ten when the mantissa has 15 or fewer digits (nearly always).
+      \param buf chars of the number (need not be null terminated).
+      \param n Number of chars of the number.
+      \param v Set to the value (as much as @c std::strtod can read, if not all a number).
+      \return @c true if all n chars are a number (including inf or nan), else @c false (for example, "---").
+  */
+  static const double pow10[] =
+  { // All exactly representable as double.
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  const int max_pow10 = 22;
+
+  const char* p = buf;
+  const char* end = buf + n;
+  bool negative = false;
+  if (p != end && (*p == '-' || *p == '+'))
+  {
+    negative = (*p == '-');
+    ++p;
+  }
+  unsigned long long m = 0;
+  int digits = 0;
+  int e = 0;
+  for (; p != end && *p >= '0' && *p <= '9'; ++p, ++digits)
+  {
+    m = m * 10 + static_cast<unsigned>(*p - '0');
+  }
+  if (p != end && *p == '.')
+  {
+    for (++p; p != end && *p >= '0' && *p <= '9'; ++p, ++digits)
+    {
+      m = m * 10 + static_cast<unsigned>(*p - '0');
+      --e;
+    }
+  }
+  if (p != end && (*p == 'e' || *p == 'E') && digits != 0)
+  {
+    ++p;
+    bool negative_exponent = (p != end && *p == '-');
+    if (p != end && (*p == '-' || *p == '+'))
+    {
+      ++p;
+    }
+    if (p == end || *p < '0' || *p > '9')
+    { // No exponent digits, so not a number.
+      p = buf;
+    }
+    int x = 0;
+    for (; p != end && *p >= '0' && *p <= '9' && x < 10000; ++p)
+    {
+      x = x * 10 + (*p - '0');
+    }
+    e += negative_exponent ? -x : x;
+  }
+  if (p != end || digits == 0 || digits > max_fast_precision || e > max_pow10 || e < -max_pow10)
+  { // Not plain digits (inf or nan, or not a number), or too many digits, or too big or small to scale exactly.
+    char s[40];
+    std::string long_s;
+    const char* c = s;
+    if (n >= static_cast<int>(sizeof(s)))
+    {
+      long_s.assign(buf, n);
+      c = long_s.c_str();
+    }
+    else
+    {
+      std::memcpy(s, buf, n);
+      s[n] = '\0';
+    }
+    char* stop;
+    v = std::strtod(c, &stop);
+    return (n != 0) && (stop == c + n);
+  }
+  v = (e >= 0) ? static_cast<double>(m) * pow10[e] : static_cast<double>(m) / pow10[-e]; // Rounded once, so exact.
+  if (negative)
+  {
+    v = -v;
+  }
+  return true;
+} // bool parse_g(const char* buf, int n, double& v)
+
+inline double read_g(const char* buf, int n)
+{ /*! Read back the value of a number formatted by @c format_g (or @c %g), for example to know
+      exactly where a renderer will place a coordinate, see @c parse_g.
+      \param buf chars of the number (need not be null terminated).
+      \param n Number of chars of the number.
+  */
+  double v;
+  parse_g(buf, n, v);
+  return v;
+} // double read_g(const char* buf, int n)
+
+struct coord
+{ /*! \struct boost::svg::detail::coord
+      \brief Wrapper to output a coordinate (or length or width) to a stream using @c format_g, for example:
+      \code os << " cx=\"" << detail::coord(x_) << "\""; \endcode
+      The output is the same as @c os @c << @c x_ (C locale assumed).
+  */
+  explicit coord(double v) : value_(v)
+  {
+  }
+  double value_; //!< Value to output.
+};
+
+inline std::ostream& operator<< (std::ostream& os, const coord& c)
+{ //! Output a coordinate, using the stream precision, as fast @c format_g (unless stream flags or precision need iostream formatting).
+  const std::ios_base::fmtflags special = std::ios_base::floatfield | std::ios_base::showpos
+    | std::ios_base::showpoint | std::ios_base::uppercase;
+  const std::streamsize precision = os.precision();
+  if ((os.flags() & special) == 0 && os.width() == 0 && precision >= 0 && precision <= max_fast_precision)
+  {
+    char buf[32];
+    os.write(buf, format_g(buf, c.value_, static_cast<int>(precision)));
+    return os;
+  }
+  return os << c.value_;
+}
+
+} // namespace detail
+} // namespace svg
+} // namespace boost
+
+#endif // BOOST_SVG_NUMBER_FORMAT_HPP
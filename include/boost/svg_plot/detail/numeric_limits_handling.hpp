@@ -27,10 +27,23 @@
 // using boost::quan::uncun ...
 #include <boost/quan/meas.hpp>
 // using boost::quan Meas;
+#include <boost/svg_plot/detail/value_span.hpp>
+// using boost::svg::value_span;
 
 #include <limits>
   // using std::numeric_limits;
 #include <cmath> // Why?
+#include <cstddef>
+  // using std::size_t;
+#include <cstdint>
+  // using std::uint32_t; std::uint64_t;
+#include <cstring>
+  // using std::memcpy;
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#  include <emmintrin.h>
+#  define BOOST_SVG_HAS_SSE2
+#endif
 
 namespace boost
 {
@@ -125,6 +138,122 @@ inline bool pair_is_limit(std::pair<const Meas, unc<correlated> > a)
     || limit_max(value_of(a.second)) || limit_min(value_of(a.second)) || limit_NaN(value_of(a.second));
 }
 
+// Classify whole arrays of values at once, for adding large data-series.
+// A value is 'at limit' (as @c is_limit) exactly when the top 32 bits of its IEEE 754 representation,
+// without the sign bit, are at least those of the next value above max / margin (whose significand is all ones),
+// so including infinity and NaN. This is a single integer comparison, made for 4 values at once by SSE2.
+constexpr std::uint32_t limit_high_word = 0x7FD00000U; //!< Top 32 bits of the smallest magnitude 'at limit' (for margin 4).
+
+inline unsigned char limit_bit(const double* value)
+{ //! \return 1 if *value is 'at limit' (as @c is_limit), else 0, without any branches.
+  std::uint64_t bits;
+  std::memcpy(&bits, value, sizeof(bits));
+  return static_cast<unsigned char>((static_cast<std::uint32_t>(bits >> 32) & 0x7FFFFFFFU) >= limit_high_word);
+}
+
+/*!
+  Mark the data-points that are 'at limit' in a whole array of values (of 1D or of 2D data-points).
+  \param values Values of n data-points, each of width (1 or 2, X and Y) consecutive values.
+  \param n Number of data-points.
+  \param mask Set to 1 for data-points any of whose values are 'at limit' (as @c is_limit), else left unchanged.
+  \param width Number of values in each data-point.
+  \return @c true if any data-point was marked.
+*/
+inline bool limit_mask(const double* values, std::size_t n, unsigned char* mask, std::size_t width = 1)
+{
+  unsigned char any = 0;
+  std::size_t i = 0;
+#ifdef BOOST_SVG_HAS_SSE2
+  if (width <= 2)
+  { // 16 values at a time, into 16 (width 1) or 8 (width 2) mask bytes.
+    const std::size_t points = 16 / width;
+    const __m128i sign = _mm_set1_epi32(0x7FFFFFFF);
+    const __m128i below = _mm_set1_epi32(static_cast<int>(limit_high_word - 1U));
+    const __m128i one = _mm_set1_epi8(1);
+    __m128i found = _mm_setzero_si128();
+    for (; i + points <= n; i += points)
+    { // Each of high[k] holds the top 32 bits of 4 values, compared as (non-negative) signed ints.
+      const double* v = values + i * width;
+      __m128i high[4];
+      for (int k = 0; k != 4; ++k)
+      {
+        __m128 ab = _mm_shuffle_ps(_mm_castpd_ps(_mm_loadu_pd(v + 4 * k)), _mm_castpd_ps(_mm_loadu_pd(v + 4 * k + 2)), _MM_SHUFFLE(3, 1, 3, 1));
+        high[k] = _mm_cmpgt_epi32(_mm_and_si128(_mm_castps_si128(ab), sign), below);
+      }
+      __m128i m;
+      if (width == 1)
+      {
+        m = _mm_packs_epi16(_mm_packs_epi32(high[0], high[1]), _mm_packs_epi32(high[2], high[3]));
+      }
+      else
+      { // X and Y values are adjacent, so combine each pair.
+        __m128i xy[4];
+        for (int k = 0; k != 4; ++k)
+        {
+          xy[k] = _mm_or_si128(high[k], _mm_srli_epi64(high[k], 32));
+        }
+        __m128i p0 = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(xy[0]), _mm_castsi128_ps(xy[1]), _MM_SHUFFLE(2, 0, 2, 0)));
+        __m128i p1 = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(xy[2]), _mm_castsi128_ps(xy[3]), _MM_SHUFFLE(2, 0, 2, 0)));
+        m = _mm_packs_epi16(_mm_packs_epi32(p0, p1), _mm_setzero_si128());
+      }
+      m = _mm_and_si128(m, one);
+      found = _mm_or_si128(found, m);
+      if (width == 1)
+      {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(mask + i), _mm_or_si128(m, _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask + i))));
+      }
+      else
+      {
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(mask + i), _mm_or_si128(m, _mm_loadl_epi64(reinterpret_cast<const __m128i*>(mask + i))));
+      }
+    }
+    any = static_cast<unsigned char>(_mm_movemask_epi8(_mm_cmpeq_epi8(found, _mm_setzero_si128())) != 0xFFFF);
+  }
+#endif // BOOST_SVG_HAS_SSE2
+  for (; i != n; ++i)
+  { // Remaining data-points, one at a time.
+    unsigned char m = 0;
+    for (std::size_t k = 0; k != width; ++k)
+    {
+      m |= limit_bit(values + i * width + k);
+    }
+    mask[i] |= m;
+    any |= m;
+  }
+  return any != 0;
+} // bool limit_mask
+
+/*!
+  Mark the values that are 'at limit' in part of a view of values.
+  \param values View of values.
+  \param first First value to classify.
+  \param n Number of values to classify.
+  \param mask Set to 1 for values (from first) that are 'at limit' (as @c is_limit), else left unchanged.
+  \return @c true if any value was marked.
+*/
+inline bool limit_mask(const value_span& values, std::size_t first, std::size_t n, unsigned char* mask)
+{
+  if (n == 0)
+  {
+    return false;
+  }
+  const double* p = &*(values.begin() + static_cast<std::ptrdiff_t>(first));
+  if (values.stride() == sizeof(double))
+  { // Contiguous.
+    return limit_mask(p, n, mask);
+  }
+  unsigned char any = 0;
+  for (std::size_t i = 0; i != n; ++i)
+  { // Strided, one at a time.
+    unsigned char m = limit_bit(reinterpret_cast<const double*>(reinterpret_cast<const char*>(p) + i * values.stride()));
+    mask[i] |= m;
+    any |= m;
+  }
+  return any != 0;
+} // bool limit_mask
+
+constexpr std::size_t limit_block = 4096; //!< Data-points classified at a time by @c limit_mask, so that the mask stays in cache.
+
 } // namespace detail
 } // namespace svg
 } // namespace boost
@@ -136,6 +265,8 @@ bool boost::svg::detail::limit_min(double); // true if min, denorm_min or -infin
 bool boost::svg::detail::limit_NaN(double); // true if NaN.
 bool boost::svg::detail::is_limit(double); // max, min, infinity or NaN - not a 'proper' data value.
 bool boost::svg::detail::pair_is_limit(std::pair<double, double>); // x and/or y  not a proper data value.
+bool boost::svg::detail::limit_mask(const double*, std::size_t, unsigned char*, std::size_t); // Mark 'at limit' data-points of an array.
+bool boost::svg::detail::limit_mask(const value_span&, std::size_t, std::size_t, unsigned char*); // Mark 'at limit' values of a view.
 bool boost::svg::detail::pair_is_limit(std::pair<const double, double>); // x and/or y  not a proper data value.
 
 template <bool correlated>
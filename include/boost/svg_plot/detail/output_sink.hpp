@@ -0,0 +1,331 @@
+/*! \file
+    \brief Output sinks to which an SVG document (or plot) can be written directly.
+    \details
+      All elements write their SVG XML to an @c std::ostream, and so to its @c std::streambuf.
+      An @c output_sink is a @c std::streambuf that is also told (by @c svg::write)
+      an estimate of the size of the document before it is written, so that it can be pre-sized.
+      Writing a plot to a @c string_sink appends the bytes straight into a @c std::string,
+      avoiding an @c std::ostringstream and the copy made by its @c str(),
+      and a @c file_sink writes to a file through a (large) buffer supplied by the user.
+      A @c temp_file_sink holds output in a temporary file until it is copied to a stream.
+      An @c ostream_sink passes the output on to any existing @c std::ostream.
+*/
+
+// output_sink.hpp
+
+// Copyright Paul A. Bristow 2020
+
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_SVG_OUTPUT_SINK_HPP
+#define BOOST_SVG_OUTPUT_SINK_HPP
+
+#include <cstddef>
+// using std::size_t;
+#include <cstdio>
+// using std::FILE; std::fopen; std::fwrite; std::fclose; std::ferror; std::tmpfile; std::fread;
+#include <ostream>
+// using std::ostream;
+#include <stdexcept>
+// using std::runtime_error;
+#include <streambuf>
+// using std::streambuf;
+#include <string>
+// using std::string;
+#include <vector>
+// using std::vector;
+
+namespace boost
+{
+namespace svg
+{
+
+class output_sink : public std::streambuf
+{ /*! \class boost::svg::output_sink
+     \brief Base class of targets to which @c svg::write (and plot write) functions can output directly, for example:
+     \code
+       std::string bytes;
+       string_sink sink(bytes);
+       my_plot.write(sink); // bytes now holds the whole SVG XML document.
+     \endcode
+  */
+public:
+  virtual void reserve(std::size_t /* n */)
+  { //! Expect about n more chars to be written (called by @c svg::write with an estimate from the document elements).
+    // Default ignores the estimate.
+  }
+}; // class output_sink
+
+class string_sink : public output_sink
+{ /*! \class boost::svg::string_sink
+     \brief Appends output to a growable @c std::string, either owned by the sink, or by the user.
+  */
+public:
+  string_sink() : str_(&own_)
+  { //! Construct a sink that appends to its own string, see @c str().
+  }
+
+  explicit string_sink(std::string& s) : str_(&s)
+  { //! Construct a sink that appends to string @c s (which must outlive the sink).
+  }
+
+  void reserve(std::size_t n)
+  { //! Reserve space in the string for about n more chars.
+    str_->reserve(str_->size() + n);
+  }
+
+  std::string& str()
+  { //! \return The string to which output is appended.
+    return *str_;
+  }
+
+  const char* data() const
+  { //! \return Pointer to the bytes written.
+    return str_->data();
+  }
+
+  std::size_t size() const
+  { //! \return Number of bytes written.
+    return str_->size();
+  }
+
+protected:
+  int_type overflow(int_type c)
+  { // Called for each single char put.
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+      str_->push_back(traits_type::to_char_type(c));
+    }
+    return traits_type::not_eof(c);
+  }
+
+  std::streamsize xsputn(const char* s, std::streamsize n)
+  { // Called for strings of chars and numbers written by std::ostream::write.
+    str_->append(s, static_cast<std::size_t>(n));
+    return n;
+  }
+
+private:
+  string_sink(const string_sink&); // Not copyable.
+  string_sink& operator=(const string_sink&);
+
+  std::string own_; // Used by default constructor.
+  std::string* str_; // Appended to.
+}; // class string_sink
+
+class file_sink : public output_sink
+{ /*! \class boost::svg::file_sink
+     \brief Writes output to a file, through a buffer, that may be very large,
+     either supplied by the user (and perhaps re-used for many files), or owned by the sink.
+     The buffer is written to the file with a single @c std::fwrite each time it is filled,
+     and when the sink is flushed, closed or destroyed, for example:
+     \code
+       file_sink sink("my_plot.svg");
+       my_plot.write(sink);
+       sink.close(); // Optional: throws if the file could not be completely written.
+     \endcode
+  */
+public:
+  explicit file_sink(const std::string& filename, std::size_t buffer_size = 1024 * 1024)
+    : own_(buffer_size == 0 ? 1 : buffer_size), file_(0), ok_(true)
+  { //! Construct a sink writing to file @c filename, through a buffer of buffer_size bytes owned by the sink.
+    open(filename, own_.data(), own_.size());
+  }
+
+  file_sink(const std::string& filename, char* buffer, std::size_t buffer_size)
+    : file_(0), ok_(true)
+  { //! Construct a sink writing to file @c filename, through a buffer supplied by the user (which must outlive the sink).
+    if (buffer == 0 || buffer_size == 0)
+    {
+      own_.resize(1);
+      buffer = own_.data();
+      buffer_size = 1;
+    }
+    open(filename, buffer, buffer_size);
+  }
+
+  ~file_sink()
+  { //! Destructor writes any buffered output, and closes the file (if not already closed), ignoring any error.
+    try
+    {
+      close();
+    }
+    catch (...)
+    {
+    }
+  }
+
+  void close()
+  { //! Write any buffered output, and close the file, throwing @c std::runtime_error if unable (or if any output was lost).
+    if (file_ == 0)
+    {
+      return;
+    }
+    bool ok = write_buffer() && (std::fflush(file_) == 0) && ok_ && (std::ferror(file_) == 0);
+    ok = (std::fclose(file_) == 0) && ok;
+    file_ = 0;
+    if (!ok)
+    {
+      throw std::runtime_error("Unable to write file.");
+    }
+  }
+
+protected:
+  file_sink(std::FILE* file, std::size_t buffer_size)
+    : own_(buffer_size == 0 ? 1 : buffer_size), file_(file), ok_(true)
+  { //! Construct a sink writing to a file already open (and closed by the sink), through a buffer owned by the sink.
+    if (file_ == 0)
+    {
+      throw std::runtime_error("Unable to open file!");
+    }
+    setp(own_.data(), own_.data() + own_.size());
+  }
+
+  std::FILE* file()
+  { //! \return The file written to.
+    return file_;
+  }
+
+  int_type overflow(int_type c)
+  { // Buffer is full: write it all to the file.
+    if (!write_buffer())
+    {
+      return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  std::streamsize xsputn(const char* s, std::streamsize n)
+  { // Copy into the buffer, or if too big to be buffered, write straight to the file.
+    if (n <= epptr() - pptr())
+    {
+      traits_type::copy(pptr(), s, static_cast<std::size_t>(n));
+      pbump(static_cast<int>(n));
+      return n;
+    }
+    if (!write_buffer())
+    {
+      return 0;
+    }
+    if (n <= epptr() - pptr())
+    {
+      traits_type::copy(pptr(), s, static_cast<std::size_t>(n));
+      pbump(static_cast<int>(n));
+      return n;
+    }
+    std::size_t written = std::fwrite(s, 1, static_cast<std::size_t>(n), file_);
+    ok_ = ok_ && (written == static_cast<std::size_t>(n));
+    return static_cast<std::streamsize>(written);
+  }
+
+  int sync()
+  { // Write the buffer to the file (on flush, or std::endl).
+    return (write_buffer() && std::fflush(file_) == 0) ? 0 : -1;
+  }
+
+private:
+  file_sink(const file_sink&); // Not copyable.
+  file_sink& operator=(const file_sink&);
+
+  void open(const std::string& filename, char* buffer, std::size_t buffer_size)
+  {
+    file_ = std::fopen(filename.c_str(), "wb");
+    if (file_ == 0)
+    {
+      throw std::runtime_error("Unable to open file " + filename);
+    }
+    setp(buffer, buffer + buffer_size);
+  }
+
+  bool write_buffer()
+  { // Write the buffered chars to the file (unless closed), and empty the buffer.
+    std::size_t n = static_cast<std::size_t>(pptr() - pbase());
+    bool ok = (file_ != 0) && ((n == 0) || (std::fwrite(pbase(), 1, n, file_) == n));
+    setp(pbase(), epptr());
+    ok_ = ok_ && ok;
+    return ok;
+  }
+
+  std::vector<char> own_; // Buffer, unless supplied by the user.
+  std::FILE* file_; // Written to, or null when closed.
+  bool ok_; // false if any output could not be written.
+}; // class file_sink
+
+class temp_file_sink : public file_sink
+{ /*! \class boost::svg::temp_file_sink
+     \brief Holds output in a temporary file (removed when the sink is destroyed) until it is copied to a stream,
+     for example, layers of a plot written as they are drawn, but needed only after other layers, see @c svg_2d_plot::streaming_on.
+  */
+public:
+  explicit temp_file_sink(std::size_t buffer_size = 64 * 1024) : file_sink(std::tmpfile(), buffer_size)
+  { //! Construct a sink writing to a new temporary file, through a buffer of buffer_size bytes.
+  }
+
+  void copy_to(std::ostream& os)
+  { //! Write all the output held so far to @c os.
+    if (sync() != 0)
+    {
+      throw std::runtime_error("Unable to write to temporary file!");
+    }
+    std::rewind(file());
+    std::vector<char> buffer(64 * 1024);
+    std::size_t n;
+    while ((n = std::fread(buffer.data(), 1, buffer.size(), file())) > 0)
+    {
+      os.write(buffer.data(), static_cast<std::streamsize>(n));
+    }
+    if (std::ferror(file()) != 0)
+    {
+      throw std::runtime_error("Unable to read temporary file!");
+    }
+    std::fseek(file(), 0, SEEK_END); // Ready for more output.
+  }
+}; // class temp_file_sink
+
+class ostream_sink : public output_sink
+{ /*! \class boost::svg::ostream_sink
+     \brief Passes output on to an existing @c std::ostream (for code written for any @c output_sink).
+  */
+public:
+  explicit ostream_sink(std::ostream& os) : os_(os)
+  { //! Construct a sink writing to stream @c os (which must outlive the sink).
+  }
+
+protected:
+  int_type overflow(int_type c)
+  {
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+      os_.put(traits_type::to_char_type(c));
+    }
+    return os_ ? traits_type::not_eof(c) : traits_type::eof();
+  }
+
+  std::streamsize xsputn(const char* s, std::streamsize n)
+  {
+    os_.write(s, n);
+    return os_ ? n : 0;
+  }
+
+  int sync()
+  {
+    os_.flush();
+    return os_ ? 0 : -1;
+  }
+
+private:
+  std::ostream& os_; // Written to.
+}; // class ostream_sink
+
+} // namespace svg
+} // namespace boost
+
+#endif // BOOST_SVG_OUTPUT_SINK_HPP
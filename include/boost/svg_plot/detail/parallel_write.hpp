@@ -0,0 +1,240 @@
+/*! \file
+    \brief Serialize the layers of an SVG document in parallel, see @c svg::write_threads.
+    \details
+      The document is a fixed set of top-level group layers (background, grids, axes, data lines, data points...).
+      For plots of very many data-points, a few layers (or large groups within them) hold nearly all the elements,
+      so writing them one after another, as @c g_element::write does, is bound by a single core.
+      @c write_parallel splits the document into segments: the opening and closing tags of each group,
+      and runs of its children of roughly equal (estimated) size, recursing into large child groups
+      (elements added to the document itself, rather than to a group, are runs of the document's children).
+      Segments are written by a pool of threads, each into its own buffer,
+      and each buffer is output, in the original order, as soon as all the segments before it have been,
+      so the document is exactly the same.
+      Threads take a new segment only while few are waiting to be output,
+      so (as for @c gzip_sink) the whole document text is never held in memory.
+*/
+
+// parallel_write.hpp
+
+// Copyright Paul A. Bristow 2020
+
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_SVG_PARALLEL_WRITE_HPP
+#define BOOST_SVG_PARALLEL_WRITE_HPP
+
+#include "svg_elements.hpp" // g_element.
+#include "output_sink.hpp" // string_sink.
+
+#include <algorithm>
+// using std::max; std::min;
+#include <condition_variable>
+// using std::condition_variable;
+#include <cstddef>
+// using std::size_t;
+#include <exception>
+// using std::exception_ptr;
+#include <mutex>
+// using std::mutex; std::unique_lock;
+#include <ostream>
+// using std::ostream;
+#include <string>
+// using std::string;
+#include <thread>
+// using std::thread;
+#include <vector>
+// using std::vector;
+
+namespace boost
+{
+namespace svg
+{
+namespace detail
+{
+
+struct write_segment
+{ //! Part of the document written by one task: the opening tag of group g, its children first to last, or its closing tag.
+  enum kind_type { open_tag, children, close_tag };
+  kind_type kind; //!< Which part of the group.
+  g_element* g; //!< Group.
+  std::size_t first; //!< First child (for children).
+  std::size_t last; //!< One past last child (for children).
+  write_segment(kind_type k, g_element* group, std::size_t f = 0, std::size_t l = 0)
+    : kind(k), g(group), first(f), last(l)
+  {
+  }
+};
+
+inline void plan_segments(g_element& g, std::vector<write_segment>& segments, std::size_t chunk);
+
+inline void plan_children(g_element& g, std::size_t first, std::size_t last,
+  std::vector<write_segment>& segments, std::size_t chunk)
+{ //! Split children first to last of group g into runs of about chunk chars (estimated), recursing into child groups bigger than chunk.
+  std::size_t begin = first; // First child not yet in a segment.
+  std::size_t size = 0; // Estimated chars of children begin to i.
+  for (std::size_t i = first; i < last; ++i)
+  {
+    std::size_t n = g[static_cast<unsigned int>(i)].size_estimate();
+    g_element* child = (n >= chunk) ? dynamic_cast<g_element*>(&g[static_cast<unsigned int>(i)]) : 0;
+    if (child != 0)
+    { // Large child group is split too.
+      if (begin < i)
+      {
+        segments.push_back(write_segment(write_segment::children, &g, begin, i));
+      }
+      plan_segments(*child, segments, chunk);
+      begin = i + 1;
+      size = 0;
+    }
+    else if ((size += n) >= chunk)
+    {
+      segments.push_back(write_segment(write_segment::children, &g, begin, i + 1));
+      begin = i + 1;
+      size = 0;
+    }
+  }
+  if (begin < last)
+  {
+    segments.push_back(write_segment(write_segment::children, &g, begin, last));
+  }
+} // void plan_children
+
+inline void plan_segments(g_element& g, std::vector<write_segment>& segments, std::size_t chunk)
+{ //! Split group g into its opening tag, runs of its children (see @c plan_children), and its closing tag.
+  if (g.size() == 0)
+  { // Writes nothing.
+    return;
+  }
+  segments.push_back(write_segment(write_segment::open_tag, &g));
+  plan_children(g, 0, g.size(), segments, chunk);
+  segments.push_back(write_segment(write_segment::close_tag, &g));
+} // void plan_segments
+
+inline void write_parallel(std::ostream& os, g_element& document, unsigned int threads)
+{ /*! Write all the children of document (group layers, and any other elements added to the document itself) to os,
+      using threads threads (including this one), exactly as writing each child in turn.
+  */
+  const std::size_t total = document.size_estimate();
+  const std::size_t chunk = (std::min)((std::max)(total / (threads * 8), static_cast<std::size_t>(64 * 1024)),
+    static_cast<std::size_t>(1024 * 1024)); // Not too big to hold a few for each thread.
+  std::vector<write_segment> segments;
+  for (std::size_t i = 0; i < document.size(); ++i)
+  { // In document order.
+    g_element* layer = dynamic_cast<g_element*>(&document[static_cast<unsigned int>(i)]);
+    if (layer != 0)
+    {
+      plan_segments(*layer, segments, chunk);
+    }
+    else
+    { // Run of (not group) elements added to the document itself, like svg::line.
+      std::size_t last = i + 1;
+      while (last < document.size() && dynamic_cast<g_element*>(&document[static_cast<unsigned int>(last)]) == 0)
+      {
+        ++last;
+      }
+      plan_children(document, i, last, segments, chunk);
+      i = last - 1;
+    }
+  }
+
+  std::vector<std::string> buffers(segments.size());
+  std::vector<char> done(segments.size(), 0); // true if segment is written to its buffer.
+  const std::size_t waiting = 2 * static_cast<std::size_t>(threads); // Most segments taken but not yet output.
+  std::size_t next = 0; // Next segment not yet taken.
+  std::size_t output = 0; // Next segment not yet output to os.
+  bool outputting = false; // true while a thread is outputting buffers to os.
+  std::mutex mutex; // Guards all the above.
+  std::condition_variable can_take; // Signalled as segments are output.
+  std::string unused;
+  string_sink format_sink(unused);
+  std::ostream format(&format_sink); // Format state of os, copied by every thread (os is being written by one).
+  format.copyfmt(os); // Precision and other format state, like svg::compact_paths.
+  std::vector<std::exception_ptr> errors(threads);
+  auto work = [&](unsigned int t)
+  { // Write the next segment not yet taken into its buffer, and output all buffers ready in order, until none left.
+    try
+    {
+      for (;;)
+      {
+        std::size_t i;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          can_take.wait(lock, [&]{ return next >= segments.size() || next < output + waiting; });
+          if (next >= segments.size())
+          {
+            return;
+          }
+          i = next++;
+        }
+        const write_segment& s = segments[i];
+        string_sink sink(buffers[i]);
+        std::ostream out(&sink);
+        out.copyfmt(format);
+        switch (s.kind)
+        {
+        case write_segment::open_tag:
+          s.g->write_open(out);
+          break;
+        case write_segment::children:
+          s.g->write_children(out, s.first, s.last);
+          break;
+        case write_segment::close_tag:
+          s.g->write_close(out);
+          break;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        done[i] = 1;
+        if (outputting)
+        { // The thread outputting will output this segment in turn.
+          continue;
+        }
+        outputting = true;
+        while (output < segments.size() && done[output])
+        { // Output all the buffers ready, in the original order.
+          std::string buffer;
+          buffer.swap(buffers[output]); // Free as soon as output.
+          lock.unlock();
+          os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+          lock.lock();
+          ++output;
+          can_take.notify_all();
+        }
+        outputting = false;
+      }
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      errors[t] = std::current_exception();
+      next = segments.size(); // Stop the others.
+      can_take.notify_all();
+    }
+  };
+  std::vector<std::thread> pool;
+  const std::size_t workers = (std::min)(static_cast<std::size_t>(threads), segments.size()); // Including this thread.
+  for (unsigned int t = 1; t < workers; ++t)
+  {
+    pool.push_back(std::thread(work, t));
+  }
+  work(0);
+  for (std::size_t t = 0; t < pool.size(); ++t)
+  {
+    pool[t].join();
+  }
+  for (unsigned int t = 0; t < threads; ++t)
+  {
+    if (errors[t])
+    {
+      std::rethrow_exception(errors[t]);
+    }
+  }
+} // void write_parallel
+
+} // namespace detail
+} // namespace svg
+} // namespace boost
+
+#endif // BOOST_SVG_PARALLEL_WRITE_HPP
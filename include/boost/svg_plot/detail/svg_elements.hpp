@@ -24,6 +24,8 @@
 
 #include "../svg_style.hpp"
 #include "svg_style_detail.hpp" // 
+#include "element_arena.hpp" // Optional arena for document elements.
+#include "number_format.hpp" // Fast output of coordinates.
 
 #include <ostream>
 // using std::ostream;
@@ -31,6 +33,18 @@
 // using std::string;
 #include <vector>
 // using std::vector;
+#include <algorithm>
+// using std::min;
+#include <cstring>
+// using std::memcpy;
+#include <limits>
+// using std::numeric_limits;
+#include <map>
+// using std::map;
+#include <sstream>
+// using std::ostringstream;
+#include <type_traits>
+// using std::enable_if;
 
 namespace boost
 {
@@ -57,6 +71,8 @@ namespace svg
   class polyline_element; // a set of connected straight line segments.
   class path_element; // d= moveto, lineto...
   class clip_path_element; // Restricts the region to which paint can be applied.
+  class use_element; // Reference to a symbol, drawn at (x, y).
+  class glyphs_element; // The same glyph drawn at many positions, as one text element.
   struct m_path; // moveto coordinates (x, y), outputs "M1.2,3.4"
   struct l_path; // lineto coordinates (x, y).
   struct z_path; // z indicates a closepath.
@@ -72,8 +88,9 @@ namespace svg
   'g' element is a container element, for grouping together related graphics elements, for example:
    <g stroke="rgb(255,0,0)" <rect x="0" y="0"  width="500"  height="600"/> </g>
    */
+  class symbol_element; // Group defined once, and drawn by use_element(s).
 
-  class svg_element
+  class svg_element : public detail::arena_allocated
   { /*! \class boost::svg::svg_element
        \brief @c svg_element is base class for all the leaf elements @c g_element, @c rect_element.. .
        \details derived classes are:
@@ -143,6 +160,11 @@ namespace svg
 
     virtual void write(std::ostream& os) = 0; //!< Write function outputs appropriate SVG commands for a leaf or child element.
 
+    virtual std::size_t size_estimate()
+    { //! \return Rough number of chars that write() will output, used to pre-size an @c output_sink.
+      return 50; // Typical of a single line, circle or data-point marker text (a little more, rather than less).
+    }
+
     virtual ~svg_element()
     { //! Destructor.
     }
@@ -264,8 +286,8 @@ namespace svg
        writing XML SVG command to draw a straight line.
        */
       /* \verbatim Example: <line x1="5" y1="185" x2="340" y2="185"/> \endverbatim */
-      rhs << "\t\t" "<line x1=\"" << x1_ << "\" y1=\"" << y1_
-          << "\" x2=\"" << x2_ << "\" y2=\"" << y2_ << "\"/>" "\n";
+      rhs << "\t\t" "<line x1=\"" << detail::coord(x1_) << "\" y1=\"" << detail::coord(y1_)
+          << "\" x2=\"" << detail::coord(x2_) << "\" y2=\"" << detail::coord(y2_) << "\"/>" "\n";
     }
   }; // class line_element
 
@@ -318,11 +340,11 @@ namespace svg
           \verbatim Example:
           \endverbatim
       */
-      os << "\t<path d=\"M" << x1_ << "," << y1_
-          << " Q" << x2_ << "," << y2_ << " " // Control point - will not pass thru this point.
+      os << "\t<path d=\"M" << detail::coord(x1_) << "," << detail::coord(y1_)
+          << " Q" << detail::coord(x2_) << "," << detail::coord(y2_) << " " // Control point - will not pass thru this point.
           //<< x1_ << "," << y1_ << " "
           //<< x2_ << "," << y2_ << " "
-          << x3_ << "," << y3_
+          << detail::coord(x3_) << "," << detail::coord(y3_)
           <<"\"";
       if(svg_style_.fill_on() == false)
       {
@@ -405,10 +427,10 @@ namespace svg
       */
       os << "\t\t<rect";
       write_attributes(os); // id (& clip_path)
-      os << " x=\"" << x_ << "\""
-        << " y=\"" << y_ << "\""
-        << " width=\"" << width_ << "\""
-        << " height=\"" << height_ << "\"/>"
+      os << " x=\"" << detail::coord(x_) << "\""
+        << " y=\"" << detail::coord(y_) << "\""
+        << " width=\"" << detail::coord(width_) << "\""
+        << " height=\"" << detail::coord(height_) << "\"/>"
         "\n";
     }
   }; // class rect_element
@@ -474,7 +496,7 @@ namespace svg
     */
       os << "\t\t<circle";
       write_attributes(os);
-      os << " cx=\"" << x_ << "\" cy=\"" << y_ << "\" r=\"" << radius_ << "\"/>" "\n";
+      os << " cx=\"" << detail::coord(x_) << "\" cy=\"" << detail::coord(y_) << "\" r=\"" << detail::coord(radius_) << "\"/>" "\n";
     }
   }; // class circle_element
 
@@ -547,14 +569,14 @@ namespace svg
       write_attributes(os);
       if(rotate_ != 0)
       { // Should this be in atttributes?
-        os << " transform= \"" << " rotate=(" << rotate_ << ")\"";
+        os << " transform= \"" << " rotate=(" << detail::coord(rotate_) << ")\"";
       }
-      os << " cx=\"" << cx_ << "\" cy=\"" << cy_ << "\""
-          << " rx=\"" << rx_ << "\" ry=\"" << ry_  << "\"/>" "\n";
+      os << " cx=\"" << detail::coord(cx_) << "\" cy=\"" << detail::coord(cy_) << "\""
+          << " rx=\"" << detail::coord(rx_) << "\" ry=\"" << detail::coord(ry_)  << "\"/>" "\n";
     }
   }; // class ellipse_element
 
-class text_parent
+class text_parent : public detail::arena_allocated
 { /*! \class boost::svg::text_parent
     \brief An ancestor to both tspan and strings for the text_element class.
     \details This allows an array of both types to be stored in @c text_element.
@@ -569,7 +591,7 @@ class text_parent
     { //! Construct from string text.
       //! Used by text_element and tspan_element to store tex to be output.
     }
-    text_parent(const text_parent& rhs): text_(rhs.text_)
+    text_parent(const text_parent& rhs) : detail::arena_allocated(), text_(rhs.text_)
     { //! Copy constructor.
     }
 }; // class text_parent
@@ -907,21 +929,21 @@ public:
     }
     if(dx_!= 0)
     {
-      os << " dx=\"" << dx_ << "\"";
+      os << " dx=\"" << detail::coord(dx_) << "\"";
     }
     if(dy_!= 0)
     {
-      os << " dy=\"" << dy_ << "\"";
+      os << " dy=\"" << detail::coord(dy_) << "\"";
     }
 
     // Now, add all elements that can be tested with the flags.
     if(use_x_ == true)
     {
-      os << " x=\"" << x_ << "\"";
+      os << " x=\"" << detail::coord(x_) << "\"";
     }
     if(use_y_  == true)
     {
-      os << " y=\"" << y_ << "\"";
+      os << " y=\"" << detail::coord(y_) << "\"";
     }
     // https://www.w3.org/TR/SVG11/text.html#FontPropertiesUsedBySVG
     // 10.10 Font selection properties
@@ -956,7 +978,7 @@ public:
       }
       if (text_length_ > 0)
       { // Use estimated text length to expand or compress to the this SVG length.
-        os << " textLength=\"" << text_length_ << "\"";
+        os << " textLength=\"" << detail::coord(text_length_) << "\"";
       }
     }
    // os << ">" << text_ << "</tspan>" "\n";  // The actual text string.
@@ -1025,14 +1047,15 @@ class text_element : public svg_element
 public:
   double x_; //!< Left edge of character.
   double y_; //!< Bottom of Roman capital character.
-  ptr_vector<text_parent> data_; //!< Stores all of the containing text string data.
+  ptr_vector<text_parent, detail::arena_clone_allocator> data_; //!< Stores all of the containing text string data.
+  detail::element_arena* arena_; //!< Arena for text runs, or null to use the heap.
   text_style text_style_; //!< font variants, bold, italic ...
   align_style align_; //!< Alignment: left_align, right_align, center_align.
   int rotate_; //!< Rotation: horizontal, upward, downward, upsidedown...
 
   void generate_text(std::ostream& os)
   { // Output SVG 
-    for(ptr_vector<text_parent>::iterator i = data_.begin(); i != data_.end(); ++i)
+    for(ptr_vector<text_parent, detail::arena_clone_allocator>::iterator i = data_.begin(); i != data_.end(); ++i)
     {
       (*i).write(os);
     }
@@ -1121,13 +1144,13 @@ public:
 
   void text(const std::string& t)
   { //! push_back tspan text-string to write.
-    data_.push_back(new text_element_text(t));
+    data_.push_back(detail::make_element<text_parent, text_element_text>(arena_, t));
   }
 
   tspan_element& tspan(const std::string& t)
   { //! Add text span element (using current text_style text_style_).
     //! data_ in member of text_parent.
-    data_.push_back(new tspan_element(t, text_style_));
+    data_.push_back(detail::make_element<text_parent, tspan_element>(arena_, t, text_style_));
     return *(static_cast<tspan_element*>(&data_[data_.size()-1]));
   }
 
@@ -1135,7 +1158,7 @@ public:
   tspan_element& tspan(const std::string& t, const text_style& textstyle)
   { //! Add text span element (with specified text_style textstyle).
     //! data_ in member of text_parent.
-    data_.push_back(new tspan_element(t, textstyle));
+    data_.push_back(detail::make_element<text_parent, tspan_element>(arena_, t, textstyle));
     return *(static_cast<tspan_element*>(&data_[data_.size()-1]));
   }
 
@@ -1152,19 +1175,32 @@ public:
     align_style align = align_style ::left_align, //!< Alighment of text, left, center or right, default left_align.
     int rotate = static_cast<int>(horizontal)) //!< orientation of text, default horizontal.
     : // Constructor.
+    text_element(0, x, y, text, ts, align, rotate)
+  { //! text_element Default Constructor defines defaults for all class members.
+  }
+
+  text_element(
+    detail::element_arena* arena, //!< Arena for the text runs (used by @c g_element::text), or null for the heap.
+    double x, double y,
+    const std::string text,
+    text_style ts,
+    align_style align,
+    int rotate)
+    : // Constructor.
     x_(x), y_(y), // location.
-    data_(ptr_vector<text_parent>()),
+    data_(ptr_vector<text_parent, detail::arena_clone_allocator>()),
+    arena_(arena),
     text_style_(ts), // Uses copy constructor.
     //size_(size), font_(font), text_style_(textstyle), weight_(weight), stretch_(stretch), decoration_(decoration), text_length_(text_length)
     align_(align),
     rotate_(rotate)
-  { //! text_element Default Constructor defines defaults for all class members.
-    data_.push_back(new text_element_text(text)); // Adds new text string.
+  { //! text_element constructor allocating text runs from an arena.
+    data_.push_back(detail::make_element<text_parent, text_element_text>(arena_, text)); // Adds new text string.
   }
 
   text_element(const text_element& rhs)
   :
-    x_(rhs.x_), y_(rhs.y_), text_style_(rhs.text_style_), align_(rhs.align_), rotate_(rhs.rotate_)
+    x_(rhs.x_), y_(rhs.y_), arena_(0), text_style_(rhs.text_style_), align_(rhs.align_), rotate_(rhs.rotate_)
   { //! Copy constructor.
      data_ = (const_cast<text_element&>(rhs)).data_.release();
   }
@@ -1202,7 +1238,7 @@ public:
    // Example: \verbatim os << " <text x=\"" << x_ << "\" y=\"" << y_ << "\""; \endverbatim
   void write(std::ostream& os)
   {
-    os << "\t\t<text x=\"" << x_ << "\" y=\"" << y_ << "\"";
+    os << "\t\t<text x=\"" << detail::coord(x_) << "\" y=\"" << detail::coord(y_) << "\"";
 
     //! The text-anchor property is used to align (start-, middle- or end-alignment) a string of pre-formatted text or auto-wrapped text
     //! where the wrapping area is determined from the inline-size property relative to a given point.
@@ -1240,8 +1276,8 @@ public:
     { // Only show rotation info if not normal horizontal writing.
       os << " transform=\"rotate("
         << rotate_ << " "
-        << x_ << " "
-        << y_ << ")\"";
+        << detail::coord(x_) << " "
+        << detail::coord(y_) << ")\"";
     }
     // Output any text attributes that are specific to this text string.
     // (If text_style == not_a_text_style then any attributes are output in g_element.
@@ -1275,7 +1311,7 @@ public:
       }
       if (text_style_.text_length() > 0)
       {
-        os << " textLength=\"" << text_style_.text_length() << "\"";
+        os << " textLength=\"" << detail::coord(text_style_.text_length()) << "\"";
       }
     }
     os << ">" ;
@@ -1307,6 +1343,89 @@ public:
     return os;
   } // std::ostream& operator<<
 
+  class glyphs_element : public svg_element
+  { /*! \class boost::svg::glyphs_element
+      \brief The same glyph (a single Unicode symbol) drawn at each of many positions, as one @c <text> element.
+      \details SVG text can have a list of X and Y coordinates, one for each character,
+      so a data-series marked with (say) diamonds is written as
+      \verbatim <text x="12 34 56" y="78 90 12" text-anchor="middle" font-size="10">&#x2666;&#x2666;&#x2666;</text> \endverbatim
+      rather than a @c <text> element with all its attributes for each data-point, see @c svg::markers @c batched_markers.
+      Each positioned character starts a new text chunk, so is aligned (for example, centered) on its own position.
+      \sa https://www.w3.org/TR/SVG11/text.html#TextElementXAttribute
+    */
+  public:
+    static const std::size_t max_size = 1000; //!< Most positions in one element, so that attribute lists are not too long.
+    std::vector<double> xs_; //!< X coordinates of each glyph.
+    std::vector<double> ys_; //!< Y coordinates of each glyph.
+    std::string glyph_; //!< Glyph, for example: "&#x2666;" for a diamond.
+    align_style align_; //!< Alignment of each glyph on its position: left_align, right_align, center_align.
+
+    glyphs_element(const std::string& glyph, const text_style& ts, align_style align)
+      : glyph_(glyph), align_(align)
+    { //! Constructor, with no positions yet (add with @c P).
+      text_style_ = ts;
+    }
+
+    glyphs_element& P(double x, double y)
+    { //! Add another position, at which the glyph is drawn.
+      xs_.push_back(x);
+      ys_.push_back(y);
+      return *this; //! \return glyphs_element& to make chainable.
+    }
+
+    std::size_t size()
+    { //! \return Number of positions.
+      return xs_.size();
+    }
+
+    bool same(const std::string& glyph, const text_style& ts, align_style align) const
+    { //! \return @c true if the glyph, font and alignment are the same as this element's, so a position can be added.
+      return glyph == glyph_ && ts == text_style_ && align == align_;
+    }
+
+    std::size_t size_estimate()
+    { //! \return Rough number of chars that write() will output.
+      return 100 + xs_.size() * (glyph_.size() + 10);
+    }
+
+    void write(std::ostream& os)
+    { //! Output one @c <text> element, with the list of X and Y coordinates, and the glyph for each.
+      if (xs_.empty())
+      {
+        return;
+      }
+      os << "\t\t<text x=\"";
+      for (std::size_t i = 0; i < xs_.size(); ++i)
+      {
+        os << (i == 0 ? "" : " ") << detail::coord(xs_[i]);
+      }
+      os << "\" y=\"";
+      for (std::size_t i = 0; i < ys_.size(); ++i)
+      {
+        os << (i == 0 ? "" : " ") << detail::coord(ys_[i]);
+      }
+      os << "\"";
+      if (align_ == align_style::right_align)
+      {
+        os << " text-anchor=\"end\"";
+      }
+      else if (align_ == align_style::center_align)
+      {
+        os << " text-anchor=\"middle\"";
+      }
+      if (text_style_ != not_a_text_style)
+      { // Otherwise, font attributes are output by the group.
+        text_style_.write(os);
+      }
+      os << ">";
+      for (std::size_t i = 0; i < xs_.size(); ++i)
+      {
+        os << glyph_;
+      }
+      os << "</text>" "\n";
+    } // void write(std::ostream& os)
+  }; // class glyphs_element
+
   class clip_path_element: public svg_element
   {  /*! \class boost::svg::clip_path_element
       \brief The clipping path restricts the region to which paint can be applied.
@@ -1331,6 +1450,39 @@ public:
       }
   }; // class clip_path_element
 
+  class use_element : public svg_element
+  { /*! \class boost::svg::use_element
+      \brief Reference to a @c symbol_element, drawn with its origin at (x, y).
+      \details Used to draw many data-point markers of the same shape as a @c <use> each,
+      rather than all the elements of the marker, see @c svg::markers.
+      The symbol's elements inherit the style of the @c <use>, that is, of its group.
+      \sa https://www.w3.org/TR/SVG11/struct.html#UseElement
+    */
+  public:
+    double x_; //!< X coordinate of symbol origin.
+    double y_; //!< Y coordinate of symbol origin.
+    std::string href_; //!< id of the symbol.
+
+    use_element(double x, double y, const std::string& href)
+      : x_(x), y_(y), href_(href)
+    { //! Constructor defines all data.
+    }
+
+    void write(std::ostream& os)
+    { /*! Output SVG XML to draw the symbol at (x, y), for example:
+        \verbatim <use xlink:href="#m0" x="9.79" y="185"/> \endverbatim
+      */
+      os << "\t\t<use";
+      write_attributes(os);
+      os << " xlink:href=\"#" << href_ << "\" x=\"" << detail::coord(x_) << "\" y=\"" << detail::coord(y_) << "\"/>" "\n";
+    }
+
+    std::size_t size_estimate()
+    { //! \return Rough number of chars that write() will output.
+      return 40;
+    }
+  }; // class use_element
+
   struct path_point
   { /*! \struct boost::svg::path_point
       \brief Base class for m_path, z_path, q_path, h_path, v_path, c_path, s_path.
@@ -1368,7 +1520,7 @@ public:
       { // absolute
         os << "\t\t\tM";
       }
-      os << x << "," << y << " "; // separator changed to comma for clarity when reading XML source.
+      os << detail::coord(x) << "," << detail::coord(y) << " "; // separator changed to comma for clarity when reading XML source.
 
     } // void write(std::ostream& os)
 
@@ -1417,7 +1569,7 @@ public:
       { // Absolute.
         os << "L";
       }
-      os << x << "," << y << " " "\n";
+      os << detail::coord(x) << "," << detail::coord(y) << " " "\n";
     }
 
     l_path(double x, double y, bool relative = false)
@@ -1442,7 +1594,7 @@ public:
       { // Absolute.
         os << "H";
       }
-      os << x << " ";
+      os << detail::coord(x) << " ";
     }
 
     h_path(double x, bool relative = false)
@@ -1467,7 +1619,7 @@ public:
       { // Absolute.
         os << "V";
       }
-      os << y << " ";
+      os << detail::coord(y) << " ";
     }
 
     v_path(double y, bool relative = false)
@@ -1499,8 +1651,8 @@ public:
       { // Absolute.
         os<<"C";
       }
-      os << x1 << "," << y1 << " " << x2 << "," << y2 << " "
-        << x << "," << y << " ";
+      os << detail::coord(x1) << "," << detail::coord(y1) << " " << detail::coord(x2) << "," << detail::coord(y2) << " "
+        << detail::coord(x) << "," << detail::coord(y) << " ";
     } // void write(ostream&)
 
     c_path(double x1, double y1, double x2, double y2,
@@ -1530,7 +1682,7 @@ public:
       { // Absolute.
         os << "Q";
       }
-      os << x1 << " " << y1 << " " << x << " " << y << " ";
+      os << detail::coord(x1) << " " << detail::coord(y1) << " " << detail::coord(x) << " " << detail::coord(y) << " ";
     }
 
     q_path(double x1, double y1, double x, double y, bool relative = false)
@@ -1559,8 +1711,8 @@ public:
       { // Absolute.
         os << "S";
       }
-      os << x1 << "," << y1 << " "
-        << x << "," << y << " ";
+      os << detail::coord(x1) << "," << detail::coord(y1) << " "
+        << detail::coord(x) << "," << detail::coord(y) << " ";
     }
 
     s_path(double x1, double y1, double x, double y, bool relative = false)
@@ -1587,7 +1739,7 @@ public:
       { // Absolute.
         os << "T";
       }
-      os << x << "," << y << " ";
+      os << detail::coord(x) << "," << detail::coord(y) << " ";
     }
 
     t_path(double x, double y, bool relative = false)
@@ -1621,9 +1773,9 @@ public:
       { // Absolute.
         os << "A";
       }
-      os << rx << "," << ry << " " << x_axis_rotation
+      os << detail::coord(rx) << "," << detail::coord(ry) << " " << detail::coord(x_axis_rotation)
         << ((large_arc) ? 1 : 0) << "," << ((sweep) ? 1 : 0) << " "
-        << x << "," << y << " ";
+        << detail::coord(x) << "," << detail::coord(y) << " ";
     }
 
     //! Construct elliptic arc path.
@@ -1633,6 +1785,260 @@ public:
     }
   }; // struct a_path
 
+  namespace detail
+  {
+    inline int compact_paths_index()
+    { //! \return Index of the @c std::ostream::iword that is non-zero if path data are to be written compactly, see @c svg::compact_paths.
+      static const int index = std::ios_base::xalloc();
+      return index;
+    }
+
+    class compact_path_writer
+    { /*! \class boost::svg::detail::compact_path_writer
+        \brief Writes path data as briefly as possible, for the same path, see @c svg::compact_paths.
+        \details Keeps the current point, as a renderer will read it back from the rounded path data,
+        so that each absolute line-to can be written instead as relative @c l,
+        or horizontal or vertical @c H @c h @c V @c v, whichever is shortest,
+        and omits command letters that SVG implies from the previous command.
+      */
+    public:
+      explicit compact_path_writer(std::ostream& os)
+        : os_(os), precision_(static_cast<int>(os.precision())), last_('\0'),
+        x_(0.), y_(0.), start_x_(0.), start_y_(0.), n_(0)
+      {
+      }
+
+      ~compact_path_writer()
+      {
+        flush();
+      }
+
+      void line_to(double x, double y)
+      { //! Absolute line-to (x, y), written as L, l, H, h, V or v.
+        char ax[32], ay[32], dx[32], dy[32];
+        int nax = number(ax, x);
+        int nay = number(ay, y);
+        double rx = read_g(ax, nax);
+        double ry = read_g(ay, nay);
+        if (near(ry, y_))
+        { // Horizontal (or zero length).
+          horizontal_to(ax, nax, rx);
+          return;
+        }
+        if (near(rx, x_))
+        {
+          vertical_to(ay, nay, ry);
+          return;
+        }
+        int ndx = number(dx, rx - x_);
+        int ndy = number(dy, ry - y_);
+        if (near(x_ + read_g(dx, ndx), rx) && near(y_ + read_g(dy, ndy), ry)
+          && cost('l', dx) + ndx + separator(dy) + ndy < cost('L', ax) + nax + separator(ay) + nay)
+        {
+          put('l', dx, ndx, dy, ndy);
+        }
+        else
+        {
+          put('L', ax, nax, ay, nay);
+        }
+        x_ = rx;
+        y_ = ry;
+      }
+
+      void horizontal_to(double x)
+      { //! Absolute horizontal line-to x, written as H or h.
+        char ax[32];
+        int nax = number(ax, x);
+        horizontal_to(ax, nax, read_g(ax, nax));
+      }
+
+      void vertical_to(double y)
+      { //! Absolute vertical line-to y, written as V or v.
+        char ay[32];
+        int nay = number(ay, y);
+        vertical_to(ay, nay, read_g(ay, nay));
+      }
+
+      void command(char op, const double* p, int count)
+      { //! Any other command op with its count coordinates p, written as they are, except for an implied command letter.
+        char buf[6 * 33];
+        char* b = buf;
+        double last[2] = {0., 0.}; // Last pair of coordinates (as read back).
+        for (int i = 0; i < count; ++i)
+        {
+          char s[32];
+          int n = number(s, p[i]);
+          if (i > 0 && *s != '-')
+          { // Comma within a pair, space between pairs.
+            *b++ = (i % 2 == 1) ? ',' : ' ';
+          }
+          std::memcpy(b, s, n);
+          last[i % 2] = read_g(s, n);
+          b += n;
+        }
+        if (op == 'l' && (last[0] == 0. || last[1] == 0.))
+        { // Relative line-to that is vertical or horizontal.
+          op = (last[1] == 0.) ? 'h' : 'v';
+          b = buf + number(buf, (op == 'h') ? p[0] : p[1]);
+          last[0] = (op == 'h') ? last[0] : last[1];
+        }
+        emit(op, buf, static_cast<int>(b - buf));
+        switch (op)
+        {
+        case 'M':
+        case 'L':
+        case 'C':
+        case 'Q':
+        case 'S':
+        case 'T':
+          x_ = last[0];
+          y_ = last[1];
+          break;
+        case 'H':
+          x_ = last[0];
+          break;
+        case 'V':
+          y_ = last[0];
+          break;
+        case 'h':
+          x_ += last[0];
+          break;
+        case 'v':
+          y_ += last[0];
+          break;
+        case 'Z':
+          x_ = start_x_;
+          y_ = start_y_;
+          break;
+        default: // m, l, c, q, s & t.
+          x_ += last[0];
+          y_ += last[1];
+          break;
+        }
+        if (op == 'M' || op == 'm')
+        { // Start of a new sub-path, to which Z returns.
+          start_x_ = x_;
+          start_y_ = y_;
+        }
+      }
+
+      void flush()
+      { //! Write all buffered path data to the stream.
+        os_.write(buf_, n_);
+        n_ = 0;
+      }
+
+    private:
+      int number(char* s, double v)
+      { // Format v into s, as os_ << v would.
+        if (precision_ >= 0 && precision_ <= max_fast_precision)
+        {
+          return format_g(s, v, precision_);
+        }
+        return std::snprintf(s, 32, "%.*g", precision_, v);
+      }
+
+      static bool near(double a, double b)
+      { // Same value, within rounding in reading back and adding.
+        return std::abs(a - b) <= 4 * std::numeric_limits<double>::epsilon() * (std::max)(std::abs(a), std::abs(b));
+      }
+
+      static int separator(const char* s)
+      { // Chars needed to separate a number s from a previous number.
+        return (*s == '-') ? 0 : 1;
+      }
+
+      bool implied(char op) const
+      { // SVG allows a command letter to be omitted if the same as the previous,
+        // or line-to after move-to, except for move-to itself.
+        return (op == last_ && op != 'M' && op != 'm' && op != 'Z')
+          || (op == 'L' && last_ == 'M') || (op == 'l' && last_ == 'm');
+      }
+
+      int cost(char op, const char* s) const
+      { // Chars needed for command letter (or separator) before the first number s.
+        return implied(op) ? separator(s) : 1;
+      }
+
+      void horizontal_to(const char* ax, int nax, double rx)
+      {
+        char dx[32];
+        int ndx = number(dx, rx - x_);
+        if (near(x_ + read_g(dx, ndx), rx) && cost('h', dx) + ndx < cost('H', ax) + nax)
+        {
+          put('h', dx, ndx);
+        }
+        else
+        {
+          put('H', ax, nax);
+        }
+        x_ = rx;
+      }
+
+      void vertical_to(const char* ay, int nay, double ry)
+      {
+        char dy[32];
+        int ndy = number(dy, ry - y_);
+        if (near(y_ + read_g(dy, ndy), ry) && cost('v', dy) + ndy < cost('V', ay) + nay)
+        {
+          put('v', dy, ndy);
+        }
+        else
+        {
+          put('V', ay, nay);
+        }
+        y_ = ry;
+      }
+
+      void put(char op, const char* a, int na)
+      {
+        emit(op, a, na);
+      }
+
+      void put(char op, const char* a, int na, const char* b, int nb)
+      {
+        char buf[66];
+        std::memcpy(buf, a, na);
+        int n = na;
+        if (*b != '-')
+        {
+          buf[n++] = ',';
+        }
+        std::memcpy(buf + n, b, nb);
+        emit(op, buf, n + nb);
+      }
+
+      void emit(char op, const char* s, int n)
+      { // Command letter op (or just a separator if implied), then its numbers s.
+        if (n_ + n + 2 > sizeof(buf_))
+        {
+          flush();
+        }
+        if (!implied(op))
+        {
+          buf_[n_++] = op;
+        }
+        else if (*s != '-')
+        {
+          buf_[n_++] = ' ';
+        }
+        std::memcpy(buf_ + n_, s, n);
+        n_ += n;
+        last_ = op;
+      }
+
+      std::ostream& os_;
+      int precision_; // Of os_.
+      char last_; // Last command letter, written or implied.
+      double x_; // Current point, X.
+      double y_; // Current point, Y.
+      double start_x_; // Start of sub-path, X.
+      double start_y_; // Start of sub-path, Y.
+      char buf_[4096]; // Path data waiting to be written to os_.
+      std::size_t n_; // Chars in buf_.
+    }; // class compact_path_writer
+  } // namespace detail
+
   class path_element: public svg_element
   {  /*! \class boost::svg::path_element
      \brief Path element holds places on a path used by move, line ...
@@ -1647,12 +2053,17 @@ public:
   public:
     // bool fill; now inherited from parent svg class.
 
-    ptr_vector<path_point> path; //!< All the (x, y) coordinate pairs,
+    // Commands are stored compactly as struct-of-arrays (rather than one heap-allocated
+    // path_point object each), so that a path with a million points costs
+    // only one byte for the command letter and two doubles for the (x, y) coordinates.
+    std::vector<char> ops_; //!< SVG path command letters, M, m, L, l, H, h, V, v, C, c, Q, q, S, s, T, t or Z, in order.
+    std::vector<double> coords_; //!< All the coordinates of all the commands, in order,
     //!< filled by repeated chained calls of functions m, M, l , L... that are push_backed.
+    //!< (Two for M, L, T, one for H, V, four for Q, S, six for C, none for Z).
 
     path_element(const path_element& rhs)
+      : svg_element(rhs), ops_(rhs.ops_), coords_(rhs.coords_)
     { //! Copy constructor.
-      path = (const_cast<path_element&>(rhs)).path.release();
     }
 
     path_element(const svg_style& style_info,
@@ -1679,28 +2090,44 @@ public:
     { //! \return area fill, on or off.
       return svg_style_.fill_on();
     }
+
+    path_element& reserve(std::size_t n)
+    { //! Reserve space for n commands (of two coordinates each, like M or L), to avoid re-allocation for long paths.
+      ops_.reserve(n);
+      coords_.reserve(2 * n);
+      return *this; //! \return path_element& to make chainable.
+    }
+
+    std::size_t size() const
+    { //! \return Number of path commands.
+      return ops_.size();
+    }
+
+    std::size_t size_estimate()
+    { //! \return Rough number of chars that write() will output, about 14 per command.
+      return 50 + 14 * ops_.size();
+    }
+
     // Note 1: return of path_element& permits chaining calls like
     // my_path.M(3, 3).l(150, 150).l(200, 200)...;
 
     // Note 2: By convention:
-    // lower case (like m call m_path(x, y, true) for relative,
-    // but upper case (like M) calls m_path(x, y, false) for absolute.
+    // lower case (like m) is relative,
+    // but upper case (like M) is absolute.
 
     path_element& m(double x, double y)
     { //! Move relative by x and y.
-      path.push_back(new m_path(x, y, true));
-      return *this; //! \return path_element& to make chainable.
+      return command('m', x, y); //! \return path_element& to make chainable.
     }
 
     path_element& M(double x, double y)
     { //! Move to absolute x and y.
-      path.push_back(new m_path(x, y, false));
-      return *this; //! \return path_element& to make chainable.
+      return command('M', x, y); //! \return path_element& to make chainable.
     }
 
     path_element& z()
     { //! Path end. Note lower case z, see path_element& Z() below.
-      path.push_back(new z_path());
+      ops_.push_back('Z');
       return *this; //! \return path_element& to make chainable.
     }
 
@@ -1708,106 +2135,152 @@ public:
     { //! Path end. Note Upper case Z also provided for compatibility with
       //! http://www.w3.org/TR/SVG/paths.html#PathDataClosePathCommand 8.3.3 
       //! which allows either case.
-      path.push_back(new z_path());
+      ops_.push_back('Z');
       return *this; //! \return path_element& to make chainable.
     }
 
     path_element& l(double x, double y)
     { //! Line to (relative).
-      path.push_back(new l_path(x, y, true));
-      return *this; //! \return path_element& to make chainable.
+      return command('l', x, y); //! \return path_element& to make chainable.
     }
 
     path_element& L(double x, double y)
     { //! Line to (absolute).
-      path.push_back(new l_path(x, y, false));
-      return *this; //! \return path_element& to make chainable.
+      return command('L', x, y); //! \return path_element& to make chainable.
     }
 
     path_element& h(double x)
     { //! Line horizontal (relative).
-      path.push_back(new h_path(x, true));
+      ops_.push_back('h');
+      coords_.push_back(x);
       return *this; //! \return path_element& to make chainable.
     }
 
     path_element& H(double x)
     { //! Line horizontal (absolute).
-      path.push_back(new h_path(x, false));
+      ops_.push_back('H');
+      coords_.push_back(x);
       return *this; //! \return path_element& to make chainable.
     }
 
     path_element& v(double y)
     { //! Line vertical (relative).
-      path.push_back(new v_path(y, true));
+      ops_.push_back('v');
+      coords_.push_back(y);
       return *this; //! \return path_element& to make chainable.
     }
 
     path_element& V(double y)
     {//! Line vertical (absolute).
-      path.push_back(new v_path(y, false));
+      ops_.push_back('V');
+      coords_.push_back(y);
       return *this; //! \return path_element& to make chainable.
     }
 
     path_element& c(double x1, double y1, double x2, double y2, double x, double y)
     { //! Draws a cubic Bezier curve from the current point to (x,y) using (x1,y1).(relative).
-      path.push_back(new c_path(x1, y1, x2, y2, x, y, true));
-      return *this; //! \return path_element& to make chainable.
+      return command('c', x1, y1, x2, y2).command(x, y); //! \return path_element& to make chainable.
     }
 
     path_element& C(double x1, double y1, double x2, double y2, double x, double y)
     { //! Draws a cubic Bezier curve from the current point to (x,y) using (x1,y1).(absolute).
-      path.push_back(new c_path(x1, y1, x2, y2, x, y, false));
-      return *this; //! \return path_element& to make chainable.
+      return command('C', x1, y1, x2, y2).command(x, y); //! \return path_element& to make chainable.
     }
 
     path_element& q(double x1, double y1, double x, double y)
     {  //! Quadratic Curve Bezier (relative).
-      path.push_back(new q_path(x1, y1, x, y, true));
-      return *this; //! \return path_element& to make chainable.
+      return command('q', x1, y1, x, y); //! \return path_element& to make chainable.
     }
 
     path_element& Q(double x1, double y1, double x, double y)
     { //! Quadratic Curve Bezier (absolute).
-      path.push_back(new q_path(x1, y1, x, y, false));
-      return *this; //! \return path_element& to make chainable.
+      return command('Q', x1, y1, x, y); //! \return path_element& to make chainable.
     }
 
     path_element& s(double x1, double y1, double x, double y)
     { //! Draws a cubic Bezier curve from the current point to (x,y) (relative).
-      path.push_back(new s_path(x1, y1, x, y, true));
-      return *this; //! \return path_element& to make chainable.
+      return command('s', x1, y1, x, y); //! \return path_element& to make chainable.
     }
 
     path_element& S(double x1, double y1, double x, double y)
     { //! Draws a cubic Bezier curve from the current point to (x,y) (absolute).
-      path.push_back(new s_path(x1, y1, x, y, false));
-      return *this; //! \return path_element& to make chainable.
+      return command('S', x1, y1, x, y); //! \return path_element& to make chainable.
     }
 
     path_element& t(double x, double y)
     { //! Draws a quadratic Bezier curve from the current point to (x,y)(relative).
-      path.push_back(new t_path(x, y, true));
-      return *this; //! \return path_element& to make chainable.
+      return command('t', x, y); //! \return path_element& to make chainable.
     }
 
     path_element& T(double x, double y)
     { //! Draws a quadratic Bezier curve from the current point to (x,y)(absolute).
-      path.push_back(new t_path(x, y, false));
-      return *this; //! \return path_element& to make chainable.
+      return command('T', x, y); //! \return path_element& to make chainable.
     }
 
     void write(std::ostream& os)
     { //! Write a SVG path command to an @c std::ostream.
       //! Example: \verbatim <path d="M5,175 L5,195 M148.571,175" /> \endverbatim
-      if (path.begin() != path.end() )
+      if (!ops_.empty())
       { // Is some path info (trying to avoid useless <path d=""/>"
         // TODO or would this omit useful style & attributes?
-        os << "\t\t" "<path d=\"\n";
-        for(ptr_vector<path_point>::iterator i = path.begin(); i != path.end(); ++i)
+        if (os.iword(detail::compact_paths_index()) != 0)
+        { // svg::compact_paths(true).
+          os << "\t\t" "<path d=\"";
+          write_compact(os);
+          os << "\"";
+        }
+        else
         {
-          (*i).write(os); // M1,2
+          os << "\t\t" "<path d=\"\n";
+          const double* p = coords_.data(); // Next coordinate.
+          for (std::size_t i = 0; i < ops_.size(); ++i)
+          {
+            const char op = ops_[i];
+            switch (op)
+            {
+            case 'M': // Absolute moveto starts a new line, for example: "M52.8571,180 "
+              os << "\t\t\tM" << detail::coord(p[0]) << "," << detail::coord(p[1]) << " "; // separator comma for clarity when reading XML source.
+              p += 2;
+              break;
+            case 'L':
+            case 'l': // Line to, one per line.
+              os << op << detail::coord(p[0]) << "," << detail::coord(p[1]) << " " "\n";
+              p += 2;
+              break;
+            case 'H':
+            case 'h':
+            case 'V':
+            case 'v':
+              os << op << detail::coord(p[0]) << " ";
+              p += 1;
+              break;
+            case 'C':
+            case 'c':
+              os << op << detail::coord(p[0]) << "," << detail::coord(p[1]) << " " << detail::coord(p[2]) << "," << detail::coord(p[3]) << " "
+                << detail::coord(p[4]) << "," << detail::coord(p[5]) << " ";
+              p += 6;
+              break;
+            case 'Q':
+            case 'q': // Space separated.
+              os << op << detail::coord(p[0]) << " " << detail::coord(p[1]) << " " << detail::coord(p[2]) << " " << detail::coord(p[3]) << " ";
+              p += 4;
+              break;
+            case 'S':
+            case 's':
+              os << op << detail::coord(p[0]) << "," << detail::coord(p[1]) << " " << detail::coord(p[2]) << "," << detail::coord(p[3]) << " ";
+              p += 4;
+              break;
+            case 'Z':
+              os << "Z";
+              break;
+            default: // m, T & t.
+              os << op << detail::coord(p[0]) << "," << detail::coord(p[1]) << " ";
+              p += 2;
+              break;
+            }
+          }
+          os << "\t\t\t\"";
         }
-        os << "\t\t\t\"";
 
         write_attributes(os); // id & clip_path.
         svg_style_.write(os); // fill, stroke, width...
@@ -1822,6 +2295,58 @@ public:
         os<<"/>" "\n"; // closing to match <path d=
       }
     } // void write(std::ostream& os)
+
+  private:
+    void write_compact(std::ostream& os)
+    { // Write the path data as briefly as possible, for the same path.
+      detail::compact_path_writer w(os);
+      const double* p = coords_.data(); // Next coordinate.
+      for (std::size_t i = 0; i < ops_.size(); ++i)
+      {
+        const char op = ops_[i];
+        switch (op)
+        {
+        case 'L':
+          w.line_to(p[0], p[1]);
+          p += 2;
+          break;
+        case 'H':
+          w.horizontal_to(p[0]);
+          p += 1;
+          break;
+        case 'V':
+          w.vertical_to(p[0]);
+          p += 1;
+          break;
+        default:
+          {
+            const int count = (op == 'Z') ? 0 : (op == 'h' || op == 'v') ? 1
+              : (op == 'C' || op == 'c') ? 6 : (op == 'Q' || op == 'q' || op == 'S' || op == 's') ? 4 : 2;
+            w.command(op, p, count);
+            p += count;
+          }
+          break;
+        }
+      }
+    } // void write_compact(std::ostream& os)
+
+    path_element& command(char op, double x, double y)
+    { // Append command op with coordinates (x, y).
+      ops_.push_back(op);
+      return command(x, y);
+    }
+
+    path_element& command(double x, double y)
+    { // Append (more) coordinates (x, y) to the last command.
+      coords_.push_back(x);
+      coords_.push_back(y);
+      return *this;
+    }
+
+    path_element& command(char op, double x1, double y1, double x, double y)
+    { // Append command op with coordinates (x1, y1) and (x, y).
+      return command(op, x1, y1).command(x, y);
+    }
   }; // class path_element
 
   struct poly_path_point
@@ -1840,7 +2365,7 @@ public:
       //! Example: " 250,180"
       //! Leading space is redundant for 1st after "points= ",
       //! but others are separators, and arkward to know which is 1st.
-      os << " " << x << "," << y; // x, y separator comma for clarity.
+      os << " " << detail::coord(x) << "," << detail::coord(y); // x, y separator comma for clarity.
     } // void write(std::ostream& os)
 
     poly_path_point(double x, double y)
@@ -1863,6 +2388,31 @@ public:
     return os;
   } // std::ostream& operator<<
 
+  namespace detail
+  {
+    inline void append_points(std::vector<poly_path_point>& points, const double* xs, const double* ys, std::size_t n)
+    { //! Append n points (xs[i], ys[i]) to points with a single (re-)allocation.
+      points.reserve(points.size() + n);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        points.push_back(poly_path_point(xs[i], ys[i]));
+      }
+    }
+
+    template <class XRange, class YRange>
+    void append_points(std::vector<poly_path_point>& points, const XRange& xs, const YRange& ys)
+    { //! Append points from two ranges of X and Y coordinates (up to the length of the shorter).
+      typename XRange::const_iterator x = xs.begin();
+      typename YRange::const_iterator y = ys.begin();
+      std::size_t n = (std::min)(static_cast<std::size_t>(xs.size()), static_cast<std::size_t>(ys.size()));
+      points.reserve(points.size() + n);
+      for (std::size_t i = 0; i < n; ++i, ++x, ++y)
+      {
+        points.push_back(poly_path_point(*x, *y));
+      }
+    }
+  } // namespace detail
+
   class polygon_element: public svg_element
   {  /*! \struct boost::svg::polygon_element
      \brief The 'polygon' element defines a closed shape
@@ -1878,15 +2428,13 @@ public:
     friend std::ostream& operator<< (std::ostream&, polygon_element&);
 
   public: //temporary for experimental gil
-    //using boost::ptr_vector;
-    ptr_vector<poly_path_point> poly_points; //!< All the x, y coordinate pairs,
-    //!< push_backed by calls of p_path(x, y).
+    std::vector<poly_path_point> poly_points; //!< All the x, y coordinate pairs, stored contiguously by value,
+    //!< push_backed by calls of P(x, y).
     bool fill; //!< polygon to have fill color.
 
     polygon_element(const polygon_element& rhs)
+      : svg_element(rhs), poly_points(rhs.poly_points), fill(rhs.fill)
     { //! Copy constructor.
-      poly_points = (const_cast<polygon_element&>(rhs)).poly_points.release();
-      // 'empty' the vector of points.
     }
 
     polygon_element() : fill(true)
@@ -1896,37 +2444,37 @@ public:
     polygon_element (double x, double y, bool f = true) : fill(f)
     { //! Constructor - One absolute (x, y) point only.
       //! Can add more path points using member function P.
-      poly_points.push_back(new poly_path_point(x, y));
+      poly_points.push_back(poly_path_point(x, y));
     }
 
     polygon_element (double x1, double y1, double x2, double y2, double x3, double y3, bool f = true)
       :
       fill(f)
     { //! Constructor - Absolute (x, y) only. Used by triangle.
-      poly_points.push_back(new poly_path_point(x1, y1));
-      poly_points.push_back(new poly_path_point(x2, y2));
-      poly_points.push_back(new poly_path_point(x3, y3));
+      poly_points.push_back(poly_path_point(x1, y1));
+      poly_points.push_back(poly_path_point(x2, y2));
+      poly_points.push_back(poly_path_point(x3, y3));
     }
 
     polygon_element (double x1, double y1, double x2, double y2, double x3, double y3, double x4, double y4, bool f = true)
       :
       fill(f)
     { //! Constructor - Absolute (x, y) only. Used by rhombus.
-      poly_points.push_back(new poly_path_point(x1, y1));
-      poly_points.push_back(new poly_path_point(x2, y2));
-      poly_points.push_back(new poly_path_point(x3, y3));
-      poly_points.push_back(new poly_path_point(x4, y4));
+      poly_points.push_back(poly_path_point(x1, y1));
+      poly_points.push_back(poly_path_point(x2, y2));
+      poly_points.push_back(poly_path_point(x3, y3));
+      poly_points.push_back(poly_path_point(x4, y4));
     }
 
     polygon_element (double x1, double y1, double x2, double y2, double x3, double y3, double x4, double y4, double x5, double y5, bool f = true)
       :
       fill(f)
     { //! Constructor - Absolute (x, y) only. Used by pentagon.
-      poly_points.push_back(new poly_path_point(x1, y1));
-      poly_points.push_back(new poly_path_point(x2, y2));
-      poly_points.push_back(new poly_path_point(x3, y3));
-      poly_points.push_back(new poly_path_point(x4, y4));
-      poly_points.push_back(new poly_path_point(x5, y5));
+      poly_points.push_back(poly_path_point(x1, y1));
+      poly_points.push_back(poly_path_point(x2, y2));
+      poly_points.push_back(poly_path_point(x3, y3));
+      poly_points.push_back(poly_path_point(x4, y4));
+      poly_points.push_back(poly_path_point(x5, y5));
     }
 
     polygon_element (double x1, double y1, double x2, double y2, double x3, double y3, double x4, double y4, double x5, double y5, double x6, double y6, bool f = true)
@@ -1934,24 +2482,19 @@ public:
       fill(f)
     { //! Constructor - Six absolute (x, y) only. Used by hexagon.
       // Might be done more efficiently with fixed size boost::array?
-      poly_points.push_back(new poly_path_point(x1, y1));
-      poly_points.push_back(new poly_path_point(x2, y2));
-      poly_points.push_back(new poly_path_point(x3, y3));
-      poly_points.push_back(new poly_path_point(x4, y4));
-      poly_points.push_back(new poly_path_point(x5, y5));
-      poly_points.push_back(new poly_path_point(x6, y6));
+      poly_points.push_back(poly_path_point(x1, y1));
+      poly_points.push_back(poly_path_point(x2, y2));
+      poly_points.push_back(poly_path_point(x3, y3));
+      poly_points.push_back(poly_path_point(x4, y4));
+      poly_points.push_back(poly_path_point(x5, y5));
+      poly_points.push_back(poly_path_point(x6, y6));
     }
 
-    polygon_element (std::vector<poly_path_point>& points, bool f = true)
+    polygon_element (const std::vector<poly_path_point>& points, bool f = true)
       :
+      poly_points(points), // One allocation for all the points.
       fill(f)
     { //! Constructor from vector of path points.
-      poly_points.reserve(points.size()); // Since we know how many will be pushed.
-      for(std::vector<poly_path_point>::iterator i = points.begin(); i != points.end(); ++i)
-      {
-        poly_path_point p = (*i);
-        poly_points.push_back(new poly_path_point(p.x, p.y));
-      }
     }
 /*
 //! Add a polygon from a fixed length @c boost::array
@@ -1966,7 +2509,7 @@ public:
       for(array<const poly_path_point, n>::iterator i = points.begin(); i != points.end(); ++i)
       {
         poly_path_point p = (*i);
-        poly_points.push_back(new poly_path_point(p.x, p.y));
+        poly_points.push_back(poly_path_point(p.x, p.y));
       }
     }
 
@@ -1981,17 +2524,44 @@ public:
       for(array<poly_path_point, n>::iterator i = points.begin(); i != points.end(); ++i)
       {
         poly_path_point p = (*i);
-        poly_points.push_back(new poly_path_point(p.x, p.y));
+        poly_points.push_back(poly_path_point(p.x, p.y));
       }
     }
 */
     // Member function to add more points to polygon.
     polygon_element& P(double x, double y)
     { //! Add another point (x, y) - absolute only.
-      poly_points.push_back(new poly_path_point(x, y));
+      poly_points.push_back(poly_path_point(x, y));
+      return *this; //! \return polygon_element& to make chainable.
+    }
+
+    polygon_element& P(const double* xs, const double* ys, std::size_t n)
+    { //! Add n more points from arrays of X and Y SVG coordinates - absolute only.
+      detail::append_points(poly_points, xs, ys, n);
+      return *this; //! \return polygon_element& to make chainable.
+    }
+
+    template <class XRange, class YRange>
+    typename std::enable_if<!std::is_arithmetic<XRange>::value, polygon_element&>::type
+    P(const XRange& xs, const YRange& ys)
+    { /*! Add more points from two ranges (for example, @c std::vector<double>, @c std::array or @c std::span)
+        of X and Y SVG coordinates - absolute only. Extra values in the longer range are ignored.
+      */
+      detail::append_points(poly_points, xs, ys);
       return *this; //! \return polygon_element& to make chainable.
     }
 
+    polygon_element& reserve(std::size_t n)
+    { //! Reserve space for n points, to avoid re-allocation while adding many points.
+      poly_points.reserve(n);
+      return *this; //! \return polygon_element& to make chainable.
+    }
+
+    std::size_t size_estimate()
+    { //! \return Rough number of chars that write() will output, about 12 per point.
+      return 50 + 12 * poly_points.size();
+    }
+
     void write(std::ostream& os)
     {  /*! \verbatim SVG XML:
             Example: <polygon fill="lime" stroke="blue" stroke-width="10"
@@ -1999,7 +2569,7 @@ public:
          \endverbatim
        */
       os << "\t\t" "<polygon points=\"";
-      for(ptr_vector<poly_path_point>::iterator i = poly_points.begin(); i != poly_points.end(); ++i)
+      for(std::vector<poly_path_point>::iterator i = poly_points.begin(); i != poly_points.end(); ++i)
       {
         (*i).write(os); //  x, y coordinates as " 1,2"
       }
@@ -2021,7 +2591,7 @@ public:
          (But NOT cout << my_polygon << endl;)
          Outputs: (1, 2)(3, 4)(5, 6)
       */
-      for(ptr_vector<poly_path_point>::iterator i = poly_points.begin(); i != poly_points.end(); ++i)
+      for(std::vector<poly_path_point>::iterator i = poly_points.begin(); i != poly_points.end(); ++i)
       {
         os << (*i); //  x, y coordinates as " (1, 2)"
       }
@@ -2032,7 +2602,7 @@ public:
 
   std::ostream& operator<< (std::ostream& os, polygon_element& p)
   { /*! Output all poly_path_ points (May be useful for Boost.Test and diagnosis).
-        ptr_vector<poly_path_point> poly_points; All the x, y coordinate pairs,
+        std::vector<poly_path_point> poly_points; All the x, y coordinate pairs,
         Example: 
         \code
           polygon_element p(1, 2, 3, 4, 5, 6);
@@ -2040,7 +2610,7 @@ public:
         \endcode
         Outputs: (1, 2)(3, 4)(5, 6)
     */
-    for(ptr_vector<poly_path_point>::iterator i = p.poly_points.begin(); i != p.poly_points.end(); ++i)
+    for(std::vector<poly_path_point>::iterator i = p.poly_points.begin(); i != p.poly_points.end(); ++i)
     {
       os << (*i); //  x, y coordinates as " (1, 2)(3, 4)..."
       // Uses \code  os << "(" << p.x << ", " << p.y  << ")" ; \endcode
@@ -2068,13 +2638,13 @@ public:
   friend std::ostream& operator<< (std::ostream&, polyline_element&);
 
    public: 
-    ptr_vector<poly_path_point> poly_points; //!< All the (x, y) coordinate pairs,
-    // push_back by calls of p_path(x, y).
+    std::vector<poly_path_point> poly_points; //!< All the (x, y) coordinate pairs, stored contiguously by value,
+    // push_back by calls of P(x, y).
     //bool fill; // not needed for polyline, unlike polygon.
 
     polyline_element(const polyline_element& rhs)
+      : svg_element(rhs), poly_points(rhs.poly_points)
     { //! Copy constructor.
-      poly_points = (const_cast<polyline_element&>(rhs)).poly_points.release();
     }
 
     polyline_element()
@@ -2084,31 +2654,54 @@ public:
 
     polyline_element (double x1, double y1)
     { //! Constructor from one (x, y) path point, absolute only.
-      poly_points.push_back(new poly_path_point(x1, y1));
+      poly_points.push_back(poly_path_point(x1, y1));
     }
 
     polyline_element (double x1, double y1, double x2, double y2)
     { //! Constructor from  Two (x, y) path points, absolute only.
-      poly_points.push_back(new poly_path_point(x1, y1));
-      poly_points.push_back(new poly_path_point(x2, y2));
+      poly_points.push_back(poly_path_point(x1, y1));
+      poly_points.push_back(poly_path_point(x2, y2));
     }
 
-    polyline_element (std::vector<poly_path_point>& points)
+    polyline_element (const std::vector<poly_path_point>& points)
+      : poly_points(points) // One allocation for all the points.
     { //! Constructor from vector of path points.
-      for(std::vector<poly_path_point>::iterator i = points.begin(); i != points.end(); ++i)
-      {
-        poly_path_point p = (*i);
-        poly_points.push_back(new poly_path_point(p.x, p.y));
-      }
     }
 
     // Member function to add new points to existing line.
     polyline_element& P(double x, double y)
     { //! Absolute (x, y) only, so Capital letter P.
-      poly_points.push_back(new poly_path_point(x, y));
+      poly_points.push_back(poly_path_point(x, y));
+      return *this; //! \return polyline_element& to make chainable.
+    }
+
+    polyline_element& P(const double* xs, const double* ys, std::size_t n)
+    { //! Add n more points from arrays of X and Y SVG coordinates - absolute only.
+      detail::append_points(poly_points, xs, ys, n);
       return *this; //! \return polyline_element& to make chainable.
     }
 
+    template <class XRange, class YRange>
+    typename std::enable_if<!std::is_arithmetic<XRange>::value, polyline_element&>::type
+    P(const XRange& xs, const YRange& ys)
+    { /*! Add more points from two ranges (for example, @c std::vector<double>, @c std::array or @c std::span)
+        of X and Y SVG coordinates - absolute only. Extra values in the longer range are ignored.
+      */
+      detail::append_points(poly_points, xs, ys);
+      return *this; //! \return polyline_element& to make chainable.
+    }
+
+    polyline_element& reserve(std::size_t n)
+    { //! Reserve space for n points, to avoid re-allocation while adding many points.
+      poly_points.reserve(n);
+      return *this; //! \return polyline_element& to make chainable.
+    }
+
+    std::size_t size_estimate()
+    { //! \return Rough number of chars that write() will output, about 12 per point.
+      return 50 + 12 * poly_points.size();
+    }
+
     void write(std::ostream& os)
     { /*! \verbatim
           Output polyline info (useful for Boost.Test).
@@ -2116,7 +2709,7 @@ public:
           \endverbatim
       */
       os << "\t\t" "<polyline points=\"";
-      for(ptr_vector<poly_path_point>::iterator i = poly_points.begin(); i!= poly_points.end(); ++i)
+      for(std::vector<poly_path_point>::iterator i = poly_points.begin(); i!= poly_points.end(); ++i)
       {
         (*i).write(os); //  x, y coordinates as " 1,2"
       }
@@ -2133,10 +2726,10 @@ public:
      Output polyline info (useful for Boost.Test and diagnosis).
       \verbatim
          Example: <polyline points=" 100,100  200,100  300,200  400,400"/>
-         ptr_vector<poly_path_point> poly_points; // All the x, y coordinate pairs.
+         std::vector<poly_path_point> poly_points; // All the x, y coordinate pairs.
       \endverbatim
     */
-    for(ptr_vector<poly_path_point>::iterator i = p.poly_points.begin(); i != p.poly_points.end(); ++i)
+    for(std::vector<poly_path_point>::iterator i = p.poly_points.begin(); i != p.poly_points.end(); ++i)
     {
       os << (*i); //  x, y coordinates as " (1, 2)(3, 4)..."
       // using os << "(" << p.x << ", " << p.y  << ")" ;
@@ -2147,6 +2740,130 @@ public:
     return os;
   } // std::ostream& operator<<
 
+  namespace detail
+  {
+    inline int style_classes_index()
+    { //! \return Index of the @c std::ostream::pword that points to the @c style_classes of the document, if any, see @c svg::css_classes.
+      static const int index = std::ios_base::xalloc();
+      return index;
+    }
+
+    class style_classes
+    { /*! \class boost::svg::detail::style_classes
+        \brief CSS classes for the sets of style attributes that are repeated by groups, see @c svg::css_classes.
+        \details Before the document is written, the style attributes of each group are counted,
+        and each set used by more than one group is named as a class, s0, s1 ...
+        The classes are written once, as rules in the stylesheet, for example:
+        \verbatim .s0{stroke:rgb(0,0,0);stroke-width:1px} \endverbatim
+        and each group then writes @c class="s0" instead of its style attributes.
+      */
+    public:
+      style_classes() : classes_(0)
+      { //! Construct with no style attribute sets or classes.
+      }
+
+      void clear()
+      { //! Forget all style attribute sets and classes.
+        sets_.clear();
+        order_.clear();
+        classes_ = 0;
+      }
+
+      void count(const std::string& attributes)
+      { //! Count one more group using the set of style attributes, for example: @c stroke="rgb(0,0,0)" @c stroke-width="1".
+        if (attributes.empty())
+        {
+          return;
+        }
+        style_set& set = sets_[attributes];
+        if (set.count++ == 0)
+        { // First use.
+          order_.push_back(&*sets_.find(attributes));
+        }
+      }
+
+      void name_classes()
+      { //! Name a class for each set of style attributes used more than once, in order of first use.
+        for (std::size_t i = 0; i < order_.size(); ++i)
+        {
+          if (order_[i]->second.count > 1)
+          {
+            std::ostringstream name;
+            name << 's' << classes_++;
+            order_[i]->second.name = name.str();
+          }
+        }
+      }
+
+      std::size_t size() const
+      { //! \return Number of classes.
+        return classes_;
+      }
+
+      const std::string* find(const std::string& attributes) const
+      { //! \return Name of the class for the set of style attributes, or null if none.
+        std::map<std::string, style_set>::const_iterator it = sets_.find(attributes);
+        return (it == sets_.end() || it->second.name.empty()) ? 0 : &it->second.name;
+      }
+
+      void write_css(std::ostream& os) const
+      { //! Output a CSS rule for each class, with the style attributes as properties, for example: @c .s0{stroke:rgb(0,0,0)}.
+        for (std::size_t i = 0; i < order_.size(); ++i)
+        {
+          if (order_[i]->second.name.empty())
+          {
+            continue;
+          }
+          os << '.' << order_[i]->second.name << '{';
+          const std::string& attributes = order_[i]->first;
+          std::size_t p = 0;
+          bool first = true;
+          while (p < attributes.size())
+          { // Each attribute is written as @c name="value" with a leading space.
+            std::size_t eq = attributes.find("=\"", p);
+            std::size_t end = (eq == std::string::npos) ? std::string::npos : attributes.find('"', eq + 2);
+            if (end == std::string::npos)
+            {
+              break;
+            }
+            std::size_t begin = attributes.find_first_not_of(' ', p);
+            std::string name(attributes, begin, eq - begin);
+            std::string value(attributes, eq + 2, end - eq - 2);
+            os << (first ? "" : ";") << name << ':';
+            double length;
+            if ((name == "font-size" || name == "stroke-width")
+              && parse_g(value.data(), static_cast<int>(value.size()), length))
+            { // A length must have units in CSS (but SVG user units are pixels).
+              char buf[32];
+              os.write(buf, format_g(buf, length, max_fast_precision)); // Same digits, as written with no more.
+              os << "px";
+            }
+            else
+            {
+              os << value;
+            }
+            first = false;
+            p = end + 1;
+          }
+          os << "}\n";
+        }
+      }
+
+    private:
+      struct style_set
+      { //! Groups using a set of style attributes.
+        std::size_t count; //!< Number of groups.
+        std::string name; //!< Class name, or empty if none.
+        style_set() : count(0)
+        {
+        }
+      };
+      std::map<std::string, style_set> sets_; //!< Sets of style attributes used by groups.
+      std::vector<std::pair<const std::string, style_set>*> order_; //!< Sets in order of first use.
+      std::size_t classes_; //!< Number of classes named.
+    }; // class style_classes
+  } // namespace detail
+
   class g_element: public svg_element
   { /*! \class boost::svg::g_element
       \brief g_element (group element) is the node element of our document tree.
@@ -2171,8 +2888,13 @@ public:
       \endverbatim
    */
   public:
-    ptr_vector<svg_element> children_; /*!< Children of this group element node,
+    ptr_vector<svg_element, detail::arena_clone_allocator> children_; /*!< Children of this group element node,
       containing graphics elements like text, rect, circle, line, path, polyline, group ... */
+    detail::element_arena* arena_; //!< Arena from which new children are allocated, or null to use the heap.
+    std::ostream* stream_; //!< Stream to which children are written while streaming, or null to discard them.
+    bool streaming_; //!< @c true if new children are written (or discarded) as soon as complete, rather than retained.
+    bool opened_; //!< @c true if the opening @c <g ...> tag has been written to @c stream_.
+    bool pending_; //!< @c true if the last child was added while streaming, and is not yet written.
 
     std::string clip_name_;  //!< Name of clip path.
     bool clip_on_; //!< @c true if to clip anything outside the clip path, often the plot window,
@@ -2180,7 +2902,7 @@ public:
     align_style  alignment_;  //!< group alignment, left middle or right, or no_align.
     int rotation_; //!< text rotation, positive degrees 0 <= rotation_ <= 360, or specifically no rotation if < 0.
 
-    g_element() : clip_on_(false), clip_name_(""), alignment_(align_style::no_align), rotation_(static_cast<int>(horizontal))
+    g_element() : arena_(0), stream_(0), streaming_(false), opened_(false), pending_(false), clip_on_(false), clip_name_(""), alignment_(align_style::no_align), rotation_(static_cast<int>(horizontal))
     { //! Construct g_element (default with no clipping).
     }
 
@@ -2194,6 +2916,16 @@ public:
       return children_.size();
     }
 
+    std::size_t size_estimate()
+    { //! \return Rough number of chars that write() will output, for all the children (none if no children).
+      std::size_t n = children_.empty() ? 0 : 100;
+      for (std::size_t i = 0; i < children_.size(); ++i)
+      {
+        n += children_[i].size_estimate();
+      }
+      return n;
+    }
+
     void write(std::ostream& os)
     { /*! Output all children groups (leafs of tree) of a group element.
        Example:
@@ -2208,60 +2940,115 @@ public:
            <g id="legendBackground"> </g>
           \endverbatim
         */
-        os << "\t" "<g"; // Do NOT need space if convention is to start following item with space or tab or newline.
-        write_attributes(os); // id="background" (or clip_path).
-        svg_style_.write(os); // Output SVG style info like stroke="rgb(0,0,0)" fill= "rgb(255,0,0)" ...
-        // Default no_style, so not output.
-        text_style_.write(os); // Output SVG text style info like font-size="12" font-family="Lucida Sans Unicode".
-        // Default not_a_text_style so expect no output.
-
-       // alignment_.write(os) // in effect.
-        // 
-        std::string anchor = ""; 
-  //      align_style align_ = align_style::left_align; // OK
-        align_style align_ = alignment_;
-        switch (align_)
+        write_open(os);
+        write_children(os, 0, children_.size());
+        write_close(os);
+      }
+    } // void write(std::ostream& rhs)
+
+    void write_children(std::ostream& os, std::size_t first, std::size_t last)
+    { //! Output children first to last (not including last), without the group's opening and closing tags.
+      //! (Used by @c write, and to write parts of a large group in parallel, see @c svg::write_threads).
+      for(std::size_t i = first; i < last; ++i)
+      {
+        children_[i].write(os);  // Using each element's version of write function.
+        // Using tab to indent also makes easy to read.
+      }
+    }
+
+    void write_close(std::ostream& os)
+    { //! Output the closing tag of the group.
+      os << "\t</g>" "\n"  ; //
+    }
+
+    void write_open(std::ostream& os)
+    { //! Output the opening tag of the group, with its id, clip-path, style and text-anchor.
+      os << "\t" "<g"; // Do NOT need space if convention is to start following item with space or tab or newline.
+      write_attributes(os); // id="background" (or clip_path).
+      const detail::style_classes* classes = static_cast<const detail::style_classes*>(os.pword(detail::style_classes_index()));
+      if (classes == 0 || classes->size() == 0)
+      {
+        write_style(os);
+      }
+      else
+      { // Use the class for this set of style attributes, if any, see svg::css_classes.
+        std::ostringstream style;
+        style.copyfmt(os);
+        write_style(style);
+        if (const std::string* name = classes->find(style.str()))
         {
-        case align_style::left_align:
-          // anchor = "start"; // This is the initial == default,
-          // so should be possible to reduce file size of this by:
-          //anchor = "";
-          break;
-        case align_style::right_align:
-          anchor = "end";
-          break;
-        case align_style::center_align:
-          anchor = "middle";
-          break;
-        default:
-          anchor = "";
-          break;
+          os << " class=\"" << *name << "\"";
         }
-        if (anchor != "")
+        else
         {
-          os << " text-anchor=\"" << anchor << "\"";
+          os << style.str();
         }
+      }
+      os << ">" 
+        "\n"; // Newline after the g_element id and style is easier to read.
+    } // void write_open(std::ostream& os)
+
+    void write_style(std::ostream& os)
+    { //! Output the style attributes of the group: stroke, fill and width, font and text-anchor.
+      svg_style_.write(os); // Output SVG style info like stroke="rgb(0,0,0)" fill= "rgb(255,0,0)" ...
+      // Default no_style, so not output.
+      text_style_.write(os); // Output SVG text style info like font-size="12" font-family="Lucida Sans Unicode".
+      // Default not_a_text_style so expect no output.
+
+     // alignment_.write(os) // in effect.
+      // 
+      std::string anchor = ""; 
+//      align_style align_ = align_style::left_align; // OK
+      align_style align_ = alignment_;
+      switch (align_)
+      {
+      case align_style::left_align:
+        // anchor = "start"; // This is the initial == default,
+        // so should be possible to reduce file size of this by:
+        //anchor = "";
+        break;
+      case align_style::right_align:
+        anchor = "end";
+        break;
+      case align_style::center_align:
+        anchor = "middle";
+        break;
+      default:
+        anchor = "";
+        break;
+      }
+      if (anchor != "")
+      {
+        os << " text-anchor=\"" << anchor << "\"";
+      }
 
-        // rotation is applicable to text, rect, ellipse etc, so should be in group.
-        //if (rotate_ != 0)
-        //{ // Only show rotation info if not normal horizontal writing.
-        //  os << " transform=\"rotate("
-        //    << rotate_ << " "
-        //    << x_ << " "
-        //    << y_ << ")\"";
-        //}
-
-
-        os << ">" 
-          "\n"; // Newline after the g_element id and style is easier to read.
-        for(unsigned int i = 0; i < children_.size(); ++i)
+      // rotation is applicable to text, rect, ellipse etc, so should be in group.
+      //if (rotate_ != 0)
+      //{ // Only show rotation info if not normal horizontal writing.
+      //  os << " transform=\"rotate("
+      //    << rotate_ << " "
+      //    << x_ << " "
+      //    << y_ << ")\"";
+      //}
+    } // void write_style(std::ostream& os)
+
+    void count_styles(detail::style_classes& classes, const std::ostream& format)
+    { //! Count the sets of style attributes of the child groups (and theirs), written with the precision of format, see @c svg::css_classes.
+      for (std::size_t i = 0; i < children_.size(); ++i)
+      {
+        if (g_element* g = dynamic_cast<g_element*>(&children_[i]))
         {
-          children_[i].write(os);  // Using each element's version of write function.
-          // Using tab to indent also makes easy to read.
+          if (g->size() != 0)
+          { // Only written if it has children.
+            std::ostringstream style;
+            style.copyfmt(format);
+            g->write_style(style);
+            classes.count(style.str());
+          }
+          g->count_styles(classes, format);
         }
-        os << "\t</g>" "\n"  ; // 
       }
-    } // void write(std::ostream& rhs)
+    } // void count_styles
 
     g_element& gs(int i)
     { //! i is index of children g_element nodes (first is zero).
@@ -2275,36 +3062,35 @@ public:
       //! Example: \code
       //!   g_element& g0 = my_svg.add_g_element(); // Add first (zeroth) new element to the document.
       //!    \endcode
-      children_.push_back(new g_element());
-      return *(static_cast<g_element*>(&children_[children_.size()-1]));
+      g_element& g = adopt(detail::make_element<svg_element, g_element>(arena_));
+      g.arena_ = arena_; // New groups allocate from the same arena (if any),
+      g.streaming_ = streaming_; // and stream to the same stream (if any).
+      g.stream_ = stream_;
+      return g;
     }
 
     line_element& line(double x1, double y1, double x2, double y2)
     { //! Add a new line child element.
       //! \return A reference to the new child node just created.
-      children_.push_back(new line_element(x1, y1, x2, y2));
-      return *(static_cast<line_element*>(&children_[children_.size()-1]));
+      return adopt(detail::make_element<svg_element, line_element>(arena_, x1, y1, x2, y2));
     }
 
     rect_element& rect(double x1, double y1, double x2, double y2)
     { //! Add a new rect child element.
       //! \return A reference to the new child node just created.
-      children_.push_back(new rect_element(x1, y1, x2, y2));
-      return *(static_cast<rect_element*>(&children_[children_.size()-1]));
+      return adopt(detail::make_element<svg_element, rect_element>(arena_, x1, y1, x2, y2));
     }
 
     circle_element& circle(double x, double y, double radius = 5.)
     { //! Add a new circle child element.
       //! \return A reference to the new child node just created.
-      children_.push_back(new circle_element(x, y, radius));
-      return *(static_cast<circle_element*>(&children_[children_.size()-1]));
+      return adopt(detail::make_element<svg_element, circle_element>(arena_, x, y, radius));
     }
 
     ellipse_element& ellipse(double rx, double ry, double cx, double cy)
     { //! Add a new ellipse child element.
       //! \return A reference to the new child node just created.
-      children_.push_back(new ellipse_element(rx, ry, cx, cy));
-      return *(static_cast<ellipse_element*>(&children_[children_.size()-1]));
+      return adopt(detail::make_element<svg_element, ellipse_element>(arena_, rx, ry, cx, cy));
     }
 
     // svg::text constructor with defaults. 
@@ -2315,103 +3101,266 @@ public:
     const int rotate = static_cast<int>(horizontal))
     { //! Add a new text element.
       //! \return A reference to the new child (leaf) node just created.
-      children_.push_back(new text_element(x, y, text, textstyle, align, rotate));
-      return *(static_cast<text_element*>(&children_[children_.size()-1]));
+      return adopt(detail::make_element<svg_element, text_element>(arena_, arena_, x, y, text, textstyle, align, rotate));
     }
 
     // Polygon for shapes with many vertices.
     polygon_element& polygon(double x, double y, bool f = true)
     { //! Add a new polygon element.
       //! \return A reference to the new child node just created.
-      children_.push_back(new polygon_element(x, y, f));
-      return *(static_cast<polygon_element*>(&children_[children_.size()-1]));
+      return adopt(detail::make_element<svg_element, polygon_element>(arena_, x, y, f));
     }
 
     polygon_element& polygon(std::vector<poly_path_point>& v, bool f = true)
     { //! Add a new complete polygon element.
       //! \return A reference to the new child node just created.
       // push_back a complete many-sided polygon to the document.
-      children_.push_back(new polygon_element(v, f));
-      return *(static_cast<polygon_element*>(&children_[children_.size()-1]));
+      return adopt(detail::make_element<svg_element, polygon_element>(arena_, v, f));
     }
 
     polyline_element& polyline(std::vector<poly_path_point>& v)
     {  //! Add a new complete polyline.
        //! \return A reference to the new child node just created.
-      children_.push_back(new polyline_element(v));
-      return *(static_cast<polyline_element*>(&children_[children_.size()-1]));
+      return adopt(detail::make_element<svg_element, polyline_element>(arena_, v));
     }
 
     polyline_element& polyline(double x, double y)
     { //! Add a new polyline element, but 1st point only, add others later with .P(x, y)...
       //! \return A reference to the new child node just created.
-      children_.push_back(new polyline_element(x, y));
-      return *(static_cast<polyline_element*>(&children_[children_.size()-1]));
+      return adopt(detail::make_element<svg_element, polyline_element>(arena_, x, y));
     }
 
     polygon_element& triangle(double x1, double y1, double x2, double y2, double x3, double y3, bool f = true)
     { //! Add a new triangle element.
       //! \return A reference to the new child node just created.
-      children_.push_back(new polygon_element(x1, y1, x2, y2, x3, y3, f));
-      return *(static_cast<polygon_element*>(&(children_[(unsigned int)(children_.size()-1)])));
+      return adopt(detail::make_element<svg_element, polygon_element>(arena_, x1, y1, x2, y2, x3, y3, f));
     }
 
     polygon_element& rhombus(double x1, double y1, double x2, double y2, double x3, double y3, double x4, double y4, bool f = true)
     { //! Add a new rhombus element.
       //! \return A reference to the new child node just created.
-      children_.push_back(new polygon_element(x1, y1, x2, y2, x3, y3, x4, y4, f = true));
-      return *(static_cast<polygon_element*>(&(children_[(unsigned int)(children_.size()-1)])));
+      return adopt(detail::make_element<svg_element, polygon_element>(arena_, x1, y1, x2, y2, x3, y3, x4, y4, f = true));
     }
 
     polygon_element& pentagon(double x1, double y1, double x2, double y2, double x3, double y3, double x4, double y4, double x5, double y5, bool f = true)
     { //! Add a new pentagon element.
       //! \return A reference to the new child node just created.
       // push_back a complete pentagon to the document.
-      children_.push_back(new polygon_element(x1, y1, x2, y2, x3, y3, x4, y4, x5, y5, f));
-      return *(static_cast<polygon_element*>(&(children_[(unsigned int)(children_.size()-1)])));
+      return adopt(detail::make_element<svg_element, polygon_element>(arena_, x1, y1, x2, y2, x3, y3, x4, y4, x5, y5, f));
     }
 
     polygon_element& hexagon(double x1, double y1, double x2, double y2, double x3, double y3, double x4, double y4, double x5, double y5, double x6, double y6, bool f = true)
     { //! Add a new hexagon element.
       //! \return A reference to the new child node just created.
       // push_back a complete 6-sided star to the document.
-      children_.push_back(new polygon_element(x1, y1, x2, y2, x3, y3, x4, y4, x5, y5, x6, y6, f));
-      return *(static_cast<polygon_element*>(&(children_[(unsigned int)(children_.size()-1)])));
+      return adopt(detail::make_element<svg_element, polygon_element>(arena_, x1, y1, x2, y2, x3, y3, x4, y4, x5, y5, x6, y6, f));
     }
 
     polygon_element& polygon()
     { //! Add a new polygon element.
       //! \return A reference to the new polygon element just created.
-      children_.push_back(new polygon_element()); // Empty polygon,
+      return adopt(detail::make_element<svg_element, polygon_element>(arena_)); // Empty polygon,
       // to which poly_path_points can be added later using member function P.
-      return *(static_cast<polygon_element*>(&(children_[(unsigned int)(children_.size()-1)])));
     }
 
     polyline_element& polyline()
     { //! Add a new polyline element.
       //! \return A reference to the new polyline element just created.
-      children_.push_back(new polyline_element()); // Empty polyline.
-      return *(static_cast<polyline_element*>(&(children_[(unsigned int)(children_.size()-1)])));
+      return adopt(detail::make_element<svg_element, polyline_element>(arena_)); // Empty polyline.
     }
 
     path_element& path()
     { //! Add a new path element.
       //! \return A reference to the new path just created.
-      children_.push_back(new path_element()); // Empty path.
-      return *(static_cast<path_element*>(&(children_[(unsigned int)(children_.size()-1)])));
+      return adopt(detail::make_element<svg_element, path_element>(arena_)); // Empty path.
+    }
+
+    glyphs_element& glyphs(const std::string& glyph, const text_style& ts = no_text_style, align_style align = align_style::center_align)
+    { //! Add a new glyphs element, to which positions of the glyph are added by @c P(x, y).
+      //! \return A reference to the new glyphs element just created.
+      return adopt(detail::make_element<svg_element, glyphs_element>(arena_, glyph, ts, align));
+    }
+
+    use_element& use(double x, double y, const std::string& href)
+    { //! Add a new use element, drawing the symbol whose id is @c href at (x, y).
+      //! \return A reference to the new use element just created.
+      return adopt(detail::make_element<svg_element, use_element>(arena_, x, y, href));
     }
 
     void push_back(svg_element* g)
     { //! Add a new child node g_element.
-      children_.push_back(g);
+      adopt(g);
     }
 
     void clear()
     { //! Remove all the child nodes.
       children_.clear();
+      pending_ = false;
+    }
+
+    g_element& stream(std::ostream* os)
+    { /*! Start streaming: each child added from now on is written to @c os (or discarded if @c os is null)
+        and destroyed as soon as the next child is added, or @c end_stream() is called,
+        so that memory use does not grow with the number of children.
+        Any existing children are written (but kept) first, so the output is the same as from @c write().
+        New child groups stream too (unless @c retain() is called for them).
+        \note Group attributes must be set before the first child is added,
+        and a child must not be changed after the next child has been added.
+      */
+      streaming_ = true;
+      stream_ = os;
+      opened_ = false;
+      pending_ = false;
+      if (os != 0 && children_.size() > 0)
+      {
+        write_open(*os);
+        opened_ = true;
+        for(unsigned int i = 0; i < children_.size(); ++i)
+        {
+          children_[i].write(*os);
+        }
+      }
+      return *this; //! \return g_element& to make chainable.
+    }
+
+    void end_stream()
+    { //! Write (or discard) the last child, close the group if it was opened, and stop streaming.
+      if (pending_)
+      {
+        write_pending();
+      }
+      if (opened_)
+      {
+        write_close(*stream_);
+      }
+      streaming_ = false;
+      stream_ = 0;
+      opened_ = false;
+    }
+
+    bool streaming()
+    { //! \return @c true if children are being streamed rather than retained.
+      return streaming_;
+    }
+
+    bool pending()
+    { //! \return @c true if a child has been added while streaming, and is not yet written (or discarded).
+      return pending_;
+    }
+
+    g_element& retain()
+    { /*! Retain all children of a new child group of a streaming group, to be written together when complete.
+        Needed if the group attributes are changed after adding children.
+      */
+      streaming_ = false;
+      stream_ = 0;
+      return *this; //! \return g_element& to make chainable.
+    }
+
+    g_element& arena(detail::element_arena* a)
+    { //! Set arena from which new child elements of this group are allocated (null to use the heap).
+      //! Existing children are unaffected; see @c svg::arena_on.
+      arena_ = a;
+      return *this; //! \return g_element& to make chainable.
+    }
+
+    detail::element_arena* arena()
+    { //! \return Arena from which new child elements of this group are allocated, or null if the heap.
+      return arena_;
     }
+
+    void erase_arena_children()
+    { /*! Remove all child nodes (at any depth) that were allocated from an arena,
+        so that the arena can be released.
+        Groups allocated on the heap are kept, with any of their heap children.
+      */
+      for (unsigned int i = 0; i < children_.size(); ++i)
+      {
+        g_element* g = dynamic_cast<g_element*>(&children_[i]);
+        if (g != 0 && !g->in_arena_)
+        {
+          g->erase_arena_children();
+        }
+      }
+      children_.erase_if(is_in_arena);
+    }
+
+  private:
+    static bool is_in_arena(const svg_element& e)
+    {
+      return e.in_arena_;
+    }
+
+    template <class T>
+    T& adopt(T* e)
+    { // Add new child e, first writing (or discarding) any child still pending while streaming.
+      if (streaming_)
+      {
+        if (pending_)
+        {
+          write_pending();
+        }
+        else if (stream_ != 0 && !opened_)
+        { // First child, so the group will not be empty.
+          write_open(*stream_);
+          opened_ = true;
+        }
+        pending_ = true;
+      }
+      children_.push_back(e);
+      return *e;
+    }
+
+    void write_pending()
+    { // Write (or discard) the last child, added while streaming, and destroy it.
+      if (stream_ != 0)
+      {
+        g_element* g = dynamic_cast<g_element*>(&children_.back());
+        if (g != 0 && g->streaming_)
+        {
+          g->end_stream();
+        }
+        else
+        {
+          children_.back().write(*stream_);
+        }
+      }
+      children_.pop_back();
+      pending_ = false;
+    }
+  public:
   }; // class g_element
 
+  class symbol_element : public g_element
+  { /*! \class boost::svg::symbol_element
+      \brief Group of elements defined once, and drawn wherever a @c use_element refers to it by its id.
+      \details Symbols are written in a @c <defs> section, see @c svg::markers.
+      The symbol has no viewBox, and overflow is visible,
+      so its elements are drawn at their own coordinates, relative to the (x, y) of each @c <use>.
+      \sa https://www.w3.org/TR/SVG11/struct.html#SymbolElement
+    */
+  public:
+    symbol_element(const std::string& id)
+    { //! Construct an empty symbol, with its unique id.
+      id_name_ = id;
+    }
+
+    void write(std::ostream& os)
+    { /*! Output the symbol and all its elements, for example:
+        \verbatim
+          <symbol id="m0" overflow="visible">
+            <text x="0" y="2.94" text-anchor="middle" font-size="10">&#x2666;</text>
+          </symbol>
+        \endverbatim
+      */
+      os << "\t<symbol";
+      write_attributes(os);
+      os << " overflow=\"visible\">" "\n";
+      write_children(os, 0, children_.size());
+      os << "\t</symbol>" "\n";
+    }
+  }; // class symbol_element
+
 } // namespace svg
 } // namespace boost
 
@@ -0,0 +1,158 @@
+/*! \file
+    \brief Non-owning views of data values held by the caller, for data-series plotted without copying,
+      see @c svg_2d_plot::plot_view and @c svg_1d_plot::plot_view.
+    \details A @c value_span refers to @c double values that are contiguous (a column array),
+      or strided at a fixed distance in bytes (for example, one member of an array of structs).
+      The values are read when the plot is drawn, so must remain unchanged until the plot is written.
+      A @c value_span is also a (read-only, random access) container, so can be used wherever a container of values can,
+      for example, @c svg_boxplot::plot or @c y_autoscale.
+*/
+
+// value_span.hpp
+
+// Copyright Paul A. Bristow 2020
+
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_SVG_VALUE_SPAN_HPP
+#define BOOST_SVG_VALUE_SPAN_HPP
+
+#include <boost/iterator/iterator_facade.hpp>
+
+#include <cstddef>
+// using std::size_t;
+#include <vector>
+// using std::vector;
+
+namespace boost
+{
+namespace svg
+{
+
+class value_span
+{ /*! \class boost::svg::value_span
+     \brief Non-owning view of size @c double values, starting at data, each stride bytes after the one before.
+     \details For example:
+     \code
+       std::vector<double> x; // Column arrays,
+       double y[1000];
+       my_plot.plot_view(x, y, "columns");
+
+       struct sample { double time; double volts; int flags; };
+       std::vector<sample> samples; // or an array of structs.
+       my_plot.plot_view(value_span(samples.data(), samples.size(), &sample::time),
+         value_span(samples.data(), samples.size(), &sample::volts), "samples");
+     \endcode
+  */
+public:
+  class const_iterator : public boost::iterator_facade<const_iterator, const double, std::random_access_iterator_tag>
+  { //! Iterator over the values of a span, each stride bytes after the one before.
+  public:
+    const_iterator() : p_(0), stride_(sizeof(double))
+    {
+    }
+    const_iterator(const char* p, std::size_t stride) : p_(p), stride_(stride)
+    {
+    }
+  private:
+    friend class boost::iterator_core_access;
+    const double& dereference() const
+    {
+      return *reinterpret_cast<const double*>(p_);
+    }
+    bool equal(const const_iterator& other) const
+    {
+      return p_ == other.p_;
+    }
+    void increment()
+    {
+      p_ += stride_;
+    }
+    void decrement()
+    {
+      p_ -= stride_;
+    }
+    void advance(std::ptrdiff_t n)
+    {
+      p_ += n * static_cast<std::ptrdiff_t>(stride_);
+    }
+    std::ptrdiff_t distance_to(const const_iterator& other) const
+    {
+      return (other.p_ - p_) / static_cast<std::ptrdiff_t>(stride_);
+    }
+    const char* p_; //!< Address of value.
+    std::size_t stride_; //!< Bytes from one value to the next.
+  }; // class const_iterator
+
+  typedef double value_type; //!< Type of values, as a container.
+  typedef const_iterator iterator; //!< Values are read-only.
+
+  value_span() : data_(0), size_(0), stride_(sizeof(double))
+  { //! Empty span, of no values.
+  }
+
+  value_span(const double* data, std::size_t size, std::size_t stride = sizeof(double))
+    : data_(reinterpret_cast<const char*>(data)), size_(size), stride_(stride)
+  { //! Span of size values from data, by default contiguous, else each stride bytes after the one before.
+  }
+
+  template <class T>
+  value_span(const T* data, std::size_t size, const double T::* member)
+    : data_(size == 0 ? 0 : reinterpret_cast<const char*>(&(data->*member))), size_(size), stride_(sizeof(T))
+  { //! Span of the @c double member of each of size structs (or classes) in an array from data.
+  }
+
+  value_span(const std::vector<double>& values)
+    : data_(reinterpret_cast<const char*>(values.data())), size_(values.size()), stride_(sizeof(double))
+  { //! Span of all the values of a vector (which must not be resized until the plot is written).
+  }
+
+  template <std::size_t N>
+  value_span(const double (&values)[N])
+    : data_(reinterpret_cast<const char*>(values)), size_(N), stride_(sizeof(double))
+  { //! Span of all the values of an array.
+  }
+
+  double operator[](std::size_t i) const
+  { //! \return ith value.
+    return *reinterpret_cast<const double*>(data_ + i * stride_);
+  }
+
+  std::size_t size() const
+  { //! \return Number of values.
+    return size_;
+  }
+
+  bool empty() const
+  { //! \return @c true if the span has no values.
+    return size_ == 0;
+  }
+
+  std::size_t stride() const
+  { //! \return Distance in bytes between values.
+    return stride_;
+  }
+
+  const_iterator begin() const
+  { //! \return Iterator to first value.
+    return const_iterator(data_, stride_);
+  }
+
+  const_iterator end() const
+  { //! \return Iterator to one past the last value.
+    return const_iterator(data_ + size_ * stride_, stride_);
+  }
+
+private:
+  const char* data_; //!< Address of 1st value.
+  std::size_t size_; //!< Number of values.
+  std::size_t stride_; //!< Bytes from one value to the next.
+}; // class value_span
+
+} // namespace svg
+} // namespace boost
+
+#endif // BOOST_SVG_VALUE_SPAN_HPP
@@ -174,9 +174,17 @@
 #include <fstream>
 #include <exception>
 #include <vector>
+#include <map>
+#include <sstream>
+#include <algorithm>
+#include <thread>
 
 //#include "stylesheet.hpp" // TODO - and better to be called svg_stylesheet.hpp?
 #include "detail/svg_elements.hpp" // element class definitions.
+#include "detail/output_sink.hpp" // string_sink, file_sink...
+#include "detail/gzip_sink.hpp" // Compressed .svgz output.
+#include "detail/minify_sink.hpp" // Compact output profile.
+#include "detail/parallel_write.hpp" // Layers written by several threads.
 #include "svg_style.hpp"
 //#include "svg_fwd.hpp" // Could be used to check declarations and definitions match correctly.
 
@@ -289,8 +297,9 @@ class svg;
 // svg& circle(double x, double y, unsigned int radius = 5)
 // svg& ellipse(double rx, double ry, double cx, double cy)
 
-// write SVG image out to @c std::ostream or to file:
+// write SVG image out to @c std::ostream, to an @c output_sink or to file:
 // svg& write(std::ostream&)
+// svg& write(output_sink&)
 // svg& write(const std::string& file)
 
 // Possibles for license strings:
@@ -310,6 +319,7 @@ class svg
   unsigned int x_size_; //!< SVG image X-axis size (in SVG units (default pixels).
   unsigned int y_size_; //!< SVG image Y-axis size (in SVG units (default pixels).
 
+  detail::element_arena arena_; //!< Optional arena for document elements (declared before @c document_ so outlives it).
   g_element document_; //!< Parent g_element to hold all group elements of the svg document.  Initially none.
   // Function gs accesses ith g_element child nodes in tree, for example:
   //  image_.gs(PLOT_BACKGROUND).style().fill_color(red);
@@ -317,6 +327,9 @@ class svg
   // Could better be called parent_group_ ?
 
   std::vector<clip_path_element> clip_paths_; //!< Points on clip path (used for plot window).
+  g_element symbols_; //!< Symbols of data-point markers, see @c markers, written in @c <defs>.
+  std::map<std::string, std::string> marker_ids_; //!< id of the symbol for each marker, or "" if written in full.
+  std::size_t symbols_written_; //!< Number of symbols already written to the current document.
 
   // Document metadata:
   std::string title_document_; //!< SVG document title (appears in the SVG file header as \verbatim <title> ... </title> \endverbatim).
@@ -334,7 +347,15 @@ class svg
   std::string distribution_; //!< License requirements for distribution: "permits", "requires", or "prohibits".
   std::string derivative_works_; //!< License requirements for derivative: "permits", "requires", or "prohibits".
   int coord_precision_; //!< Number of decimal digits precision for output of X and Y coordinates to SVG XML.
+  bool compact_paths_; //!< If true, path data are written as briefly as possible, see @c compact_paths.
+  bool compress_on_; //!< If true, files are written compressed as .svgz, see @c compress_on.
+  bool compact_output_; //!< If true, SVG XML is written minified, see @c compact_output.
+  bool css_classes_; //!< If true, repeated group styles are written as CSS classes, see @c css_classes.
+  marker_policy markers_; //!< How data-point markers are written, see @c markers.
+  detail::style_classes style_classes_; //!< CSS classes for repeated group styles, named as the document is written.
+  unsigned int write_threads_; //!< Number of threads used to write the document elements, see @c write_threads.
   // Not sure this is the best place for this?
+  bool arena_on_; //!< If true, new document elements are allocated from @c arena_ rather than the heap.
 
 public:
   svg() //! Define class svg default constructor.
@@ -342,6 +363,7 @@ public:
     document_(), // Defautl construct - this should give not_a_text_style.
     x_size_(400), //!< X-axis of the whole SVG image (default 400 SVG units, default pixels).
     y_size_(400), //!< Y-axis of the whole SVG image (default 400 SVG units, default pixels).
+    symbols_written_(0), //!< No marker symbols written yet.
     title_document_(""),  //!< This is a SVG document title, not a plot title (@c std::string).
     image_desc_(""), //!< Information about the SVG image, for example, the program that created it  (@c std::string).
     holder_copyright_(""),  //!< Name of copyright holder (@c std::string).
@@ -356,12 +378,28 @@ public:
     commercialuse_("permits"), //<! Default license permits commerical use.
     distribution_("permits"), //!< Default license permits distribution.
     derivative_works_("permits"), //!< Default license permits derivative works.
-    coord_precision_(3) //!< 3 decimal digits precision is enough for 1 in 1000 resolution: suits small image use. Higher precision (4, 5 or 6) will be needed for larger images, but increase the SVG XML file size, especially if there are very many data values.
+    coord_precision_(3), //!< 3 decimal digits precision is enough for 1 in 1000 resolution: suits small image use. Higher precision (4, 5 or 6) will be needed for larger images, but increase the SVG XML file size, especially if there are very many data values.
+    compact_paths_(false), //!< Default writes one absolute command per path point, easier to read.
+    compress_on_(false), //!< Default writes plain .svg files (unless filename ends with .svgz).
+    compact_output_(false), //!< Default writes SVG XML laid out to be read, with comments.
+    css_classes_(false), //!< Default writes the style attributes of each group.
+    markers_(inline_markers), //!< Default writes each data-point marker in full.
+    write_threads_(1), //!< Default writes all document elements in this thread.
+    arena_on_(false) //!< Default allocates each element on the heap.
   { // Default constructor.
   }
 
-  svg(const svg& rhs) : x_size_(rhs.x_size_), y_size_(rhs.y_size_)
-  { //! Copy constructor copies ONLY X and Y image sizes.
+  svg(const svg& rhs) : x_size_(rhs.x_size_), y_size_(rhs.y_size_),
+    symbols_written_(0), // Symbols are not copied.
+    coord_precision_(rhs.coord_precision_),
+    compact_paths_(rhs.compact_paths_),
+    compress_on_(rhs.compress_on_),
+    compact_output_(rhs.compact_output_),
+    css_classes_(rhs.css_classes_),
+    markers_(rhs.markers_),
+    write_threads_(rhs.write_threads_),
+    arena_on_(rhs.arena_on_)
+  { //! Copy constructor copies ONLY X and Y image sizes, and the options for writing the document.
     // TODO Other member data items are NOT copied.  OK? Unused and untested, and perhaps not useful.
     // I think this means that in practice one can't copy an existing customised SVG?
   }
@@ -422,7 +460,165 @@ public:
     return coord_precision_;
   }
 
+  void compact_paths(bool on)
+  { //! \brief Set to write path data as briefly as possible, for exactly the same path.
+    /*! \details By default, each point of a path is written as an absolute command on a line of its own,
+      for example @c L12.3,45.6 (easy to read in the SVG XML source).\n
+
+      With compact paths on, each line-to is written as relative @c l, or horizontal or vertical @c H @c h @c V @c v,
+      whichever is shortest, command letters implied by the previous command are omitted,
+      and the commas, spaces and newlines not needed to separate numbers are omitted too.
+      The relative deltas are between the coordinates rounded to @c coord_precision(),
+      and are only used if they add up to exactly the same points,
+      so the path drawn is the same (and rounding errors do not accumulate).
+      Dense plots of many data-points (for example, time series) are much smaller.
+      Used in @c svg.write below and so applies to all the entire @c svg document.
+     */
+    compact_paths_ = on;
+  }
+
+  bool compact_paths()
+  { //! \return @c true if path data are to be written as briefly as possible.
+    return compact_paths_;
+  }
+
+  void compress_on(bool on)
+  { //! \brief Set to write files compressed in gzip format as .svgz (default suffix .svgz rather than .svg).
+    /*! \details Files whose name ends with .svgz are always compressed (if @c BOOST_SVG_SVGZ is defined).
+      The SVG XML is deflated as it is written, so the uncompressed text is never held nor written.
+      Needs zlib: define @c BOOST_SVG_SVGZ and link with zlib, see @c gzip_sink.
+     */
+    compress_on_ = on;
+  }
+
+  bool compress_on()
+  { //! \return @c true if files are to be written compressed as .svgz.
+    return compress_on_;
+  }
+
+  void compact_output(bool on)
+  { //! \brief Set to write the compact output profile: SVG XML as small as possible, for exactly the same image.
+    /*! \details Comments and the whitespace that lays out the SVG XML are omitted,
+      colors are written as @c \#rrggbb (or @c \#rgb), attributes with the value they have anyway
+      (inherited from a group, or the default) are omitted, and path data are written as with @c compact_paths(true).
+      The SVG XML is minified as it is written, by a @c minify_sink, so works with all outputs (including .svgz).
+      Used in @c svg.write below and so applies to all the entire @c svg document.
+     */
+    compact_output_ = on;
+  }
+
+  bool compact_output()
+  { //! \return @c true if SVG XML is to be written minified, as the compact output profile.
+    return compact_output_;
+  }
+
+  void css_classes(bool on)
+  { //! \brief Set to write each set of style attributes repeated by groups once, as a CSS class in the stylesheet.
+    /*! \details Many groups (the layers of a plot, and the groups of each data-series within them)
+      repeat the same stroke, fill, width and font attributes, like
+      @c stroke="rgb(0,0,0)" @c stroke-width="1" @c font-size="10" @c font-family="Verdana".
+      With CSS classes on, each set used by more than one group is written once,
+      as a rule in a @c <style> element, and the groups write just @c class="s0" instead,
+      so the file is smaller, and a browser resolves each style only once.
+      Used in @c svg.write below and so applies to all the entire @c svg document.
+     */
+    css_classes_ = on;
+  }
+
+  bool css_classes()
+  { //! \return @c true if group styles repeated are to be written as CSS classes.
+    return css_classes_;
+  }
+
+  void markers(marker_policy policy)
+  { //! \brief Set how data-point markers are written: in full (default), as a @c <use> of a symbol, whichever is smaller, or batched.
+    /*! \details By default, each data-point marker is written in full, for example, a Unicode glyph with its font attributes
+      @c <text @c x="12.3" @c y="45.6" @c text-anchor="middle" @c font-size="10" @c font-family="Lucida Sans Unicode">&#x2666;</text>.
+      With @c use_markers, each different marker (shape, size and font) is defined once, as a @c <symbol> in @c <defs>,
+      and each data-point is just @c <use @c xlink:href="#m0" @c x="12.3" @c y="45.6"/>,
+      which is smaller to write, and quicker to render, for series of very many data-points.
+      With @c smallest_markers, each marker is written whichever way is shorter.
+      With @c batched_markers, the glyph markers (all but the @c symbol shape) of each data-series are written as
+      a single @c <text> element (for each 1000 data-points) with lists of coordinates, like @c <text @c x="12.3 23.4 ..." @c y="45.6 56.7 ..."
+      @c text-anchor="middle" @c font-size="10">&#x2666;&#x2666;...</text>; other markers are written in full.
+      The markers drawn look exactly the same (uncertainty ellipses, which differ for each point, are always written in full).
+     */
+    markers_ = policy;
+  }
+
+  marker_policy markers()
+  { //! \return How data-point markers are written: in full, as a @c <use> of a symbol, whichever is smaller, or batched.
+    return markers_;
+  }
+
+  void write_threads(unsigned int threads)
+  { //! \brief Set the number of threads used to write the document elements (default 1, 0 means one per hardware thread).
+    /*! \details With more than one thread, the group layers (and large groups within them) are split into segments
+      that are serialized in parallel into separate buffers, each output in the original order
+      as soon as the segments before it have been, so the document written is exactly the same.
+      This is worthwhile for plots of very many data-points (hundreds of thousands or more).
+      \note Ignored when a plot is written with @c svg_2d_plot::streaming_on, as its data layers are written as they are drawn.
+     */
+    write_threads_ = (threads == 0) ? (std::max)(std::thread::hardware_concurrency(), 1U) : threads;
+  }
+
+  unsigned int write_threads()
+  { //! \return Number of threads used to write the document elements.
+    return write_threads_;
+  }
+
+  svg& arena_on(bool on)
+  { /*! \brief Set to allocate document elements from an arena owned by this @c svg.
+      \details Plots with very many data-points add one (or more) small elements per point,
+      and allocating each with @c new dominates the time to build the document.
+      With the arena on, elements and text runs added to groups of the document
+      are carved out of a few large blocks, and are all freed in one shot
+      by @c arena_release() (called by plot @c clear_all()), or when the @c svg is destroyed.
+      The top-level groups themselves (for example, the plot layers, or annotations)
+      and any elements already in the document stay on the heap.
+    */
+    arena_on_ = on;
+    for (size_t i = 0; i < document_.size(); ++i)
+    {
+      g_element* g = dynamic_cast<g_element*>(&document_[static_cast<unsigned int>(i)]);
+      if (g != 0)
+      {
+        set_arena(*g, on ? &arena_ : 0);
+      }
+    }
+    return *this; //! \return svg& to make chainable.
+  }
+
+  bool arena_on()
+  { //! \return true if document elements are allocated from the arena.
+    return arena_on_;
+  }
+
+  void arena_release()
+  { //! Remove all elements allocated from the arena from the document, and make its memory available for re-use.
+    document_.erase_arena_children();
+    arena_.release();
+  }
+
+  detail::element_arena& arena()
+  { //! \return Arena from which elements are allocated (when @c arena_on), for example to show @c bytes_used().
+    return arena_;
+  }
+
   //! \cond DETAIL // Doxygen document this section only if DETAIL defined.
+  void set_arena(g_element& g, detail::element_arena* a)
+  { //! Set arena for group g and all its existing child groups.
+    g.arena(a);
+    for (size_t i = 0; i < g.size(); ++i)
+    {
+      g_element* child = dynamic_cast<g_element*>(&g[static_cast<unsigned int>(i)]);
+      if (child != 0)
+      {
+        set_arena(*child, a);
+      }
+    }
+  }
+
   void write_header(std::ostream& s_out)
   { //! Output the DTD SVG 1.1 header into the SVG g_element document.
     s_out << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>"
@@ -455,15 +651,16 @@ public:
   }
 
   void write_css(std::ostream& s_out)
-  { //! Output CSS (Cascading Style Sheet) - (not yet used or implemented).
-    if (css_.size() != 0) // css != ""
+  { //! Output CSS (Cascading Style Sheet): any @c css_, and the classes for repeated group styles, see @c css_classes.
+    if (css_.size() != 0 || style_classes_.size() != 0) // css != ""
     { // TODO confirm that this isn't useful if css is "".
       // [CDATA[ ... ]] enclosing the style information
       // is a standard XML construct for hiding information
       // necessary since CSS style sheets can include characters,
       // such as ">", which conflict with XML parsers.
-      s_out << "<defs><style type=\"text/css\"><![CDATA[" << css_
-        << "]]></style></defs>" << std::endl;
+      s_out << "<defs><style type=\"text/css\"><![CDATA[" << css_;
+      style_classes_.write_css(s_out);
+      s_out << "]]></style></defs>" << std::endl;
       // CSS inline style can be declared within a style attribute in SVG
       // by specifying a semicolon-separated list of property declarations,
       // where each property declaration has the form "name: value".
@@ -494,14 +691,36 @@ public:
     }
   } // void write_css(std::ostream& s_out)
 
+  void write_clip_paths(std::ostream& s_out)
+  { //! Output all clip paths that define a region of the output device to which paint can be applied.
+    for (size_t i = 0; i < clip_paths_.size(); ++i)
+    {
+      clip_paths_[(unsigned int)i].write(s_out);
+    }
+  } // write_clip_paths
+
+  void write_symbols(std::ostream& s_out)
+  { //! Output any symbols of data-point markers not yet written, in a @c <defs> section, see @c markers.
+    if (symbols_written_ < symbols_.size())
+    {
+      s_out << "<defs>" "\n";
+      symbols_.write_children(s_out, symbols_written_, symbols_.size());
+      s_out << "</defs>" << std::endl;
+      symbols_written_ = symbols_.size();
+    }
+  } // write_symbols
+
   void write_document(std::ostream& s_out)
   { //! \brief Output all of the image to the SVG document (Internal function)
     /*! \details Output all clip paths that define a region of the output device
-      to which paint can be applied.
+      to which paint can be applied, any symbols of data-point markers, and then all the group elements.
      */
-    for (size_t i = 0; i < clip_paths_.size(); ++i)
-    {
-      clip_paths_[(unsigned int)i].write(s_out);
+    write_clip_paths(s_out);
+    write_symbols(s_out);
+    if (write_threads_ > 1)
+    { // Serialize layers in parallel.
+      detail::write_parallel(s_out, document_, write_threads_);
+      return;
     }
     // Write all visual group elements.
     for (size_t i = 0; i < document_.size(); ++i)
@@ -520,9 +739,11 @@ public:
   builds the document tree, and then calls the write function for the root
   document node, which calls all other nodes through the Visitor pattern.
 
-  TODO provide a filtered-stream version that writes in zipped format type .svgz ?
+  If the filename ends with .svgz (or @c compress_on(true)), the file version writes to a @c gzip_sink instead,
+  so that the document is compressed (in gzip format) as it is written.
+  (Without @c BOOST_SVG_SVGZ, a file named .svgz is written uncompressed, and @c compress_on(true) throws).
   http://lists.w3.org/Archives/Public/www-svg/2005Dec/0308.html
-  recommends MUST have correct Content-Encoding headers.
+  recommends MUST have correct Content-Encoding headers (if served over http).
   */
   // --------------------------------------------------------------------------------
 
@@ -530,8 +751,16 @@ public:
   {
     std::string file(filename); // Copy to avoid problems with const if need to append.
     if (file.find('.') == std::string::npos)
-    { // No file type suffix, so provide the default .svg.
-      file.append(".svg");
+    { // No file type suffix, so provide the default .svg (or .svgz).
+      file.append(compress_on_ ? ".svgz" : ".svg");
+    }
+    if (detail::is_compressed(compress_on_, file))
+    { // Deflate while writing.
+      gzip_sink z_out(file); // Throws if unable to open.
+      filename_ = file;
+      write(z_out);
+      z_out.close();
+      return;
     }
     std::ofstream f_out(file.c_str());
     if(f_out.fail())
@@ -546,6 +775,57 @@ public:
 
   void write(std::ostream& s_out)
   { //! Write whole .svg 'file' contents to stream (perhaps a file).
+    if (compact_output_ && dynamic_cast<minify_sink*>(s_out.rdbuf()) == 0)
+    { // Write through a sink that minifies, and passes the result on to s_out.
+      minify_sink minify(s_out.rdbuf());
+      std::ostream m_out(&minify);
+      m_out.copyfmt(s_out);
+      write(m_out);
+      m_out.flush();
+      minify.close();
+      return;
+    }
+    if (output_sink* sink = dynamic_cast<output_sink*>(s_out.rdbuf()))
+    { // Writing to a sink, that can be pre-sized.
+      sink->reserve(size_estimate());
+    }
+    write_prolog(s_out); // Header, metadata and stylesheet.
+    write_document(s_out); // write clip paths and all document elements.
+    write_epilog(s_out);
+  }
+
+  void write(output_sink& sink)
+  { /*! Write whole .svg 'file' contents directly to an @c output_sink,
+      for example, appending to a @c std::string using a @c string_sink,
+      or to a file through a large buffer using a @c file_sink.
+      The sink is first told an estimate of the size of the document, so that it can be pre-sized.
+    */
+    std::ostream s_out(&sink);
+    write(s_out);
+    s_out.flush();
+  }
+
+  std::size_t size_estimate()
+  { //! \return Rough number of chars that @c write() will output, from the number and kind of elements in the document.
+    std::size_t n = 2000; // Header, metadata and stylesheet.
+    for (size_t i = 0; i < clip_paths_.size(); ++i)
+    {
+      n += clip_paths_[i].size_estimate();
+    }
+    return n + symbols_.size_estimate() + document_.size_estimate();
+  }
+
+  void format_stream(std::ostream& s_out)
+  { //! Set the format state of s_out used to write the document elements (also to any other stream holding some of them).
+    s_out.precision(coord_precision());
+    s_out.iword(detail::compact_paths_index()) = compact_paths_ || compact_output_; // Used by path_element::write.
+  }
+
+  void write_prolog(std::ostream& s_out)
+  { /*! Write the .svg 'file' contents that precede the clip paths and document elements:
+      XML header, opening @c <svg tag, comments, metadata, license and stylesheet.
+      (Used with @c write_document and @c write_epilog, or to stream document elements, see @c g_element::stream).
+    */
     write_header(s_out); // "<?xml version=...
     // write svg document, begin <svg tag.
     // <svg xml:space="preserve" width="5.5in" height=".5in">
@@ -571,7 +851,13 @@ public:
       // are a part of the xlink specification http://www.w3.org/1999/xlink.
       // Need to use xlink:href to refer to xlink.
       //  "xmlns:ev=\"http://www.w3.org/2001/xml-events\"\n"
-      << '>' << std::endl;
+      ;
+    if (markers_ == use_markers || markers_ == smallest_markers)
+    { // Data-point markers may be written as <use xlink:href="#m0" ...
+      // (declared in advance, because markers drawn while streaming are only known later).
+      s_out << "xmlns:xlink=\"http://www.w3.org/1999/xlink\"\n";
+    }
+    s_out << '>' << std::endl;
 
     // Bind the required namespaces, see http://jwatt.org/svg/authoring/#namespace-binding
     //
@@ -618,7 +904,7 @@ public:
     { // Example: <!-- File demo_1d_plot.svg -->
       s_out << "<!-- File " << filename_ << " --> "<< std::endl;
     }
-    s_out.precision(coord_precision());
+    format_stream(s_out);
 
     if (is_boost_license_ == true)
     {
@@ -672,9 +958,23 @@ public:
          "</metadata>"
        << std::endl;
     } // is_license
+    style_classes_.clear();
+    if (css_classes_)
+    { // Name a class for each set of style attributes repeated by groups.
+      document_.count_styles(style_classes_, s_out);
+      style_classes_.name_classes();
+    }
+    s_out.pword(detail::style_classes_index()) = css_classes_ ? &style_classes_ : 0; // Used by g_element::write_open.
+    symbols_written_ = 0;
     write_css(s_out);// Defaults stylesheet, if any.
-    write_document(s_out); // write clip paths and all document elements.
+  } // void write_prolog(std::ostream& s_out)
+
+  void write_epilog(std::ostream& s_out)
+  { //! Write the .svg 'file' contents that follow the document elements, including any symbols of markers drawn while streaming.
+    write_symbols(s_out);
     s_out << "</svg>" << std::endl;   // close off svg tag.
+    s_out.pword(detail::style_classes_index()) = 0; // Classes are only for this document.
+    s_out.iword(detail::compact_paths_index()) = 0; // And so are compact paths.
   }
 
   void license(
@@ -913,15 +1213,65 @@ public:
   }
 
   clip_path_element& clip_path(const rect_element& rect, const std::string& id)
-  { //! Rectangle outside which 'painting' is 'clipped' so doesn't show.
+  { //! Rectangle outside which 'painting' is 'clipped' so doesn't show (replacing any with the same id, as when a plot is drawn again).
+    std::vector<clip_path_element> others; // (Elements can be copied, but not assigned.)
+    for (std::size_t i = 0; i != clip_paths_.size(); ++i)
+    {
+      if (clip_paths_[i].element_id != id)
+      {
+        others.push_back(clip_paths_[i]);
+      }
+    }
+    if (others.size() != clip_paths_.size())
+    {
+      clip_paths_.swap(others);
+    }
     clip_paths_.push_back(clip_path_element(id, rect));
     return clip_paths_[clip_paths_.size()-1]; //! \return Reference to @c clip_path_element.
   }
 
+  const std::string* marker_id(const std::string& key)
+  { /*! \return Pointer to id of the symbol for the data-point marker described by @c key, see @c markers,
+      "" if the marker is written in full, or null if not yet known.
+    */
+    std::map<std::string, std::string>::const_iterator it = marker_ids_.find(key);
+    return (it == marker_ids_.end()) ? 0 : &it->second;
+  }
+
+  symbol_element& add_marker_symbol(const std::string& key)
+  { //! Add a new (empty) symbol for the data-point marker described by @c key, with a unique id like "m0".
+    //! \return Reference to the symbol, to which to add the elements of the marker (drawn at the origin).
+    std::ostringstream id;
+    id << "m" << symbols_.size();
+    symbol_element* symbol = new symbol_element(id.str());
+    symbols_.push_back(symbol);
+    marker_ids_[key] = id.str();
+    return *symbol;
+  }
+
+  void inline_marker(const std::string& key)
+  { //! Note that the data-point marker described by @c key is to be written in full (because it is smaller),
+    //! removing the symbol just added for it (if not yet written).
+    std::string& id = marker_ids_[key];
+    if (!id.empty() && symbols_.size() > symbols_written_ && symbols_.children_.back().id() == id)
+    {
+      symbols_.children_.pop_back();
+    }
+    id = "";
+  }
+
+  void clear_markers()
+  { //! Remove all the symbols of data-point markers (before they are drawn again).
+    symbols_.clear();
+    marker_ids_.clear();
+    symbols_written_ = 0;
+  }
+
   g_element& add_g_element()
   { //! Add information about a group element to the document.
     //! Increments the size of the array @c children of child nodes @c svg_elements, size returned by @c g_element.size().
-    return document_.add_g_element(); //! \return Reference to the added group element @c add_g_element.
+    //! The group is on the heap, but its children are allocated from the arena if @c arena_on.
+    return document_.add_g_element().arena(arena_on_ ? &arena_ : 0); //! \return Reference to the added group element @c add_g_element.
   }
 
   g_element& gs(int i)
@@ -34,8 +34,12 @@
 using boost::svg::detail::limit_NaN;  // Handling of non-finite data values.
 
 #include <boost/svg_plot/detail/auto_axes.hpp>
+#include <boost/svg_plot/detail/value_span.hpp>
 // Provides variants for @c void boost::svg::scale_axis
 
+#include <algorithm> // for std::copy, std::fill and std::min.
+#include <iterator> // for std::iterator_traits.
+#include <type_traits> // for std::true_type.
 #include <vector>
 #include <ostream>
 #include <sstream>
@@ -68,6 +72,11 @@ namespace svg
    Member functions allow control of data-points markers and lines joining them,
    and their appearance, shape, color and size.\n
    data-points can include their value, and optionally uncertainty and number of degrees of freedom.\n
+   The values of data-points are always held as @c double s, used to draw them.
+   Only data-points that may have uncertainty or other information (for example, of type @c Meas or @c unc)
+   are also held as @c Meas, for uncertainty ellipses and value-labels.
+   Data-points of plain arithmetic types (like @c double, in a @c std::vector<double>)
+   are held as just @c doubles (8 bytes each), see @c detail::is_plain_value.\n
 
    Each data-series can have a title that can be shown on a legend-box with identifying symbols.
 */
@@ -75,9 +84,12 @@ class svg_1d_plot_series
 {
 public:
 //! \cond DETAIL
-  std::vector<Meas> series_; //!< Normal 'OK to plot' @c Meas data, values including uncertainty and timestamp.
+  std::vector<double> values_; //!< Values of normal 'OK to plot' data.
+  std::vector<Meas> series_; //!< Normal 'OK to plot' @c Meas data, values including uncertainty and timestamp (same order as values_), or empty if plain.
   //std::vector<unc<false> > series_; //!< Normal 'OK to plot' data values.
   std::vector<double> series_limits_; //!< 'limit' values: too big, too small or NaN.
+  value_span view_; //!< Values of a data-series that is a view of the caller's data, see @c svg_1d_plot::plot_view, or empty.
+  std::vector<std::size_t> view_order_; //!< Indices of normal values of a view, or empty if all are normal.
   // TODO should these be unc too?  Uncertainty info is meaningless, but timestamp, order etc are OK.
 
   std::string title_; //!< title of data-series (to show on legend using legend_style).
@@ -100,6 +112,8 @@ public:
   C end,
   const std::string& title = ""); // Title of plot data-series, for example:"Monday", "Tuesday"...
 
+  svg_1d_plot_series(value_span values, const std::string& title); // View of caller's data.
+
   // Forward declarations of Set functions for the plot series.
   svg_1d_plot_series& fill_color(const svg_color& col_); // Set fill color for plot point marker(s) (chainable).
   svg_1d_plot_series& stroke_color(const svg_color& col_); // Set stroke color for plot point marker(s) (chainable).
@@ -123,6 +137,18 @@ public:
   bool bezier_on(); // Get true if curve if to join data-points.
   size_t series_count(); // Get number of normal data-points in this data-series.
   size_t series_limits_count(); // Get number of 'at limits' data-points in this data-series.
+  bool plain() const; // true if data-series has only plain values, without uncertainty.
+
+//! \cond DETAIL
+  std::size_t values_size() const; // Number of normal values.
+  double value(std::size_t j) const; // Value of jth normal data-point.
+  Meas meas(std::size_t j) const; // jth data-point, with any uncertainty info.
+  unc<false> unc_value(std::size_t j) const; // jth data-point, with any uncertainty.
+  template <typename C>
+  void add_points(C begin, C end, std::true_type); // Plain values.
+  template <typename C>
+  void add_points(C begin, C end, std::false_type); // Values with uncertainty.
+//! \endcond
 }; // class svg_1d_plot_series
 
  /*! \class boost::svg::svg_1d_plot
@@ -311,14 +337,15 @@ public:
 //! \endcond
 
   // ------------------------------------------------------------------------
-  //! write() has two versions: to an @c std::ostream and to a file.
+  //! write() has three versions: to an @c std::ostream, to an @c output_sink and to a file.
   //! The stream version first clears all unnecessary data from the graph,
   //! builds the document tree, and then calls the write function for the root
   //! document node, which calls all other nodes through the Visitor pattern.
-  //! The file version opens an @c std::fstream, and calls the @c std::ostream version.
+  //! The file version opens an @c std::fstream, and calls the @c std::ostream version (as does the sink version).
   // ------------------------------------------------------------------------
   svg_1d_plot& write(const std::string& file); //!< Write an SVG plot to a file.
   svg_1d_plot& write(std::ostream& os); //!> Write an SVG plot to a stream.
+  svg_1d_plot& write(output_sink& sink); //!< Write an SVG plot directly to a sink, for example, a @c string_sink.
 
   // Declarations of several versions of function plot to add data-series (with defaults).
   template <typename T>
@@ -331,6 +358,21 @@ public:
   template <typename T, typename U>
   svg_1d_plot_series& plot(const T& begin, const T& end, const std::string& title = "", U functor = boost::svg::detail::double_1d_convert());
   // GCC seems to need functor to have trailing (), but MSVC does not.
+  svg_1d_plot_series& plot_view(value_span values, const std::string& title = ""); // View of caller's data, without copying.
+
+//! \cond DETAIL
+  template <typename T, typename U>
+  static svg_1d_plot_series make_series(T begin, T end, const std::string& title, U /* functor */, std::true_type)
+  { //! Plain data values (like @c double) are held as just @c double s, with no conversion.
+    return svg_1d_plot_series(begin, end, title);
+  }
+
+  template <typename T, typename U>
+  static svg_1d_plot_series make_series(T begin, T end, const std::string& title, U functor, std::false_type)
+  { //! Other data values are converted by functor to keep any uncertainty and other info.
+    return svg_1d_plot_series(boost::make_transform_iterator(begin, functor), boost::make_transform_iterator(end, functor), title);
+  }
+//! \endcond
 }; // class svg_1d_plot
 
 // End svg_1d_plot Member functions declarations.
@@ -380,6 +422,88 @@ line_style_(black, blank, 2, false, false) // Default line style, black, no fill
     >
   */
 
+  add_points(begin, end, detail::is_plain_value<typename std::iterator_traits<C>::value_type>());
+} // svg_plot_series constructor.
+
+/*!
+  Constructor for a data-series that is a view of the caller's values, see @c svg_1d_plot::plot_view.
+  \param values Values of data-points.
+  \param title Title of series of data values.
+  \details Only the 'at limit' values are copied, and an index of the normal values if there are any 'at limit'.
+*/
+svg_1d_plot_series::svg_1d_plot_series(value_span values, const std::string& title)
+  : svg_1d_plot_series(static_cast<const double*>(0), static_cast<const double*>(0), title)
+{
+  view_ = values;
+  unsigned char limits[detail::limit_block]; // 1 for 'at limit' values of a block.
+  for (std::size_t b = 0; b < values.size(); b += detail::limit_block)
+  {
+    const std::size_t n = (std::min)(detail::limit_block, values.size() - b);
+    std::fill(limits, limits + n, 0);
+    if (detail::limit_mask(values, b, n, limits) || !series_limits_.empty())
+    { // Index the normal values (all of them, once there are any 'at limit').
+      for (std::size_t i = b; i != b + n; ++i)
+      {
+        if (limits[i - b] != 0)
+        {
+          if (series_limits_.empty())
+          { // All values before are normal.
+            for (std::size_t j = 0; j != i; ++j)
+            {
+              view_order_.push_back(j);
+            }
+          }
+          series_limits_.push_back(values[i]); // 'limit' values: too big, too small or NaN.
+        }
+        else if (!series_limits_.empty())
+        {
+          view_order_.push_back(i);
+        }
+      }
+    }
+  }
+} // svg_1d_plot_series(value_span values, const std::string& title)
+
+template <typename C>
+void svg_1d_plot_series::add_points(C begin, C end, std::true_type)
+{ //! Sort plain data values into normal and 'at limit', held as just @c double s.
+  values_.assign(begin, end); // Converted to double.
+  // Move 'limit' values (too big, too small or NaN) to series_limits_, a block at a time, keeping the order of normal values.
+  unsigned char limits[detail::limit_block];
+  std::size_t kept = 0; // Normal 'OK to plot' data values.
+  for (std::size_t b = 0; b < values_.size(); b += detail::limit_block)
+  {
+    const std::size_t n = (std::min)(detail::limit_block, values_.size() - b);
+    std::fill(limits, limits + n, 0);
+    if (detail::limit_mask(&values_[b], n, limits))
+    {
+      for (std::size_t i = b; i != b + n; ++i)
+      {
+        if (limits[i - b] != 0)
+        {
+          series_limits_.push_back(values_[i]);
+        }
+        else
+        {
+          values_[kept++] = values_[i];
+        }
+      }
+    }
+    else
+    { // All normal.
+      if (kept != b)
+      {
+        std::copy(values_.begin() + b, values_.begin() + b + n, values_.begin() + kept);
+      }
+      kept += n;
+    }
+  }
+  values_.resize(kept);
+} // add_points
+
+template <typename C>
+void svg_1d_plot_series::add_points(C begin, C end, std::false_type)
+{ //! Sort data values with uncertainty (or other) information into normal and 'at limit'.
   for(C i = begin; i != end; ++i)
   {  // Might be useful to have defaults for begin and end? But unclear how.
     //double temp = *i; // assume type is just double.
@@ -398,10 +522,11 @@ line_style_(black, blank, 2, false, false) // Default line style, black, no fill
     else
     {
       series_.push_back(temp); // Normal 'OK to plot' data values (including uncertainty info).
+      values_.push_back(temp.value());
       // Should copy name and other info too if applicable.
     }
   }
-} // svg_plot_series constructor.
+} // add_points
 
 // Definitions of svg_plot_series Member Functions to set up the plot colors, font, size, markers, lines etc.
 
@@ -507,7 +632,44 @@ bool svg_1d_plot_series::bezier_on()
 
 size_t svg_1d_plot_series::series_count()
 { //! \return Number of normal 'OK to plot' data values in data-series.
-  return series_.size();
+  return values_size();
+}
+
+std::size_t svg_1d_plot_series::values_size() const
+{ //! \return Number of normal 'OK to plot' data values.
+  if (!view_.empty())
+  {
+    return (view_order_.empty() && series_limits_.empty()) ? view_.size() : view_order_.size();
+  }
+  return values_.size();
+}
+
+double svg_1d_plot_series::value(std::size_t j) const
+{ //! \return Value of the jth normal data-point.
+  if (!view_.empty())
+  {
+    return view_[view_order_.empty() ? j : view_order_[j]];
+  }
+  return values_[j];
+}
+
+bool svg_1d_plot_series::plain() const
+{ //! \return @c true if the data-series has only plain values (like @c double), so no uncertainty or other information.
+  return series_.empty();
+}
+
+Meas svg_1d_plot_series::meas(std::size_t j) const
+{ //! \return jth data-point, with uncertainty and other info (just the value if the data-series is plain).
+  return plain() ? static_cast<Meas>(value(j)) : series_[j];
+}
+
+unc<false> svg_1d_plot_series::unc_value(std::size_t j) const
+{ //! \return jth data-point, with uncertainty (just the value if the data-series is plain).
+  if (plain())
+  {
+    return unc<false>(value(j));
+  }
+  return series_[j]; // Meas, without its timestamp and other info.
 }
 
 size_t svg_1d_plot_series::series_limits_count()
@@ -568,10 +730,9 @@ void svg_1d_plot::draw_plot_x_points()
     g_ptr_dps.text_style_.font_family_ = serieses_[i].point_style_.symbols_style_.font_family_;
     g_ptr_dps.alignment_ = align_style::center_align;
 
-    for (unsigned int j = 0; j < serieses_[i].series_.size(); ++j)
+    for (unsigned int j = 0; j < serieses_[i].values_size(); ++j)
     { // Draw jth point for ith serieses.
-      Meas ux = serieses_[i].series_[j];
-      double x = ux.value();
+      double x = serieses_[i].value(j);
       transform_x(x);
       float y_lift = static_cast<float>(serieses_[0].point_style_.size_ * 0.5);
       // Assume 1st data point marker size is representative of all marker, and line up on zeroth series.
@@ -588,12 +749,12 @@ void svg_1d_plot::draw_plot_x_points()
       if ((x >= plot_left_) && (x <= plot_right_)) // Check point is inside plot_window.
       // TODO May need a margin here to avoid points just over the window not being shown?
       {
-        draw_plot_point(x, y, g_ptr_dps, serieses_[i].point_style_, ux, uy); // Marker.
+        draw_plot_point(x, y, g_ptr_dps, serieses_[i].point_style_, serieses_[i].unc_value(j), uy); // Marker.
         // (Meas() default constructor sets Y-value and Y-uncertainty to zero for 1d X-values).
         if (x_values_on_)
         { // Show the X-value (& perhaps uncertainty and degrees of freedom) of the data-point too.
           g_element& g_ptr_v = image_.gs(detail::PLOT_X_POINT_VALUES).add_g_element();
-          draw_plot_point_value(x, y, g_ptr_v, x_values_style_, serieses_[i].point_style_, ux);
+          draw_plot_point_value(x, y, g_ptr_v, x_values_style_, serieses_[i].point_style_, serieses_[i].meas(j));
         }
         else
         { // Don't plot anything? Might leave a marker to show an "off the scale" value?
@@ -1056,8 +1217,16 @@ svg_1d_plot& svg_1d_plot::write(const std::string& file)
 {
   std::string filename(file); // Copy to avoid problems with const if need to append.
   if (filename.find(".svg") == std::string::npos)
-  { // No file type suffix, so provide the default .svg.
-    filename.append(".svg");
+  { // No file type suffix, so provide the default .svg (or .svgz).
+    filename.append(image_.compress_on() ? ".svgz" : ".svg");
+  }
+  if (detail::is_compressed(image_.compress_on(), filename))
+  { // Deflate while writing.
+    gzip_sink zout(filename); // Throws if unable to open.
+    image_.image_filename(filename);
+    svg_1d_plot::write(zout);
+    zout.close();
+    return *this;
   }
   std::ofstream fout(filename.c_str());
   if(fout.fail())
@@ -1105,6 +1274,17 @@ svg_1d_plot& svg_1d_plot::write(std::ostream& os)
   return (svg_1d_plot&) *this;
 } // write
 
+svg_1d_plot& svg_1d_plot::write(output_sink& sink)
+{ /*! Write SVG image directly to an @c output_sink, for example, appending to a @c std::string using a @c string_sink.
+    \param sink @c output_sink to write out the plot.
+    \return @c *this to make chainable.
+  */
+  std::ostream os(&sink);
+  svg_1d_plot::write(os); // Use the ostream version.
+  os.flush();
+  return *this;
+} // write(output_sink&)
+
 
  /*! Add a data-series to the plot (by default, converting to @c unc @c doubles), with optional data-series title.
 
@@ -1130,14 +1310,8 @@ svg_1d_plot& svg_1d_plot::write(std::ostream& os)
 template <typename T>
 svg_1d_plot_series& svg_1d_plot::plot(const T& container, const std::string& title /*= "" */)
 {
-  serieses_.push_back(
-    svg_1d_plot_series(
-    boost::make_transform_iterator(container.begin(), detail::meas_1d_convert()),
-    boost::make_transform_iterator(container.end(), detail::meas_1d_convert()),
-    //boost::make_transform_iterator(container.begin(), detail::unc_1d_convert<false>()),
-    //boost::make_transform_iterator(container.end(), detail::unc_1d_convert<false>()),
-    title)
-  );
+  serieses_.push_back(make_series(container.begin(), container.end(), title, detail::meas_1d_convert(),
+    detail::is_plain_value<typename T::value_type>())); // Plain values need no conversion.
   return serieses_[serieses_.size() - 1];
 } // plot(const T& container, const std::string& title)
 
@@ -1160,12 +1334,8 @@ my_1d_plot.plot(&my_data[1], &my_data[4], "my_data 1 to 4"); // Add part of data
   template <class T>  // \tparam T floating-point type of the data (T must be convertible to double).
 svg_1d_plot_series& svg_1d_plot::plot(const T& begin, const T& end, const std::string& title)
 {
-  serieses_.push_back(
-    svg_1d_plot_series(
-    boost::make_transform_iterator(begin, detail::unc_1d_convert<false>()),
-    boost::make_transform_iterator(end, detail::unc_1d_convert<false>()),
-    title)
-  );
+  serieses_.push_back(make_series(begin, end, title, detail::unc_1d_convert<false>(),
+    detail::is_plain_value<typename std::iterator_traits<T>::value_type>())); // Plain values need no conversion.
   /*!
     */
   return serieses_[serieses_.size() - 1]; // Reference to data-series just added.
@@ -1219,6 +1389,25 @@ svg_1d_plot_series& svg_1d_plot::plot(const T& begin, const T& end, const std::s
   return serieses_[serieses_.size() - 1];
 } // plot
 
+/*!
+   \brief Add a data-series that is a view of the caller's values, for example, a column array:
+    \code
+my_1d_plot.plot_view(my_data, "My data"); // std::vector<double> my_data; or double my_data[1000];
+my_1d_plot.plot_view(value_span(samples.data(), samples.size(), &sample::volts), "volts"); // Members of an array of structs.
+    \endcode
+    \details The values are not copied, but read when the plot is drawn (by @c write),
+    so they must remain unchanged (and vectors unresized) until then.
+    Only any 'at limit' values are copied (with an index of the normal values).
+    \param values Values of data-points.
+    \param title Title of data-series.
+    \return Reference to data-series just added (to make chainable).
+*/
+svg_1d_plot_series& svg_1d_plot::plot_view(value_span values, const std::string& title)
+{
+  serieses_.push_back(svg_1d_plot_series(values, title));
+  return serieses_[serieses_.size() - 1];
+} // plot_view
+
 } // namespace svg
 } // namespace boost
 
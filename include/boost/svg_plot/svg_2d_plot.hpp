@@ -44,11 +44,18 @@
 #include <boost/svg_plot/detail/numeric_limits_handling.hpp>
 #include <boost/svg_plot/detail/functors.hpp>
 #include <boost/svg_plot/detail/auto_axes.hpp>
+#include <boost/svg_plot/detail/value_span.hpp>
+#include <boost/svg_plot/detail/downsample.hpp>
 
+#include <algorithm> // for stable_sort
+#include <deque> // for min and max of live data-series.
 #include <map> // for map & multimap
+#include <memory> // for unique_ptr of the layers held while streaming.
 #include <string>
 #include <sstream>
+#include <type_traits> // for std::true_type.
 #include <utility>
+#include <vector>
 #include <ostream>
 #include <iterator>
 #include <exception>
@@ -71,6 +78,21 @@ namespace boost
     class svg_2d_plot; // 2D Plot framework.
     class svg_2d_plot_series; // One series of 2D data values to plot.
 
+    /*! \brief Tag type of @c assume_sorted.
+    */
+    struct assume_sorted_tag
+    {
+    };
+
+    /*! \brief Tag for @c svg_2d_plot::plot by which the caller guarantees that data-points are in ascending order of X,
+      so need neither be sorted, nor checked, for example:
+      \code
+my_plot.plot(my_time_series, "Readings", assume_sorted);
+      \endcode
+      If they are not in order, any line joining them goes back and forth in the order presented.
+    */
+    const assume_sorted_tag assume_sorted = assume_sorted_tag();
+
  /*!  \class boost::svg::svg_2d_plot_series
       \brief Holds a series of 2D data values (points) to be plotted.
 
@@ -83,9 +105,23 @@ namespace boost
 
        Each data-series can have a title that can be shown on a legend box with identifying symbols.
 
-        @c std::multimap is used rather than @c std::vector of @c std::pair s because
-        @c std::multimap sorts and ensures that lines joining data-points
+        Data-points are held in a contiguous @c std::vector of @c std::pair s,
+        sorted on X (once, when the data-series is constructed) so that lines joining data-points
         are unaffected by the order in which data is presented.
+        The sort is stable, so that data-points with the same X value are in the order presented,
+        as if inserted into a @c std::multimap (as used previously), but with much less memory and time.
+        Data-points already in ascending order of X (as most time-series are) are found to be so
+        as they are added, and not sorted, so that they are added in linear time
+        (or the caller can guarantee the order, see @c assume_sorted).\n
+        The X and Y values of the data-points are always held as @c double s, used to draw them.
+        Only data-points that may have uncertainty or other information (for example, of type @c Meas or @c unc)
+        are also held as @c Meas and @c unc, for uncertainty ellipses and value-labels.
+        Data-points of plain arithmetic types (like @c double, in a @c std::map<double, double>)
+        are held as just @c doubles (16 bytes each), see @c detail::is_plain_value.\n
+        Data-points of plain values can be appended by @c push_back, and a live data-series
+        (for example, of a rolling dashboard) holds only the most recent data-points, up to its @c capacity,
+        in a ring buffer, so that adding a data-point and dropping the oldest take constant time,
+        as does finding the minimum and maximum X and Y values to autoscale, see @c x_min_max.
        (For 1-D a vector of doubles can be used).
    */
     using boost::quan::Meas;
@@ -99,9 +135,29 @@ namespace boost
     public:
 //! \cond DETAIL
       // 2-D data-series points to plot.
-      std::multimap<Meas, unc<false> > series_; //!< Normal 'OK to plot' data values.
+      typedef std::vector<std::pair<Meas, unc<false> > > series_type; //!< Data-points, sorted on X.
+      typedef std::vector<std::pair<double, double> > values_type; //!< X and Y values of data-points, sorted on X.
+      typedef std::vector<std::pair<double, double> > limits_type; //!< 'limit' data-points, sorted on X.
+      values_type values_; //!< X and Y values of normal 'OK to plot' data-points.
+      series_type series_; //!< Normal 'OK to plot' data values with uncertainty info (same order as values_), or empty if plain.
     //     std::multimap<unc<false>, unc<false>> series_; //!< Normal 'OK to plot' data values.
-      std::multimap<double, double> series_limits_; //!< 'limit' values: too big or small, or NaN.
+      limits_type series_limits_; //!< 'limit' values: too big or small, or NaN.
+      bool view_; //!< true if the data-points are the caller's, see @c svg_2d_plot::plot_view (then values_ and series_ are empty).
+      value_span x_view_; //!< X values of a view.
+      value_span y_view_; //!< Y values of a view.
+      value_span y_sd_view_; //!< Y standard deviations of a view, or empty.
+      std::vector<std::size_t> view_order_; //!< Indices of normal data-points of a view in X order, or empty if all are normal and in order.
+      std::size_t capacity_; //!< Most data-points held by a live data-series, or 0 if unlimited, see @c capacity.
+      std::size_t first_; //!< Index in values_ of the oldest data-point of a full live data-series (else 0).
+      std::size_t limits_first_; //!< Index in series_limits_ of the oldest 'at limit' data-point of a full live data-series.
+      std::size_t changes_; //!< Count of changes to data-points, so that a plot can tell if the data-series must be drawn again.
+      typedef std::deque<std::pair<std::size_t, double> > window_type; //!< Sequence numbers and values of candidates for minimum or maximum.
+      bool tracked_; //!< true if the minimum and maximum X and Y values are maintained as data-points are pushed.
+      std::size_t pushed_; //!< Sequence number of the next normal data-point pushed.
+      window_type x_mins_; //!< Candidates for minimum X value, oldest (and the minimum) first.
+      window_type x_maxs_; //!< Candidates for maximum X value.
+      window_type y_mins_; //!< Candidates for minimum Y value.
+      window_type y_maxs_; //!< Candidates for maximum Y value.
 
       std::string title_; //!< Title of data-series (to show on legend using legend style).
       plot_point_style point_style_; //!< data-point marker like circle, square...
@@ -110,6 +166,9 @@ namespace boost
       plot_line_style line_style_; //!< Style (color, width...) of line joining data-points.
       bar_style bar_style_; //!< Style of bar used in histograms.
       histogram_style histogram_style_; //!< Style of histogram.
+      downsample_option downsample_; //!< Which data-points (of a long data-series) are drawn, see @c downsample.
+      std::size_t downsample_points_; //!< Number of data-points drawn if downsampled by @c lttb.
+      std::vector<std::size_t> drawn_; //!< Indices (in X order) of the normal data-points drawn if downsampled by @c lttb, else empty if all are.
 //! \endcond
 
       /*
@@ -118,12 +177,16 @@ namespace boost
         \param begin Starting iterator into container of data-series begin() to start at the beginning.
         \param end Ending iterator into container of data-series, end() to finish with the last item.
         \param title Title for the plot.
+        \param sorted true if the caller guarantees that data-points are in ascending order of X.
        */
        template <typename T>
        svg_2d_plot_series(
         T begin,
         T end,
-        std::string title = "");
+        std::string title = "",
+        bool sorted = false);
+
+       svg_2d_plot_series(value_span x, value_span y, value_span y_sd, std::string title); // View of caller's data.
       // Function declarations only - definitions below).
       // Set functions for the plot series.
       svg_2d_plot_series& fill_color(const svg_color& col_);
@@ -147,6 +210,9 @@ namespace boost
       svg_2d_plot_series& bar_color(const svg_color&);
       svg_2d_plot_series& bar_area_fill(const svg_color&);
       svg_2d_plot_series& histogram(histogram_option);
+      svg_2d_plot_series& downsample(downsample_option, std::size_t points = 0); // Draw only some data-points of a long data-series.
+      svg_2d_plot_series& capacity(std::size_t n); // Hold only the n most recent data-points.
+      svg_2d_plot_series& push_back(double x, double y); // Append a data-point.
 
       const std::string point_font_family();
       const std::string point_font_weight();
@@ -168,9 +234,40 @@ namespace boost
       double bar_width();
       svg_color& bar_color();
       svg_color& bar_area_fill();
+      downsample_option downsample();
+      std::size_t downsample_points();
       int values_count(); // Number of normal values in data-series.
       int limits_count(); // Number of values 'at limit' in data-series.
+      bool plain() const; // true if data-series has only plain values, without uncertainty.
+      std::size_t capacity(); // Most data-points held by a live data-series, or 0.
+      std::pair<double, double> x_min_max() const; // Minimum and maximum X values of normal data-points.
+      std::pair<double, double> y_min_max() const; // Minimum and maximum Y values of normal data-points.
+
+//! \cond DETAIL
+      std::size_t values_size() const; // Number of normal data-points.
+      double x_value(std::size_t j) const; // X value of jth (in X order) normal data-point.
+      double y_value(std::size_t j) const; // Y value of jth normal data-point.
+      void values(std::size_t first, std::size_t n, double* x, double* y) const; // X and Y values of n normal data-points from first.
+      void select_drawn(); // Choose the data-points drawn (if downsampled).
+      std::size_t drawn_size() const; // Number of normal data-points drawn.
+      std::size_t drawn_index(std::size_t j) const; // Index (in X order) of jth normal data-point drawn.
+      void drawn_values(std::size_t first, std::size_t n, double* x, double* y) const; // X and Y values of n data-points drawn from first.
+      Meas x_meas(std::size_t j) const; // X of jth data-point, with any uncertainty info.
+      unc<false> x_unc(std::size_t j) const; // X of jth data-point, with any uncertainty.
+      unc<false> y_unc(std::size_t j) const; // Y of jth data-point, with any uncertainty.
+      template <typename T>
+      void add_points(T begin, T end, bool sorted, std::true_type); // Plain values.
+      template <typename T>
+      void add_points(T begin, T end, bool sorted, std::false_type); // Values with uncertainty.
+      void track(); // Start maintaining minimum and maximum values.
+      void slide(window_type& w, double v, bool minimum); // Add v to window of candidates.
 
+      template <class Pair>
+      static bool x_less(const Pair& a, const Pair& b)
+      { //! Compare X values of data-points (as @c std::multimap compares its keys).
+        return a.first < b.first;
+      }
+//! \endcond
    }; // class svg_2d_plot_series
 
    // svg_2d_plot_series Member Functions Definitions.
@@ -188,9 +285,12 @@ namespace boost
   svg_2d_plot_series::svg_2d_plot_series(
       T begin, // \param iterator std::begin of data-series.
       T end, // \param End of data-series.
-      std::string title  // \param @c std::string title Title of data-series.//
+      std::string title,  // \param @c std::string title Title of data-series.//
+      bool sorted // \param sorted @c true if the caller guarantees that data-points are in ascending order of X.
     )
     :
+    view_(false),
+    capacity_(0), first_(0), limits_first_(0), changes_(0), tracked_(false), pushed_(0),
     title_(title), //!< Title of a series of data values.
     // plot_point_style(const svg_color& fill = blank, const svg_color& stroke = black,
     // int size = 5, point_shape shape = circlet, const std::string& symbols = "x")
@@ -199,8 +299,138 @@ namespace boost
     line_style_(black, blank, 2, false, false), // Default line style, no fill, width 2, no line_on, no bezier.
     bar_style_(black, blank, 3, no_bar), // Default black, no fill, stick width 3, no bar.
     // -2 block to Y-axis, -1 stick to Y-axis, no_bar,  +1 stick to x_axis, -2 block to X-axis.
-    histogram_style_(no_histogram)
+    histogram_style_(no_histogram),
+    downsample_(no_downsample), downsample_points_(0)
   { // Constructor.
+    add_points(begin, end, sorted, detail::is_plain_value<typename std::iterator_traits<T>::value_type>());
+    std::stable_sort(series_limits_.begin(), series_limits_.end(), x_less<limits_type::value_type>);
+  } // svg_2d_plot_series
+
+  /*!
+    Constructor for a data-series that is a view of the caller's data-points, see @c svg_2d_plot::plot_view.
+    \param x X values of data-points.
+    \param y Y values of data-points.
+    \param y_sd Standard deviations of Y values (for uncertainty ellipses and value-labels), or empty if none.
+    \param title Title for the plot.
+    \details Only the 'at limit' data-points are copied, and an index of the normal data-points in X order
+      if they are not all normal and in order already.
+   */
+  svg_2d_plot_series::svg_2d_plot_series(value_span x, value_span y, value_span y_sd, std::string title)
+    : svg_2d_plot_series(static_cast<const std::pair<double, double>*>(0), static_cast<const std::pair<double, double>*>(0), title)
+  {
+    if ((y.size() != x.size()) || (!y_sd.empty() && (y_sd.size() != x.size())))
+    {
+      throw std::runtime_error("plot_view: X and Y (and any Y standard deviation) values must be the same size!");
+    }
+    view_ = true;
+    x_view_ = x;
+    y_view_ = y;
+    y_sd_view_ = y_sd;
+    unsigned char limits[detail::limit_block]; // 1 for 'at limit' data-points of a block.
+    auto classify = [&](std::size_t b, std::size_t n)
+    { // Mark the 'at limit' data-points of the block from b.
+      std::fill(limits, limits + n, 0);
+      bool x_limits = detail::limit_mask(x, b, n, limits);
+      return detail::limit_mask(y, b, n, limits) || x_limits;
+    };
+    bool in_order = true; // Normal data-points in ascending order of X.
+    double last_x = -std::numeric_limits<double>::infinity(); // X of the last normal data-point.
+    for (std::size_t b = 0; b < x.size(); b += detail::limit_block)
+    {
+      const std::size_t n = (std::min)(detail::limit_block, x.size() - b);
+      if (classify(b, n))
+      {
+        for (std::size_t i = 0; i != n; ++i)
+        {
+          if (limits[i] != 0)
+          {
+            series_limits_.push_back(std::make_pair(x[b + i], y[b + i]));
+          }
+          else
+          {
+            in_order = in_order && !(x[b + i] < last_x);
+            last_x = x[b + i];
+          }
+        }
+      }
+      else if (in_order)
+      { // All normal.
+        in_order = !(x[b] < last_x) && std::is_sorted(x.begin() + static_cast<std::ptrdiff_t>(b), x.begin() + static_cast<std::ptrdiff_t>(b + n));
+        last_x = x[b + n - 1];
+      }
+    }
+    std::stable_sort(series_limits_.begin(), series_limits_.end(), x_less<limits_type::value_type>);
+    if (!in_order || !series_limits_.empty())
+    { // Index the normal data-points, in X order, keeping data-points with the same X in the order presented.
+      view_order_.reserve(x.size() - series_limits_.size());
+      for (std::size_t b = 0; b < x.size(); b += detail::limit_block)
+      {
+        const std::size_t n = (std::min)(detail::limit_block, x.size() - b);
+        classify(b, n);
+        for (std::size_t i = 0; i != n; ++i)
+        {
+          if (limits[i] == 0)
+          {
+            view_order_.push_back(b + i);
+          }
+        }
+      }
+      if (!in_order)
+      {
+        std::stable_sort(view_order_.begin(), view_order_.end(),
+          [&x](std::size_t a, std::size_t b) { return x[a] < x[b]; });
+      }
+    }
+  } // svg_2d_plot_series(value_span x, value_span y, value_span y_sd, std::string title)
+
+  template <typename T>
+  void svg_2d_plot_series::add_points(T begin, T end, bool sorted, std::true_type)
+  { //! Sort plain data-points into normal and 'at-limit' series, held as just @c double s.
+    values_.assign(begin, end); // Converted to pairs of double.
+    // Move 'at limit' data-points (either x and/or y) to series_limits_, a block at a time, keeping the order of the others.
+    static_assert(sizeof(values_type::value_type) == 2 * sizeof(double), "X and Y values must be adjacent.");
+    unsigned char limits[detail::limit_block];
+    std::size_t kept = 0; // Normal data-points.
+    for (std::size_t b = 0; b < values_.size(); b += detail::limit_block)
+    {
+      const std::size_t n = (std::min)(detail::limit_block, values_.size() - b);
+      std::fill(limits, limits + n, 0);
+      if (detail::limit_mask(&values_[b].first, n, limits, 2))
+      {
+        for (std::size_t i = b; i != b + n; ++i)
+        {
+          if (limits[i - b] != 0)
+          {
+            series_limits_.push_back(values_[i]);
+          }
+          else
+          {
+            values_[kept++] = values_[i];
+          }
+        }
+      }
+      else
+      { // All normal.
+        if (kept != b)
+        {
+          std::copy(values_.begin() + b, values_.begin() + b + n, values_.begin() + kept);
+        }
+        kept += n;
+      }
+    }
+    values_.resize(kept);
+    // Data-points presented in ascending order of X are found so in one pass, without sorting.
+    bool in_order = sorted || std::is_sorted(values_.begin(), values_.end(), x_less<values_type::value_type>);
+    if (!in_order)
+    { // Sort once, keeping data-points with the same X in the order presented.
+      std::stable_sort(values_.begin(), values_.end(), x_less<values_type::value_type>);
+    }
+  } // add_points
+
+  template <typename T>
+  void svg_2d_plot_series::add_points(T begin, T end, bool sorted, std::false_type)
+  { //! Sort data-points with uncertainty (or other) information into normal and 'at-limit' series.
+    bool in_order = true; // Data-points presented in ascending order of X.
     for(T i = begin; i != end; ++i)
     { // Sort data-points into normal and 'at-limit' series.
       std::pair<Meas, unc<false> > temp = *i;
@@ -211,14 +441,24 @@ namespace boost
       std::pair<double, double> xy = std::make_pair<double, double>(ux.value(), uy.value());
       if(detail::pair_is_limit(xy))
       { // Either x and/or y data value is 'at-limit'.
-        series_limits_.insert(xy);
+        series_limits_.push_back(xy);
       }
       else
       { // Normal data values for both x and y.
-        series_.insert(temp);
+        in_order = sorted || (in_order && (series_.empty() || !x_less(temp, series_.back()))); // Found in one pass, without sorting.
+        series_.push_back(temp);
       }
     }
-  } // svg_2d_plot_series
+    if (!in_order)
+    { // Sort once, keeping data-points with the same X in the order presented.
+      std::stable_sort(series_.begin(), series_.end(), x_less<series_type::value_type>);
+    }
+    values_.reserve(series_.size());
+    for(series_type::const_iterator i = series_.begin(); i != series_.end(); ++i)
+    { // Values in the same order.
+      values_.push_back(std::make_pair(i->first.value(), i->second.value()));
+    }
+  } // add_points
 
   // Definitions of svg_2d_plot_series member functions.
 
@@ -446,12 +686,40 @@ svg_2d_plot_series& svg_2d_plot_series::line_color(const svg_color& col_)
     return *this; //! \return Reference to svg_2d_plot_series to make chainable.
   }
 
+  /*! \brief Set which data-points of a (very) long data-series are drawn.
+     \param opt_ @c no_downsample (default) to draw all data-points,
+     or @c m4 to draw the line joining data-points (but not a Bezier curve) only through the first, last, minimum and maximum
+     of the data-points in each pixel column of the plot window, so that it looks the same,
+     but has at most 4 points for each pixel column (for example, a few thousand, rather than millions),
+     and markers (if any) for all data-points,
+     or @c lttb to draw (as line and/or markers and bars) only points data-points chosen to keep the shape of the data-series,
+     see @c detail::lttb_select.
+     \param points Number of data-points drawn by @c lttb (at least 3, else all are drawn).
+     \details For example: @c my_series.downsample(lttb, 1000); Histograms are never downsampled.
+  */
+  svg_2d_plot_series& svg_2d_plot_series::downsample(downsample_option opt_, std::size_t points)
+  {
+    downsample_ = opt_;
+    downsample_points_ = points;
+    return *this; //! \return Reference to svg_2d_plot_series to make chainable.
+  }
+
+  downsample_option svg_2d_plot_series::downsample()
+  { //! \return Which data-points of the data-series are drawn.
+    return downsample_;
+  }
+
+  std::size_t svg_2d_plot_series::downsample_points()
+  { //! \return Number of data-points drawn if downsampled by @c lttb.
+    return downsample_points_;
+  }
+
   //! \return number of normal values in a data-series.
     // Assume can never have more than @c max_int values in the data-series.
     // Or could return size_t rather than int?
   int svg_2d_plot_series::values_count()
   { 
-    return static_cast<int>(series_.size());
+    return static_cast<int>(values_size());
   }
 
   //! \return number of values 'at limit' in a data-series.
@@ -460,6 +728,307 @@ svg_2d_plot_series& svg_2d_plot_series::line_color(const svg_color& col_)
     return static_cast<int>(series_limits_.size());
   }
 
+  bool svg_2d_plot_series::plain() const
+  { //! \return @c true if the data-series has only plain values (like @c double), so no uncertainty or other information.
+    return series_.empty() && y_sd_view_.empty();
+  }
+
+  std::size_t svg_2d_plot_series::values_size() const
+  { //! \return Number of normal 'OK to plot' data-points.
+    if (view_)
+    {
+      return (view_order_.empty() && series_limits_.empty()) ? x_view_.size() : view_order_.size();
+    }
+    return values_.size();
+  }
+
+  double svg_2d_plot_series::x_value(std::size_t j) const
+  { //! \return X value of the jth normal data-point (in X order).
+    if (view_)
+    {
+      return x_view_[view_order_.empty() ? j : view_order_[j]];
+    }
+    std::size_t k = first_ + j; // Oldest first, if a full live data-series.
+    return values_[k < values_.size() ? k : k - values_.size()].first;
+  }
+
+  double svg_2d_plot_series::y_value(std::size_t j) const
+  { //! \return Y value of the jth normal data-point (in X order).
+    if (view_)
+    {
+      return y_view_[view_order_.empty() ? j : view_order_[j]];
+    }
+    std::size_t k = first_ + j;
+    return values_[k < values_.size() ? k : k - values_.size()].second;
+  }
+
+  void svg_2d_plot_series::values(std::size_t first, std::size_t n, double* x, double* y) const
+  { //! Copy the X and Y values of n normal data-points, from the first (in X order), as @c x_value and @c y_value, but a block at a time.
+    if (view_)
+    {
+      if (view_order_.empty())
+      { // All in order.
+        for (std::size_t j = 0; j != n; ++j)
+        {
+          x[j] = x_view_[first + j];
+          y[j] = y_view_[first + j];
+        }
+      }
+      else
+      {
+        for (std::size_t j = 0; j != n; ++j)
+        {
+          x[j] = x_view_[view_order_[first + j]];
+          y[j] = y_view_[view_order_[first + j]];
+        }
+      }
+      return;
+    }
+    std::size_t k = first_ + first; // Oldest first, if a full live data-series.
+    if (k >= values_.size())
+    {
+      k -= values_.size();
+    }
+    for (std::size_t j = 0; j != n; ++j)
+    {
+      x[j] = values_[k].first;
+      y[j] = values_[k].second;
+      if (++k == values_.size())
+      {
+        k = 0;
+      }
+    }
+  } // void values
+
+  void svg_2d_plot_series::select_drawn()
+  { //! Choose the normal data-points drawn, if downsampled by @c lttb (from the data-points now held).
+    if (downsample_ == lttb)
+    {
+      detail::lttb_select(*this, values_size(), downsample_points_, drawn_);
+    }
+    else
+    {
+      drawn_.clear();
+    }
+  }
+
+  std::size_t svg_2d_plot_series::drawn_size() const
+  { //! \return Number of normal data-points drawn (all unless downsampled by @c lttb).
+    return drawn_.empty() ? values_size() : drawn_.size();
+  }
+
+  std::size_t svg_2d_plot_series::drawn_index(std::size_t j) const
+  { //! \return Index (in X order, as for @c x_value) of the jth normal data-point drawn.
+    return drawn_.empty() ? j : drawn_[j];
+  }
+
+  void svg_2d_plot_series::drawn_values(std::size_t first, std::size_t n, double* x, double* y) const
+  { //! Copy the X and Y values of n normal data-points drawn, from the first, as @c values.
+    if (drawn_.empty())
+    {
+      values(first, n, x, y);
+      return;
+    }
+    for (std::size_t j = 0; j != n; ++j)
+    {
+      values(drawn_[first + j], 1, x + j, y + j);
+    }
+  }
+
+  Meas svg_2d_plot_series::x_meas(std::size_t j) const
+  { //! \return X of the jth data-point, with uncertainty and other info (just the value if the data-series is plain).
+    return series_.empty() ? static_cast<Meas>(x_value(j)) : series_[j].first;
+  }
+
+  unc<false> svg_2d_plot_series::x_unc(std::size_t j) const
+  { //! \return X of the jth data-point, with uncertainty (just the value if the data-series is plain).
+    if (series_.empty())
+    {
+      return unc<false>(x_value(j));
+    }
+    return series_[j].first; // Meas, without its timestamp and other info.
+  }
+
+  unc<false> svg_2d_plot_series::y_unc(std::size_t j) const
+  { //! \return Y of the jth data-point, with uncertainty (just the value if the data-series is plain).
+    if (!y_sd_view_.empty())
+    {
+      return unc<false>(y_value(j), static_cast<float>(y_sd_view_[view_order_.empty() ? j : view_order_[j]]));
+    }
+    return series_.empty() ? unc<false>(y_value(j)) : series_[j].second;
+  }
+
+  /*!
+    Make a live data-series, that holds only the n most recent data-points added by @c push_back,
+    dropping the oldest as each is added once full (and any more than n now), for example:
+    \code
+svg_2d_plot_series& live = my_plot.plot(std::vector<std::pair<double, double> >(), "Readings").capacity(1000);
+live.push_back(t, volts); // Every second, say.
+my_plot.xy_autoscale(live).write(os);
+    \endcode
+    At most n 'at limit' data-points are held too.
+    \param n Most data-points held, or 0 to hold all (the default).
+    \note Only a data-series of plain values (not a view, nor with uncertainty) can be live.
+  */
+  svg_2d_plot_series& svg_2d_plot_series::capacity(std::size_t n)
+  {
+    if (view_ || !series_.empty())
+    {
+      throw std::runtime_error("capacity: only a data-series of plain values (not a view, nor with uncertainty) can be live!");
+    }
+    // Put the data-points oldest first, then drop any more than n.
+    std::rotate(values_.begin(), values_.begin() + first_, values_.end());
+    std::rotate(series_limits_.begin(), series_limits_.begin() + limits_first_, series_limits_.end());
+    first_ = 0;
+    limits_first_ = 0;
+    if ((n != 0) && (values_.size() > n))
+    {
+      values_.erase(values_.begin(), values_.end() - n);
+    }
+    if ((n != 0) && (series_limits_.size() > n))
+    {
+      series_limits_.erase(series_limits_.begin(), series_limits_.end() - n);
+    }
+    capacity_ = n;
+    tracked_ = false; // Find minimum and maximum of the data-points held again.
+    track();
+    ++changes_;
+    return *this; //! \return Reference to svg_2d_plot_series to make chainable.
+  }
+
+  std::size_t svg_2d_plot_series::capacity()
+  { //! \return Most data-points held by a live data-series, or 0 if all are held.
+    return capacity_;
+  }
+
+  /*!
+    Append a data-point (in constant time, dropping the oldest if a live data-series is full, see @c capacity).
+    \param x X value of data-point.
+    \param y Y value of data-point.
+    \details Data-points are kept in the order pushed, which should be ascending order of X,
+      as for @c assume_sorted.
+  */
+  svg_2d_plot_series& svg_2d_plot_series::push_back(double x, double y)
+  {
+    if (view_ || !series_.empty())
+    {
+      throw std::runtime_error("push_back: data-points can only be added to a data-series of plain values (not a view, nor with uncertainty)!");
+    }
+    track();
+    ++changes_;
+    std::pair<double, double> xy(x, y);
+    if (detail::pair_is_limit(xy))
+    { // Either x and/or y data value is 'at-limit'.
+      if ((capacity_ == 0) || (series_limits_.size() < capacity_))
+      {
+        series_limits_.push_back(xy);
+      }
+      else
+      { // Full, so replace the oldest.
+        series_limits_[limits_first_] = xy;
+        limits_first_ = (limits_first_ + 1 == capacity_) ? 0 : limits_first_ + 1;
+      }
+      return *this;
+    }
+    if ((capacity_ == 0) || (values_.size() < capacity_))
+    {
+      values_.push_back(xy);
+    }
+    else
+    { // Full, so replace the oldest.
+      values_[first_] = xy;
+      first_ = (first_ + 1 == capacity_) ? 0 : first_ + 1;
+    }
+    slide(x_mins_, x, true);
+    slide(x_maxs_, x, false);
+    slide(y_mins_, y, true);
+    slide(y_maxs_, y, false);
+    ++pushed_;
+    return *this; //! \return Reference to svg_2d_plot_series to make chainable.
+  }
+
+  void svg_2d_plot_series::track()
+  { //! Start maintaining the minimum and maximum X and Y values of the data-points held, if not already.
+    if (tracked_)
+    {
+      return;
+    }
+    x_mins_.clear();
+    x_maxs_.clear();
+    y_mins_.clear();
+    y_maxs_.clear();
+    pushed_ = 0;
+    tracked_ = true;
+    for (std::size_t j = 0; j != values_.size(); ++j)
+    { // Oldest first (as capacity has put them).
+      slide(x_mins_, values_[j].first, true);
+      slide(x_maxs_, values_[j].first, false);
+      slide(y_mins_, values_[j].second, true);
+      slide(y_maxs_, values_[j].second, false);
+      ++pushed_;
+    }
+  }
+
+  void svg_2d_plot_series::slide(window_type& w, double v, bool minimum)
+  { /*! Add value v of the data-point just pushed to the window w of candidates for the minimum (or maximum)
+      of the data-points held, dropping candidates that are newer and no smaller (or larger), so can never be it,
+      and any older than the oldest held, so that the front of w is the minimum (or maximum),
+      in amortized constant time.
+    */
+    while (!w.empty() && (minimum ? !(w.back().second < v) : !(v < w.back().second)))
+    {
+      w.pop_back();
+    }
+    w.push_back(std::make_pair(pushed_, v));
+    std::size_t held = (std::min)(values_.size(), pushed_ + 1); // (Fewer while tracking those already held.)
+    std::size_t oldest = pushed_ + 1 - held; // Sequence number of the oldest held.
+    while (w.front().first < oldest)
+    {
+      w.pop_front();
+    }
+  }
+
+  std::pair<double, double> svg_2d_plot_series::x_min_max() const
+  { /*! \return Minimum and maximum X values of the normal data-points, to autoscale, for example:
+      @c my_plot.x_autoscale(series.x_min_max()),
+      in constant time once any data-points have been pushed, see @c push_back.
+    */
+    if (values_size() == 0)
+    {
+      throw std::runtime_error("x_min_max: data-series has no normal data-points!");
+    }
+    if (tracked_)
+    {
+      return std::make_pair(x_mins_.front().second, x_maxs_.front().second);
+    }
+    std::pair<double, double> mm(x_value(0), x_value(0));
+    for (std::size_t j = 1; j != values_size(); ++j)
+    {
+      mm.first = (std::min)(mm.first, x_value(j));
+      mm.second = (std::max)(mm.second, x_value(j));
+    }
+    return mm;
+  }
+
+  std::pair<double, double> svg_2d_plot_series::y_min_max() const
+  { //! \return Minimum and maximum Y values of the normal data-points, to autoscale (see @c x_min_max).
+    if (values_size() == 0)
+    {
+      throw std::runtime_error("y_min_max: data-series has no normal data-points!");
+    }
+    if (tracked_)
+    {
+      return std::make_pair(y_mins_.front().second, y_maxs_.front().second);
+    }
+    std::pair<double, double> mm(y_value(0), y_value(0));
+    for (std::size_t j = 1; j != values_size(); ++j)
+    {
+      mm.first = (std::min)(mm.first, y_value(j));
+      mm.second = (std::max)(mm.second, y_value(j));
+    }
+    return mm;
+  }
+
   // End svg_2d_plot_series Member Functions Definitions.
 
   //  class svg_2d_plot definitions.
@@ -604,6 +1173,10 @@ svg_2d_plot_series& svg_2d_plot_series::line_color(const svg_color& col_)
       bool x_values_on_; //!< @c true if values of X data are shown (as 1.23).
       bool y_values_on_; //!< @c true if values of Y data are shown (as 3.45).
       bool xy_values_on_; //!< @c true if values of X & Y pairs are shown (as 1.23, 3.43).
+      bool streaming_on_; //!< @c true if write() streams the data-point layers instead of building them all in the document tree.
+      bool incremental_on_; //!< @c true if update_image() draws the data-series layers again only if changed, see @c incremental_on.
+      std::vector<std::size_t> drawn_changes_; //!< Changes to each data-series when the data-series layers were last drawn.
+      std::vector<double> drawn_window_; //!< Plot window and scaling when the data-series layers were last drawn.
 
       int x_axis_position_; //!< Intersection with Y-axis, or not.
       int y_axis_position_; //!< Intersection with X-axis, or not.
@@ -807,6 +1380,8 @@ my_plot.background_color(ghostwhite) // Whole image.
         // Used to transform Cartesian to SVG.
         x_scale_(1.), x_shift_(0.),
         y_scale_(1.), y_shift_(0.),
+        streaming_on_(false), // Build the whole document tree before writing.
+        incremental_on_(false), // Draw all the image every write.
         x_axis_position_(0),
         y_axis_position_(0)
 
@@ -1954,10 +2529,34 @@ my_plot.background_color(ghostwhite) // Whole image.
         }
       } // bool is_in_window(double x, double y)
 
+      std::size_t transform_block(const svg_2d_plot_series& series, std::size_t first, double* x, double* y, unsigned char* where)
+      { /*! Transform the next block (up to @c detail::transform_block_size) of normal data-points of a data-series,
+            from the first (in X order), to SVG coordinates, as @c transform_point,
+            marking where each lies (@c detail::inside_window as drawn as a marker, and @c detail::near_window as @c is_in_window).
+            \return Number of data-points transformed.
+        */
+        const std::size_t n = (std::min)(detail::transform_block_size, series.drawn_size() - first);
+        series.drawn_values(first, n, x, y);
+        if (transform_values(x, y, n, margin_, where))
+        { // Some reached a limit when transformed.
+          for (std::size_t j = 0; j != n; ++j)
+          {
+            if ((where[j] & detail::was_limit) != 0)
+            {
+              adjust_limits(x[j], y[j]);
+              where[j] = where_in_window(x[j], y[j], margin_);
+            }
+          }
+        }
+        return n;
+      } // std::size_t transform_block
+
       // void draw_straight_lines(const svg_2d_plot_series& series);
 
-      //! Add line between series of data-points (straight rather than a Bezier curve).
+      //! Add line between series of data-points (straight rather than a Bezier curve),
+      //! clipped to the plot window (and its margin), so only the parts of lines seen are drawn.
       //! Area fill with color if specified.
+      //! Only some data-points are joined if the data-series is downsampled, see @c svg_2d_plot_series::downsample.
       void draw_straight_lines(const svg_2d_plot_series& series)
       {
         g_element& g_ptr = image_.gs(detail::PLOT_DATA_LINES).add_g_element();
@@ -1967,6 +2566,10 @@ my_plot.background_color(ghostwhite) // Whole image.
         g_ptr.style().stroke_width(series.line_style_.width_);
 
         path_element& path = g_ptr.path();
+        const bool decimate = (series.downsample_ == m4); // Keep only 4 data-points of each pixel column.
+        const std::size_t columns = static_cast<std::size_t>(plot_right_ - plot_left_ + 2 * margin_) + 2;
+        path.reserve(((decimate && (series.drawn_size() > 4 * columns)) ? 4 * columns : series.drawn_size()) + 3);
+        // One command per point, plus any area fill M, L & Z.
         path.style().fill_color(series.line_style_.area_fill_);
         bool is_fill = !series.line_style_.area_fill_.is_blank();
         path.style().fill_on(is_fill); // Ensure includes a fill="none" if no fill.
@@ -1976,129 +2579,175 @@ my_plot.background_color(ghostwhite) // Whole image.
         size_t inside_window = 0;  // OK data-points that lie inside the plot window.
 
         // If required to fill the area under the plot,
-        // we first have to move from the X-axis (y = 0) to the first point,
-        // and again to the X-axis (y = 0) at the end after the last point.
+        // we first have to move from the X-axis (y = 0) to the first point drawn,
+        // and again to the X-axis (y = 0) at the end after the last point drawn.
+        // Between, any line outside the window is replaced by a line along its edge (beyond the clip path, so not seen)
+        // so that the area filled is as if the whole line was drawn and then clipped.
 
-        if (series.series_.size() < 2)
+        if (series.drawn_size() < 2)
         { // Need at least two points for a line joining them.
-          std::cout << "Only " << series.series_.size() << " point in series " << series.title_ << ", so no line drawn!" << std::endl;
-          // Also need two points  *inside window*, but that is checked later.
+          std::cout << "Only " << series.drawn_size() << " point in series " << series.title_ << ", so no line drawn!" << std::endl;
         }
         else
         {
-          std::multimap<Meas, unc<false> >::const_iterator j = series.series_.begin();
-          //std::multimap<unc<false>, unc<false> >::const_iterator j = series.series_.begin();
-          // Using std::multimap<double, double> was prev_x = (*j).first;
-            // was unc<false> prev_ux = (*j).first; for unc rather than Meas
-
-          double prev_x = 0; // Previous X and
-          double prev_y = 0; // Y of a data point.
-          Meas prev_ux = (*j).first; // x
-          Meas prev_uy = (*j).second; // y
-          // Assigned to keep compiler quiet at line 1817 "warning C4701: potentially uninitialized local variable 'prev_x' used."
+          const double left = plot_left_ - margin_; // Window (and margin) that lines are clipped to.
+          const double top = plot_top_ - margin_;
+          const double right = plot_right_ + margin_;
+          const double bottom = plot_bottom_ + margin_;
           double y0 = 0.; // y = 0, so is start point for fill area on horizontal X-axis.
-
-          // Try to find a first point inside the plot window.
-          // It may not be the first point in the series.
-          while (j != series.series_.end())
+          transform_y(y0);
+          double block_x[detail::transform_block_size]; // SVG coordinates of a block of data-points.
+          double block_y[detail::transform_block_size];
+          unsigned char block_where[detail::transform_block_size]; // window_bits of each.
+          detail::m4_columns m4_kept; // If decimate, data-points kept of each pixel column,
+          double kept_x[detail::transform_block_size + 4]; // from each block.
+          double kept_y[detail::transform_block_size + 4];
+          unsigned char kept_where[detail::transform_block_size + 4];
+          const double* x = decimate ? kept_x : block_x; // data-points to draw lines between.
+          const double* y = decimate ? kept_y : block_y;
+          const unsigned char* where = decimate ? kept_where : block_where;
+          std::size_t points = 0; // data-points (kept) before this block.
+          double prev_x = 0; // Previous data-point.
+          double prev_y = 0;
+          unsigned char prev_where = 0;
+          bool started = false; // Path started (at the first part of a line inside the window).
+          bool at_prev = false; // Path is at the previous data-point (inside the window).
+          double last_x = 0.; // X of the last point of the path.
+          for (std::size_t first = 0; first != series.drawn_size();)
           {
-            prev_ux = (*j).first; // x
-            prev_uy = (*j).second; // y
-            prev_x = prev_ux.value(); // 1st point X-value.
-            prev_y = prev_uy.value(); // 1st point Y-value.
-#ifdef BOOST_SVG_VALUE_DIAGNOSTICS
-          std::cout << "1st value x = " << prev_x << ", value y = " << prev_y << "." << std::endl;
-#endif
-            transform_point(prev_x, prev_y);
-            //if ((prev_x < plot_left_) || (prev_x > plot_right_) || (prev_y < plot_top_) || (prev_y > plot_bottom_))
-            if (is_in_window(prev_x, prev_y) == false)
-            { // data-point is OUTside plot window, so can't draw a line from y = 0 to this point.
-              // so try the next point to see if that is 'good' - inside the window.
-#ifdef BOOST_SVG_VALUE_DIAGNOSTICS
-              std::cout << "1st x = " << prev_x << ", y = " << prev_y << " is outside plot window! " << std::endl;
-#endif // BOOST_SVG_VALUE_DIAGNOSTICS
-              ++outside_window;
-              ++j;
+            std::size_t n = transform_block(series, first, block_x, block_y, block_where);
+            first += n;
+            if (decimate)
+            { // In one pass, as each block is transformed.
+              n = m4_kept.add(block_x, block_y, block_where, n, kept_x, kept_y, kept_where);
+              if (first == series.drawn_size())
+              {
+                n += m4_kept.finish(kept_x + n, kept_y + n, kept_where + n);
+              }
             }
-            else
-            { // Point is inside plot window, so is usable as a 1st point.
-              ++inside_window;
-              if (is_fill == true)
-              { // Move to 1st point.
-                //path.style().fill_color(series.line_style_.area_fill_); // Duplicates so no longer needed?
-                transform_y(y0);
-                path.M(prev_x, y0); // Start on X-axis
-                path.L(prev_x, prev_y); // and draw line to 1st point.
-                // This is to ensure fill.
+            for (std::size_t j = 0; j != n; ++j)
+            {
+              if (!at_prev && (points + j != 0))
+              { // Skip a run of lines between data-points all beyond the same side of the window (as when zoomed in).
+                const std::size_t run = j;
+                while ((j != n) && ((prev_where & where[j] & detail::beyond_window) != 0))
+                {
+                  prev_where = where[j++];
+                }
+                outside_window += j - run;
+                if (j != run)
+                {
+                  prev_x = x[j - 1];
+                  prev_y = y[j - 1];
+                }
+                if (j == n)
+                {
+                  break;
+                }
+              }
+              const bool near = (where[j] & detail::near_window) != 0;
+              if (near)
+              {
+                ++inside_window;
               }
               else
               {
-                path.M(prev_x, prev_y);  // Just move to 1st good X point.
+                ++outside_window;
+#ifdef BOOST_SVG_DIAGNOSTICS
+                std::cout << "Line to x = " << x[j] << ", y = " << y[j] << " is outside plot window." << std::endl;
+#endif
               }
-
-              break;  // and continue drawing lines below in another while loop below.
-              // leaving j pointing to 2nd point.
-            }
-          } // while j != series_.end()
-          if (inside_window == 0)
+              double t0;
+              double t1;
+              if (at_prev)
+              { // Line from the previous data-point (inside the window).
+                if (near)
+                {
+                  path.L(x[j], y[j]);
+                  last_x = x[j];
+                }
+                else
+                { // Clip where it leaves the window.
+                  detail::clip_segment(prev_x, prev_y, x[j], y[j], left, top, right, bottom, t0, t1);
+                  last_x = prev_x + t1 * (x[j] - prev_x);
+                  path.L(last_x, prev_y + t1 * (y[j] - prev_y));
+                }
+              }
+              else if ((points + j != 0)
+                && detail::clip_segment(prev_x, prev_y, x[j], y[j], left, top, right, bottom, t0, t1))
+              { // Line from the previous data-point (outside) enters the window.
+                const double in_x = prev_x + t0 * (x[j] - prev_x);
+                const double in_y = prev_y + t0 * (y[j] - prev_y);
+                if (!started)
+                {
+                  if (is_fill)
+                  {
+                    path.M(in_x, y0).L(in_x, in_y); // Start on X-axis, and draw line to 1st point.
+                  }
+                  else
+                  {
+                    path.M(in_x, in_y);
+                  }
+                  started = true;
+                }
+                else if (is_fill)
+                { // Along the edge of the window (so unseen) from where the line left.
+                  path.L(in_x, in_y);
+                }
+                else
+                {
+                  path.M(in_x, in_y);
+                }
+                last_x = near ? x[j] : prev_x + t1 * (x[j] - prev_x);
+                path.L(last_x, near ? y[j] : prev_y + t1 * (y[j] - prev_y));
+              }
+              else if (near)
+              { // 1st data-point inside the window (or a line from outside that only just touches it).
+                if (!started)
+                {
+                  if (is_fill)
+                  {
+                    path.M(x[j], y0).L(x[j], y[j]);
+                  }
+                  else
+                  {
+                    path.M(x[j], y[j]);
+                  }
+                  started = true;
+                }
+                else if (is_fill)
+                {
+                  path.L(x[j], y[j]);
+                }
+                else
+                {
+                  path.M(x[j], y[j]);
+                }
+                last_x = x[j];
+              }
+              at_prev = near;
+              prev_x = x[j];
+              prev_y = y[j];
+              prev_where = where[j];
+            } // for j'th point of block
+            points += n;
+          }
+          if (!started)
           {
             std::cout << "No start point in series " << series.title_ << " is within plot window!" << std::endl;
             // So no point trying to draw a line!
             return;
           }
-          else
-          {
-#ifdef BOOST_SVG_DIAGNOSTICS
-            std::cout << "Found 1st point in plot window x = " << prev_x << ", y = " << prev_y << "." << std::endl;
-#endif
-          }
-
-          double temp_x(0.);
-          double temp_y;
-          for(; j != series.series_.end(); ++j)
-          {
-           // unc<false> temp_ux = (*j).first;
-            Meas temp_ux = (*j).first;
-            temp_x = temp_ux.value();
-            //unc<false> temp_uy = (*j).second;
-            Meas temp_uy = (*j).second;
-            temp_y = temp_uy.value();
-#ifdef BOOST_SVG_DIAGNOSTICS
-            //std::cout << "Line to x = " << temp_x << ", y = " << temp_y << "." << std::endl;
-#endif
-            transform_point(temp_x, temp_y);
-            if (is_in_window(temp_x, temp_y) == true)
-            //if ((temp_x >= plot_left_) && (temp_x <= plot_right_) && (temp_y >= plot_top_) && (temp_y <= plot_bottom_))
-            { // data-point is inside or on plot window, so draw a line to the point.
-              ++inside_window;
-              path.L(temp_x, temp_y); // Line to next point.
-              prev_x = temp_x;
-              prev_y = temp_y;
-            }
-            else
-            { // Ignore any data-point values outside the plot window.
-              // Not sure what this will do if area fill chosen.
-              ++outside_window;
-#ifdef BOOST_SVG_DIAGNOSTICS
-              std::cout << "Line draw ignoring  x = " << temp_x << ", y = " << temp_y << std::endl;
-#endif
-            }
-          } // for j'th point
-
-           BOOST_ASSERT(inside_window -1 + outside_window == series.series_.size());
-           // -1 for the point on the x axis needed for fill.
-
+          BOOST_ASSERT(inside_window + outside_window == points);
           if(is_fill == true)
           { // Area fill wanted.
-            temp_y = 0; // y = 0, so on horizontal X-axis.
-            transform_y(temp_y); // X-axis line SVG coordinate.
-            path.L(temp_x, temp_y).z(); // Draw line to X-axis & closepath with Z.
+            path.L(last_x, y0).z(); // Draw line to X-axis & closepath with Z.
             // to ensure area below is filled.
           }
         }
 #ifdef BOOST_SVG_DIAGNOSTICS
-            std::cout << "Draw_lines plotted " << inside_window << " lines, and outside window " << outside_window
-            << ", size of series = " << series.series_.size() << std::endl;
+            std::cout << "Draw_lines plotted " << inside_window << " points, and outside window " << outside_window
+            << ", size of series = " << series.drawn_size() << std::endl;
 #endif
       } // draw_straight_lines
 
@@ -2131,24 +2780,8 @@ my_plot.background_color(ghostwhite) // Whole image.
           path.style().fill_color(series.line_style_.area_fill_);
         }
 
-        if(series.series_.size() > 2)
+        if(series.drawn_size() > 2)
         { // Need >= 3 points for a cubic curve (start point, 2 control points, and end point).
-          std::multimap<Meas, unc<false> >::const_iterator iter = series.series_.begin();
- //         std::multimap<unc<false>, unc<false> >::const_iterator iter = series.series_.begin();
-          std::pair<Meas, unc<false> > un_minus_1 = *(iter++); // 1st unc X & Y data.
-//          std::pair<unc<false>, unc<false> > un_minus_1 = *(iter++); // 1st unc X & Y data.
-          n_minus_1 = std::make_pair(un_minus_1.first.value(), un_minus_1.second.value()); // X and Y values.
-          //n_minus_1 = *(iter++);  // begin()
-          transform_pair(n_minus_1);
-          // Should check that point is inside plot window. TODO?
-          {
-            std::pair<Meas, unc<false> > un = *(iter++); // Middle point of trio for bezier.
-            n = std::make_pair(un.first.value(), un.second.value()); // X and Y values.
-          }
-          transform_pair(n);
-          // Should check that point is inside plot window. TODO?
-          path.M(n_minus_1.first, n_minus_1.second); // move m_minus_1, the 1st data point.
-
           double control = 0.1;
           // 0.2 is a scaling factor that Jake used to define the magnitude of the
           // vector of the current control point to be placed, basically
@@ -2158,31 +2791,47 @@ my_plot.background_color(ghostwhite) // Whole image.
           // Experiment suggests that 0.2 gives distorsions with exp curves.
           // 0.05 is just visually OK with 50 points, but 100 are better.
 
-          for(; iter != series.series_.end(); ++iter)
+          double x[detail::transform_block_size]; // SVG coordinates of a block of data-points.
+          double y[detail::transform_block_size];
+          unsigned char where[detail::transform_block_size];
+          for (std::size_t first = 0; first != series.drawn_size();)
           {
-            n_minus_2 = n_minus_1;
-            n_minus_1 = n;
+            const std::size_t count = transform_block(series, first, x, y, where);
+            // Should check that points are inside plot window (where). TODO?
+            for (std::size_t j = 0; j != count; ++j)
             {
-              std::pair<Meas, unc<false> > un = *iter; // middle
-              n = std::make_pair(un.first.value(), un.second.value()); // X and Y values.
-            }
-            transform_pair(n);
-            // Should check that point is inside plot window. TODO?
-
-            back_vtr.first = ((n_minus_1.first - n.first) + // (x diff - x previous diff) * control
-              (n_minus_2.first - n_minus_1.first)) * control;
-            back_vtr.second = ((n_minus_1.second - n.second) + // y
-              (n_minus_2.second - n_minus_1.second)) * control;
-
-            // 8.3.6 The cubic Bezier curve commands path.S(x, y).
-            // Start point, end point, & two control points.
-            // Example: S378.5,519.3 381,519.3 ...
-            // S end_control_point, end point
-            // Start is reflection of last point's control point.
-            path.S(n_minus_1.first + back_vtr.first, // x
-              n_minus_1.second + back_vtr.second, // y - end control point
-              n_minus_1.first, n_minus_1.second); // x, y - end point.
-          } // for
+              if (first + j == 0)
+              { // 1st X and Y values.
+                n_minus_1 = std::make_pair(x[j], y[j]);
+                continue;
+              }
+              if (first + j == 1)
+              { // Middle point of trio for bezier.
+                n = std::make_pair(x[j], y[j]);
+                path.reserve(series.drawn_size()); // One command per point.
+                path.M(n_minus_1.first, n_minus_1.second); // move m_minus_1, the 1st data point.
+                continue;
+              }
+              n_minus_2 = n_minus_1;
+              n_minus_1 = n;
+              n = std::make_pair(x[j], y[j]); // middle
+
+              back_vtr.first = ((n_minus_1.first - n.first) + // (x diff - x previous diff) * control
+                (n_minus_2.first - n_minus_1.first)) * control;
+              back_vtr.second = ((n_minus_1.second - n.second) + // y
+                (n_minus_2.second - n_minus_1.second)) * control;
+
+              // 8.3.6 The cubic Bezier curve commands path.S(x, y).
+              // Start point, end point, & two control points.
+              // Example: S378.5,519.3 381,519.3 ...
+              // S end_control_point, end point
+              // Start is reflection of last point's control point.
+              path.S(n_minus_1.first + back_vtr.first, // x
+                n_minus_1.second + back_vtr.second, // y - end control point
+                n_minus_1.first, n_minus_1.second); // x, y - end point.
+            } // for j
+            first += count;
+          }
           // Last point.
           back_vtr.first = 0.;
           back_vtr.second = (n.second - n_minus_1.second) * control;
@@ -2233,54 +2882,60 @@ my_plot.background_color(ghostwhite) // Whole image.
           size_t plotted = 0;// Keep a count of how many points were actually displayed and
           size_t ignored = 0; // and how many were ignored because 'at limits'.
 
-          for(std::multimap<Meas, unc<false> >::const_iterator j = serieses_[i].series_.begin();
-        //  for(std::multimap<unc<false>, unc<false> >::const_iterator j = serieses_[i].series_.begin(); // unc, unc version.
-            j != serieses_[i].series_.end(); ++j)
+          const svg_2d_plot_series& series = serieses_[i];
+          if ((series.point_style_.shape_ == none) && !x_values_on_ && !y_values_on_ && !xy_values_on_)
+          { // No markers, nor value-labels, to draw (as for a long data-series drawn only as a line).
+            continue;
+          }
+          double xs[detail::transform_block_size]; // SVG coordinates of a block of data-points.
+          double ys[detail::transform_block_size];
+          unsigned char where[detail::transform_block_size];
+          for (std::size_t first = 0; first != series.drawn_size();)
           {
-            Meas ux = j->first;
-            //unc<false> ux = j->first;
-            double x(0.); // For conversion to SVG coordinates.
-            x = ux.value(); // To compute SVG coordinate from just the X value.
-            //double vx = x; // Note the true X value.
-            unc<false> uy = j->first;
-            uy = j->second;
-            double y(0.);
-            y = uy.value(); // To compute SVG coordinate from just the Y value.
-            //double vy = y; // Note the true Y value.
-            transform_point(x, y); // Note x and y are now SVG coordinates.
-            if((x > plot_left_) && (x < plot_right_) && (y > plot_top_) && (y < plot_bottom_))
-            { // data-point is inside plot-window, so draw a point marker.
-              plotted++;
-             // draw_plot_point(x, y, g_ptr_dps, not_a_plot_point_style, ux, uy); // not_a_plot_point_style means no marker
-              draw_plot_point(x, y, g_ptr_dps, serieses_[i].point_style_, ux, uy); // Add the unc ux and uy to allow access to uncertainty.
-              g_element& g_ptr_vx = image_.gs(detail::PLOT_X_POINT_VALUES).add_g_element();
-              if (x_values_on_)
-              { // Label with the value of the X-data-point too.
-                // void draw_plot_point_value(double x, double y, g_element& g_ptr, value_style& val_style, plot_point_style& point_style, double value)
-                draw_plot_point_value(x, y, g_ptr_vx, x_values_style_, serieses_[i].point_style_, ux);
-              }
-              g_element& g_ptr_vy = image_.gs(detail::PLOT_Y_POINT_VALUES).add_g_element();
-              if (y_values_on_)
-              { // Label the Y-value of the data-point too.
-                draw_plot_point_value(x, y, g_ptr_vy, y_values_style_,serieses_[i].point_style_, uy);
-              }
-              if (xy_values_on_)
-              { // Show both the two values of the X & Y data-point values as a pair on the same line.
-                draw_plot_point_values(x, y, g_ptr_vx, g_ptr_vy, x_values_style_, y_values_style_, ux, uy);
-              }
-            } // if inside plot window
-            else
-            { // Ignore any data-point values outside the plot window.
-              ignored++;
+            const std::size_t n = transform_block(series, first, xs, ys, where);
+            for(std::size_t j = first; j != first + n; ++j)
+            {
+              double x = xs[j - first]; // SVG coordinates.
+              double y = ys[j - first];
+              if((where[j - first] & detail::inside_window) != 0)
+              { // data-point is inside plot-window, so draw a point marker.
+                plotted++;
+                // Add the unc ux and uy to allow access to uncertainty (just the values for plain data-points).
+                const std::size_t k = series.drawn_index(j); // Index (in X order) of data-point.
+                unc<false> ux = series.x_unc(k);
+                unc<false> uy = series.y_unc(k);
+               // draw_plot_point(x, y, g_ptr_dps, not_a_plot_point_style, ux, uy); // not_a_plot_point_style means no marker
+                draw_plot_point(x, y, g_ptr_dps, serieses_[i].point_style_, ux, uy);
+                g_element& g_ptr_vx = image_.gs(detail::PLOT_X_POINT_VALUES).add_g_element();
+                if (x_values_on_)
+                { // Label with the value of the X-data-point too.
+                  // void draw_plot_point_value(double x, double y, g_element& g_ptr, value_style& val_style, plot_point_style& point_style, double value)
+                  draw_plot_point_value(x, y, g_ptr_vx, x_values_style_, serieses_[i].point_style_, series.x_meas(k));
+                }
+                g_element& g_ptr_vy = image_.gs(detail::PLOT_Y_POINT_VALUES).add_g_element();
+                if (y_values_on_)
+                { // Label the Y-value of the data-point too.
+                  draw_plot_point_value(x, y, g_ptr_vy, y_values_style_,serieses_[i].point_style_, uy);
+                }
+                if (xy_values_on_)
+                { // Show both the two values of the X & Y data-point values as a pair on the same line.
+                  draw_plot_point_values(x, y, g_ptr_vx, g_ptr_vy, x_values_style_, y_values_style_, series.x_meas(k), uy);
+                }
+              } // if inside plot window
+              else
+              { // Ignore any data-point values outside the plot window.
+                ignored++;
 #ifdef BOOST_SVG_POINT_DIAGNOSTICS
-              std::cout << "Ignoring x = " << x << ", y = " << y << std::endl;
+                std::cout << "Ignoring x = " << x << ", y = " << y << std::endl;
 #endif // BOOST_SVG_POINT_DIAGNOSTICS
-            }
-          } // for j
+              }
+            } // for j
+            first += n;
+          }
 #ifdef BOOST_SVG_POINT_DIAGNOSTICS
           std::cout << plotted << " plotted, and " << ignored << " ignored, "
-            << "size of series = " << serieses_[i].series_.size() << std::endl;
-          BOOST_ASSERT(plotted + ignored == serieses_[i].series_.size());
+            << "size of series = " << serieses_[i].drawn_size() << std::endl;
+          BOOST_ASSERT(plotted + ignored == serieses_[i].drawn_size());
 #endif // BOOST_SVG_POINT_DIAGNOSTICS
         } // for normal points.
 
@@ -2299,7 +2954,7 @@ my_plot.background_color(ghostwhite) // Whole image.
           size_t x_nan_count = 0;
           size_t y_nan_count = 0;
 
-          for(std::multimap<double,double>::const_iterator j = serieses_[i].series_limits_.begin();
+          for(svg_2d_plot_series::limits_type::const_iterator j = serieses_[i].series_limits_.begin();
             j!=serieses_[i].series_limits_.end(); ++j)
           {
             double x = j->first;
@@ -2391,7 +3046,8 @@ my_plot.background_color(ghostwhite) // Whole image.
 
       void draw_bars()
       { //! Draw normal bar chart for 'good' non-limit points.
-        g_element& g_ptr = image_.gs(detail::PLOT_DATA_POINTS).add_g_element(); // Moved up out of loop.
+        g_element& g_ptr = image_.gs(detail::PLOT_DATA_POINTS).add_g_element().retain(); // Moved up out of loop.
+        // Retained when streaming, because the group style is changed by each series.
         double x(0.);
         double y(0.); // Cartesian coord y = 0.
         double x0(0.); // Y-axis line.
@@ -2413,50 +3069,54 @@ my_plot.background_color(ghostwhite) // Whole image.
 
           double h_w = serieses_[i].bar_style_.width_; // For block bar chart.
           //double h_h = 0.;
-          for(std::multimap<Meas, unc<false> >::const_iterator j = serieses_[i].series_.begin();
-            j != serieses_[i].series_.end(); ++j)
-          { // All the 'good' data-points.
-            Meas ux = j->first;
-            x = ux.value();
-            unc<false> uy = j->second;
-            y = uy.value();
-            transform_point(x, y);
-            if((x > plot_left_)  && (x < plot_right_) && (y > plot_top_)  && (y < plot_bottom_))
-            { // Is inside plot window, so some bar to draw.
-              switch(serieses_[i].bar_style_.bar_option_)
-              { // -2 block to Y-axis,-1 stick to Y-axis, none, +1 stick to X-axis, -2 block to X-axis.
-              case y_block: // Draw a rectangle centered on the data-point horizontally to Y-axis.
+          double xs[detail::transform_block_size]; // SVG coordinates of a block of data-points.
+          double ys[detail::transform_block_size];
+          unsigned char where[detail::transform_block_size];
+          for (std::size_t first = 0; first != serieses_[i].drawn_size();)
+          {
+            const std::size_t n = transform_block(serieses_[i], first, xs, ys, where);
+            for(std::size_t j = 0; j != n; ++j)
+            { // All the 'good' data-points.
+              x = xs[j];
+              y = ys[j];
+              if((where[j] & detail::inside_window) != 0)
+              { // Is inside plot window, so some bar to draw.
+                switch(serieses_[i].bar_style_.bar_option_)
+                { // -2 block to Y-axis,-1 stick to Y-axis, none, +1 stick to X-axis, -2 block to X-axis.
+                case y_block: // Draw a rectangle centered on the data-point horizontally to Y-axis.
+                   {
+                     g_ptr.style().stroke_width(serieses_[i].line_style_.width_) // line_width used for rectangle line width.
+                       .fill_color(serieses_[i].bar_style_.area_fill_);
+                     double h_left = x;
+                     double h_top = y - h_w / 2; // Start a half-width above the data-point center.
+                     path.M(h_left, h_top).L(h_left, h_top + h_w).L(x0, h_top + h_w).L(x0, h_top).z();
+                   }
+                   break;
+                case y_stick:
+                   path.style().stroke_width(serieses_[i].bar_style_.width_); // bar_width used for stick line width.
+                   path.M(x, y).L(x0, y); // Draw a line from point horizontally to Y-axis.
+                   break;
+                case no_bar:
+                   break; // Already handled above, so should not get here.
+                   // Clang warns comparison of different enumeration types in switch statement
+                   // ('boost::svg::bar_option' and 'boost::svg::point_shape') [-Wenum-compare-switch]
+                case x_stick:
+                   path.style().stroke_width(serieses_[i].bar_style_.width_); // bar_width used for stick line width.
+                   path.M(x, y).L(x, y0); // Draw a line from point vertically to X-axis.
+                   break;
+                case x_block: // Draw a rectangle centered on the data-point vertically to X-axis.
                  {
                    g_ptr.style().stroke_width(serieses_[i].line_style_.width_) // line_width used for rectangle line width.
                      .fill_color(serieses_[i].bar_style_.area_fill_);
-                   double h_left = x;
-                   double h_top = y - h_w / 2; // Start a half-width above the data-point center.
-                   path.M(h_left, h_top).L(h_left, h_top + h_w).L(x0, h_top + h_w).L(x0, h_top).z();
+                   double h_left = x - h_w / 2; // Start a half width left of the data-point center.
+                   double h_top = y;
+                   path.M(h_left, h_top).L(h_left + h_w, h_top).L(h_left + h_w, y0).L(h_left, y0).z();
                  }
-                 break;
-              case y_stick:
-                 path.style().stroke_width(serieses_[i].bar_style_.width_); // bar_width used for stick line width.
-                 path.M(x, y).L(x0, y); // Draw a line from point horizontally to Y-axis.
-                 break;
-              case no_bar:
-                 break; // Already handled above, so should not get here.
-                 // Clang warns comparison of different enumeration types in switch statement
-                 // ('boost::svg::bar_option' and 'boost::svg::point_shape') [-Wenum-compare-switch]
-              case x_stick:
-                 path.style().stroke_width(serieses_[i].bar_style_.width_); // bar_width used for stick line width.
-                 path.M(x, y).L(x, y0); // Draw a line from point vertically to X-axis.
-                 break;
-              case x_block: // Draw a rectangle centered on the data-point vertically to X-axis.
-               {
-                 g_ptr.style().stroke_width(serieses_[i].line_style_.width_) // line_width used for rectangle line width.
-                   .fill_color(serieses_[i].bar_style_.area_fill_);
-                 double h_left = x - h_w / 2; // Start a half width left of the data-point center.
-                 double h_top = y;
-                 path.M(h_left, h_top).L(h_left + h_w, h_top).L(h_left + h_w, y0).L(h_left, y0).z();
-               }
-                break;
-              } // switch
-            } // for
+                  break;
+                } // switch
+              } // if inside plot window
+            } // for j
+            first += n;
           } // for normal points
         }
         // Ignore all the 'bad' at_limit points.
@@ -2483,7 +3143,8 @@ my_plot.background_color(ghostwhite) // Whole image.
          Using the y values for the bins implies changing the Y axes labeling and scaling too.
         */
 
-        g_element& g_ptr = image_.gs(detail::PLOT_DATA_POINTS).add_g_element(); // Moved up out of loop.
+        g_element& g_ptr = image_.gs(detail::PLOT_DATA_POINTS).add_g_element().retain(); // Moved up out of loop.
+        // Retained when streaming, because the group style is changed by each series.
         for(unsigned int i = 0; i < serieses_.size(); ++i)
         { // for each data-series.
           if (serieses_[i].histogram_style_.histogram_option_ == no_histogram)
@@ -2506,51 +3167,98 @@ my_plot.background_color(ghostwhite) // Whole image.
             path.style().fill_color(blank);
           }
 
-          std::multimap<Meas, unc<false> >::const_iterator last = serieses_[i].series_.end();
+          const svg_2d_plot_series& series = serieses_[i];
+          std::size_t last = series.values_size();
           last--; // Final pair with first the last bin end, and value zero or NaN.
-          Meas u = last->second;
-          if (u.value() != 0)
+          if (series.y_value(last) != 0)
           {
-            std::cout << "Last bin end " << last->first << " should have zero value! but is "  << last->second << std::endl;
+            std::cout << "Last bin end " << series.x_value(last) << " should have zero value! but is "  << series.y_value(last) << std::endl;
             // Or Throw? or skip this series?
           }
-          for(std::multimap<Meas, unc<false> >::const_iterator j = serieses_[i].series_.begin();
-            j != last; ++j)
-          { // All the 'good' 'real' data-points.
-            Meas ux = j->first;
-            double x = ux.value();
-            unc<false> uy =  j->second;
-            double y = uy.value();
-            std::multimap<Meas, unc<false> >::const_iterator j_next = j;
-            j_next++;
-            if (j != last)
+          double y0(0.); // X-axis line.
+          transform_y(y0); // SVG y coordinate of horizontal X-axis line.
+          double x[detail::transform_block_size]; // A block of bin ends,
+          double y[detail::transform_block_size]; // and heights of the bins starting at each.
+          unsigned char where[detail::transform_block_size];
+          for (std::size_t first = 0; first < last;)
+          { // All the 'good' 'real' data-points, a block at a time, overlapping by the last bin end.
+            const std::size_t n = (std::min)(detail::transform_block_size, last + 1 - first);
+            series.values(first, n, x, y);
+            for (std::size_t j = 0; j + 1 != n; ++j)
             { // Draw a column (perhaps filled) to show bin.
-              Meas ux_next= j_next->first;
-              double x_next = ux_next.value();
-              double w = x_next - x;
-              double h = y / w;
-              // std::cout << x << ' ' << y << ' ' << w << ' '  << h << std::endl;
-              double yy = h;
-              double y0(0.); // X-axis line.
-              transform_y(y0); // SVG y coordinate of horizontal X-axis line.
-              transform_x(x); // SVG x coordinate of start of bin,
-              transform_x(x_next);  // SVG x coordinate of end of bin,
-              transform_y(yy); // SVG y coordinate of height of bin.
+              double w = x[j + 1] - x[j];
+              y[j] = y[j] / w; // Height.
+            }
+            // SVG x coordinates of bin ends, and y coordinates of heights of bins (not adjusted if at limit).
+            transform_values(x, y, n, margin_, where);
+            for (std::size_t j = 0; j + 1 != n; ++j)
+            {
               //if((x > plot_left_)  && (x < plot_right_) && (y > plot_top_)  && (y < plot_bottom_))
               //{ // Is inside plot window, so some columns to draw. TODO checks?
-                path.M(x, y0).L(x, yy) // Draw a line from point vertically from X-axis.
-                  .L(x_next, yy) // & horizonally to next bin end (next x value).
-                  .L(x_next, y0) // back to X-axis.
+                path.M(x[j], y0).L(x[j], y[j]) // Draw a line from point vertically from X-axis.
+                  .L(x[j + 1], y[j]) // & horizonally to next bin end (next x value).
+                  .L(x[j + 1], y0) // back to X-axis.
                   .Z(); // So will fill.
-             } // if
+            }
+            first += n - 1;
           } // for series
         } // for normal points.
         // Ignore all the 'bad' at_limit points.
       } //  void draw_histogram()
 
       void update_image()
-      { //! Draw the whole SVG image.
-        clear_all();
+      { //! Draw the whole SVG image (except the data-series layers if unchanged and @c incremental_on).
+        if (incremental_on_ && !image_.arena_on())
+        { // Keep the data-series layers drawn before, unless a data-series, or the plot window or its scaling has changed.
+          draw_frame(true);
+          std::vector<std::size_t> changes;
+          changes.reserve(serieses_.size());
+          for (std::size_t i = 0; i != serieses_.size(); ++i)
+          {
+            changes.push_back(serieses_[i].changes_);
+          }
+          const double window[] = {plot_left_, plot_top_, plot_right_, plot_bottom_, x_scale_, x_shift_, y_scale_, y_shift_};
+          std::vector<double> drawn(window, window + sizeof(window) / sizeof(window[0]));
+          if ((changes == drawn_changes_) && (drawn == drawn_window_))
+          {
+            return;
+          }
+          clear_points();
+          drawn_changes_.swap(changes);
+          drawn_window_.swap(drawn);
+        }
+        else
+        {
+          draw_frame();
+        }
+        for (std::size_t i = 0; i != serieses_.size(); ++i)
+        { // Choose the data-points drawn of any downsampled data-series.
+          serieses_[i].select_drawn();
+        }
+        draw_plot_lines(); // Draw lines between points.
+        draw_plot_points();
+        draw_bars();
+        draw_histogram();
+      } // void update_image()
+
+      void draw_frame(bool keep_data = false)
+      { /*! Draw all the SVG image except the data-series: background, title, axes, labels and legend.
+          \param keep_data If @c true, keep the data-series layers drawn before (when the arena is not used).
+        */
+        if (keep_data)
+        {
+          clear_legend();
+          clear_background();
+          clear_x_axis();
+          clear_y_axis();
+          clear_title();
+          clear_plot_background();
+          clear_grids();
+        }
+        else
+        {
+          clear_all();
+        }
         // SVG 'painting' rules are that later 'painting' writes over previous painting, so the order of drawing is important.
 
         // Draw image background (perhaps with border and/or fill color).
@@ -2588,12 +3296,110 @@ my_plot.background_color(ghostwhite) // Whole image.
         {
           draw_y_axis_label();
         }
-
-        draw_plot_lines(); // Draw lines between points.
-        draw_plot_points();
-        draw_bars();
-        draw_histogram();
-    } // void update_image()
+      } // void draw_frame()
+
+      void write_streaming(std::ostream& s_out)
+      { /*! Draw and write the image layer by layer, so that the data-series layers are never held in the document tree.
+          The data-series are drawn once, as by update_image(), each data layer writing its elements as they are drawn,
+          straight to @c s_out if nothing is to be written before it, or else to a temporary file,
+          copied to @c s_out in turn (with @c use_markers or @c smallest_markers, all data layers,
+          as the symbols of their markers must be written ahead of them).
+        */
+        using namespace boost::svg::detail; // Avoid need for prefix detail::
+        static const int data_layers[] = {PLOT_DATA_LINES, PLOT_DATA_UNC3, PLOT_DATA_UNC2, PLOT_DATA_UNC1,
+          PLOT_DATA_POINTS, PLOT_LIMIT_POINTS, PLOT_X_POINT_VALUES, PLOT_Y_POINT_VALUES};
+        const int n_data_layers = sizeof(data_layers) / sizeof(data_layers[0]);
+
+        draw_frame();
+        drawn_window_.clear(); // The data-series layers are not kept, so must be drawn again by any later update_image().
+        for (std::size_t i = 0; i != serieses_.size(); ++i)
+        { // Choose the data-points drawn of any downsampled data-series.
+          serieses_[i].select_drawn();
+        }
+        // Symbols of markers are added only as the data-points are drawn, but are written before all the layers.
+        const bool symbols = (image_.markers() == use_markers) || (image_.markers() == smallest_markers);
+        if (!symbols)
+        {
+          image_.write_prolog(s_out);
+          image_.write_clip_paths(s_out);
+          image_.write_symbols(s_out);
+          for (int i = 0; i < PLOT_DATA_LINES; ++i)
+          {
+            image_.gs(i).write(s_out);
+          }
+        }
+        element_arena* arenas[n_data_layers]; // Streamed elements are destroyed at once, so need no arena.
+        std::unique_ptr<temp_file_sink> held[n_data_layers]; // Output of the data layers written later.
+        std::unique_ptr<std::ostream> outs[n_data_layers];
+        for (int d = 0; d < n_data_layers; ++d)
+        {
+          arenas[d] = image_.gs(data_layers[d]).arena();
+          image_.gs(data_layers[d]).arena(0);
+        }
+        try
+        {
+          for (int d = 0; d < n_data_layers; ++d)
+          {
+            if (symbols || d > 1)
+            { // Lines are drawn first, and the uncertainty ellipses are written first of the data layers drawn next.
+              held[d].reset(new temp_file_sink());
+              outs[d].reset(new std::ostream(held[d].get()));
+              outs[d]->copyfmt(s_out);
+              image_.format_stream(*outs[d]); // Precision and other format state, like svg::compact_paths, as write_prolog sets.
+            }
+          }
+          image_.gs(PLOT_DATA_LINES).stream(symbols ? outs[0].get() : &s_out);
+          draw_plot_lines();
+          image_.gs(PLOT_DATA_LINES).end_stream();
+          for (int d = 1; d < n_data_layers; ++d)
+          {
+            image_.gs(data_layers[d]).stream(held[d] ? outs[d].get() : &s_out);
+          }
+          draw_plot_points();
+          draw_bars();
+          draw_histogram();
+          for (int d = 1; d < n_data_layers; ++d)
+          {
+            image_.gs(data_layers[d]).end_stream();
+          }
+          if (symbols)
+          {
+            image_.write_prolog(s_out);
+            image_.write_clip_paths(s_out);
+            image_.write_symbols(s_out);
+          }
+          int d = 0; // Index of next data layer.
+          for (int i = symbols ? 0 : PLOT_DATA_LINES; i < SVG_PLOT_DOC_CHILDREN; ++i)
+          {
+            if (d == n_data_layers || i != data_layers[d])
+            { // Frame layer, already complete.
+              image_.gs(i).write(s_out);
+              continue;
+            }
+            if (held[d])
+            { // Already written to s_out if not held.
+              outs[d]->flush();
+              held[d]->copy_to(s_out);
+            }
+            ++d;
+          }
+          image_.write_epilog(s_out);
+        }
+        catch (...)
+        { // Stop streaming to the streams about to be destroyed.
+          for (int k = 0; k < n_data_layers; ++k)
+          {
+            image_.gs(data_layers[k]).stream(0);
+            image_.gs(data_layers[k]).end_stream();
+            image_.gs(data_layers[k]).arena(arenas[k]);
+          }
+          throw;
+        }
+        for (int k = 0; k < n_data_layers; ++k)
+        {
+          image_.gs(data_layers[k]).arena(arenas[k]);
+        }
+      } // void write_streaming(std::ostream& s_out)
 //! \endcond
 
     public: // Declarations of member functions.
@@ -2601,13 +3407,18 @@ my_plot.background_color(ghostwhite) // Whole image.
       // All return @c *this to permit chaining, documented with
       // \verbatim \return Reference to svg_2d_plot_series to make chainable. \endverbatim
 
-      // write() has two flavors, a file and a ostream.
-      // The file version opens an ostream, and calls the stream version.
+      // write() has three flavors, a file, a ostream and an output_sink.
+      // The file and sink versions open an ostream, and call the stream version.
       // The stream version first clears all unnecessary data from the graph,
       // builds the document tree, and then calls the write function for the root
       // document node, which calls all other nodes through the Visitor pattern.
       svg_2d_plot& write(const std::string& file);
       svg_2d_plot& write(std::ostream& s_out);
+      svg_2d_plot& write(output_sink& sink);
+      svg_2d_plot& streaming_on(bool b); // Stream the data-series layers when writing.
+      bool streaming_on();
+      svg_2d_plot& incremental_on(bool b); // Draw the data-series layers again only if changed.
+      bool incremental_on();
 
       // Member functions to set and get plot options.
 
@@ -2708,6 +3519,7 @@ my_plot.background_color(ghostwhite) // Whole image.
       svg_2d_plot& y_autoscale(const T& container); // Whole data-series.
       template <typename T> // T a 2D STL container: array, vector ...
       svg_2d_plot& xy_autoscale(const T& container); // Whole data-series,
+      svg_2d_plot& xy_autoscale(const svg_2d_plot_series& series); // Minimum and maximum of a (live) data-series.
       bool xy_autoscale();
       double y_major_tick_length();
       svg_2d_plot& y_major_tick_length(double length);
@@ -2790,6 +3602,33 @@ my_plot.background_color(ghostwhite) // Whole image.
       template <typename T, typename U>
       svg_2d_plot_series& plot(const T& begin, const T& end, const std::string& title = "",
         U functor = boost::svg::detail::pair_double_2d_convert() );
+
+      template <typename T>
+      svg_2d_plot_series& plot(const T& container, const std::string& title, assume_sorted_tag);
+
+      template <typename T>
+      svg_2d_plot_series& plot(const T& begin, const T& end, const std::string& title, assume_sorted_tag);
+
+      // Versions of plot functions to add a data-series that is a view of the caller's data, without copying.
+      svg_2d_plot_series& plot_view(value_span x, value_span y, const std::string& title = "");
+      svg_2d_plot_series& plot_view(value_span x, value_span y, value_span y_sd, const std::string& title = "");
+
+//! \cond DETAIL
+      template <typename T>
+      static svg_2d_plot_series make_series(T begin, T end, const std::string& title, bool sorted, std::true_type)
+      { //! Plain data values (like @c double) are held as just @c double s, with no conversion.
+        return svg_2d_plot_series(begin, end, title, sorted);
+      }
+
+      template <typename T>
+      static svg_2d_plot_series make_series(T begin, T end, const std::string& title, bool sorted, std::false_type)
+      { //! Other data values are converted to @c Meas and @c unc to keep any uncertainty and other info.
+        return svg_2d_plot_series(
+          boost::make_transform_iterator(begin, boost::svg::detail::pair_Meas_2d_double_convert<false>()),
+          boost::make_transform_iterator(end, boost::svg::detail::pair_Meas_2d_double_convert<false>()),
+          title, sorted);
+      }
+//! \endcond
  }; // class svg_2d_plot : public detail::axis_plot_frame<svg_2d_plot>
 
    // Definition of class svg_2d_plot member functions.
@@ -3407,6 +4246,15 @@ my_plot.x_value_ioflags(ios::dec | ios::scientific).x_value_precision(2);
         return *this; //! \return reference to svg_2d_plot to make chainable.
       } // xy_autoscale
 
+      svg_2d_plot& svg_2d_plot::xy_autoscale(const svg_2d_plot_series& series)
+      { /*! Data-series to use to autoscale \b both X and Y axes, from the minimum and maximum of its normal data-points,
+          in constant time for a data-series with data-points added by @c push_back, see @c svg_2d_plot_series::x_min_max.
+        */
+        x_autoscale(series.x_min_max());
+        y_autoscale(series.y_min_max());
+        return *this; //! \return reference to svg_2d_plot to make chainable.
+      }
+
       bool svg_2d_plot::xy_autoscale()
       { //! \return @c true if to autoscale both X and Y Axes.
         return y_autoscale_ && x_autoscale_;
@@ -3829,8 +4677,15 @@ my_plot.x_value_ioflags(ios::dec | ios::scientific).x_value_precision(2);
       { //!  Write the plot image to a named file (default suffix .svg, added if no type already appended to file name).
         std::string filename(file); // Copy to avoid problem with const if try to append.
         if (filename.find(".svg") == std::string::npos)
-        { // No file type suffix, so provide the default .svg.
-          filename.append(".svg");
+        { // No file type suffix, so provide the default .svg (or .svgz).
+          filename.append(image_.compress_on() ? ".svgz" : ".svg");
+        }
+        if (detail::is_compressed(image_.compress_on(), filename))
+        { // Deflate while writing.
+          gzip_sink zout(filename); // Throws if unable to open.
+          write(zout);
+          zout.close();
+          return *this;
         }
         std::ofstream fout(filename.c_str());
         if(fout.fail())
@@ -3842,7 +4697,8 @@ my_plot.x_value_ioflags(ios::dec | ios::scientific).x_value_precision(2);
       } // write(file)
 
    /*! \brief Add a container of a data-series to the plot.\n
-       (Version converting to Meas using double with pair_double_2d_convert).\n @b Example:
+       (Version converting to Meas using double with pair_double_2d_convert,
+       unless the data values are plain, like @c double, when they are held as just @c double s).\n @b Example:
       \code
 my_plot.plot(data1, "Sqrt(x)");
       \endcode
@@ -3852,12 +4708,8 @@ my_plot.plot(data1, "Sqrt(x)");
   template <typename T>
   svg_2d_plot_series& svg_2d_plot::plot(const T& container, const std::string& title)
   {
-    serieses_.push_back(
-      svg_2d_plot_series(
-      boost::make_transform_iterator(container.begin(), boost::svg::detail::pair_Meas_2d_double_convert<false>()),
-      boost::make_transform_iterator(container.end(), boost::svg::detail::pair_Meas_2d_double_convert<false>()),
-      title)
-    );
+    serieses_.push_back(make_series(container.begin(), container.end(), title, false,
+      detail::is_plain_value<typename T::value_type>())); // Plain values need no conversion.
     return serieses_[serieses_.size()-1]; //! \return Reference to data-series just added to make chainable.
   }
 
@@ -3920,14 +4772,148 @@ my_2d_plot.plot(&my_data[1], &my_data[3], "my_data 1 to 3"); // Add part of data
     return serieses_[serieses_.size() - 1]; //! \return Reference to data-series just added to make chainable.
   }
 
+  /*! \brief Add a container of a data-series, whose data-points the caller guarantees are in ascending order of X,
+      so need neither be sorted, nor checked, for example:
+      \code
+my_plot.plot(my_time_series, "Readings", assume_sorted);
+      \endcode
+      (Otherwise as @c plot(container, title)).
+      \return Reference to data-series just added to make chainable.
+   */
+  template <typename T>
+  svg_2d_plot_series& svg_2d_plot::plot(const T& container, const std::string& title, assume_sorted_tag)
+  {
+    serieses_.push_back(make_series(container.begin(), container.end(), title, true,
+      detail::is_plain_value<typename T::value_type>()));
+    return serieses_[serieses_.size() - 1];
+  }
+
+  /*! \brief Add (part of) a container of a data-series, whose data-points the caller guarantees
+      are in ascending order of X, using iterators begin to end, for example:
+      \code
+my_plot.plot(my_time_series.begin() + 10, my_time_series.end(), "Readings", assume_sorted);
+      \endcode
+      \return Reference to data-series just added to make chainable.
+   */
+  template <typename T>
+  svg_2d_plot_series& svg_2d_plot::plot(const T& begin, const T& end, const std::string& title, assume_sorted_tag)
+  {
+    serieses_.push_back(make_series(begin, end, title, true,
+      detail::is_plain_value<typename std::iterator_traits<T>::value_type>()));
+    return serieses_[serieses_.size() - 1];
+  }
+
+  /*! \brief Add a data-series that is a view of the caller's X and Y values, for example, column arrays:
+      \code
+my_plot.plot_view(x, y, "columns"); // std::vector<double> x, y; or double x[1000], y[1000];
+my_plot.plot_view(value_span(samples.data(), samples.size(), &sample::time),
+  value_span(samples.data(), samples.size(), &sample::volts), "samples"); // Members of an array of structs.
+      \endcode
+      \details The values are not copied, but read when the plot is drawn (by @c write),
+      so they must remain unchanged (and vectors unresized) until then.
+      Only any 'at limit' data-points are copied, and, if the X values are not in order,
+      an index of the data-points in X order (instead of sorting them).
+      \param x X values of data-points.
+      \param y Y values of data-points (as many as X values).
+      \param title Title of data-series.
+      \return Reference to data-series just added to make chainable.
+   */
+  svg_2d_plot_series& svg_2d_plot::plot_view(value_span x, value_span y, const std::string& title)
+  {
+    serieses_.push_back(svg_2d_plot_series(x, y, value_span(), title));
+    return serieses_[serieses_.size() - 1];
+  }
+
+  /*! \brief Add a data-series that is a view of the caller's X and Y values, and the standard deviations of Y values,
+      shown by uncertainty ellipses and value-labels (otherwise as @c plot_view(x, y, title)).
+      \param x X values of data-points.
+      \param y Y values of data-points (as many as X values).
+      \param y_sd Standard deviations of Y values (as many as X values).
+      \param title Title of data-series.
+      \return Reference to data-series just added to make chainable.
+   */
+  svg_2d_plot_series& svg_2d_plot::plot_view(value_span x, value_span y, value_span y_sd, const std::string& title)
+  {
+    serieses_.push_back(svg_2d_plot_series(x, y, y_sd, title));
+    return serieses_[serieses_.size() - 1];
+  }
+
 /*! Write the SVG image to a @c std::ostream.
 */
    svg_2d_plot& svg_2d_plot::write(std::ostream& s_out)
    {
+     if (streaming_on_)
+     { // Write the data-series layers as they are drawn.
+       if (image_.compact_output() && dynamic_cast<minify_sink*>(s_out.rdbuf()) == 0)
+       { // Through a sink that minifies, as svg::write does.
+         minify_sink minify(s_out.rdbuf());
+         std::ostream m_out(&minify);
+         m_out.copyfmt(s_out);
+         write_streaming(m_out);
+         m_out.flush();
+         minify.close();
+         return *this;
+       }
+       write_streaming(s_out);
+       return *this;
+     }
      update_image();
      image_.write(s_out); // Use the std::ostream version of write.
      return *this; //! \return Reference to svg_2d_plot to make chainable.
    }
+
+/*! Write the SVG image directly to an @c output_sink, for example, a @c string_sink or @c file_sink.
+*/
+   svg_2d_plot& svg_2d_plot::write(output_sink& sink)
+   {
+     std::ostream s_out(&sink);
+     write(s_out); // Use the std::ostream version of write.
+     s_out.flush();
+     return *this; //! \return Reference to svg_2d_plot to make chainable.
+   }
+
+   svg_2d_plot& svg_2d_plot::streaming_on(bool b)
+   { /*! If @c true, write() outputs each data-series layer (lines, data-point markers, uncertainty ellipses and value-labels)
+       as it is drawn, destroying each element once written, instead of first building all of the document tree.
+       Peak memory then does not grow with the number of data-points
+       (except for the path of a line joining the points, or of bars, that are each a single element).
+       The data-series are drawn once, and each data layer written after others (all of them with @c svg::markers
+       @c use_markers or @c smallest_markers, whose symbols must be written first) is held in a temporary file until its turn.
+       With default options, the SVG output is the same as from the document tree.
+       \note Notes and other annotation added to the image are unaffected.
+       \note With @c svg::css_classes, the styles of groups in the data layers are not counted (as they are not yet drawn),
+       so these groups may keep their style attributes: the image looks the same, but the SVG is not the same as from the document tree.
+       \note @c svg::write_threads is ignored: the data layers are written by this thread as they are drawn.
+     */
+     streaming_on_ = b;
+     return *this; //! \return Reference to svg_2d_plot to make chainable.
+   }
+
+   bool svg_2d_plot::streaming_on()
+   { //! \return @c true if write() streams the data-series layers.
+     return streaming_on_;
+   }
+
+   svg_2d_plot& svg_2d_plot::incremental_on(bool b)
+   { /*! If @c true, write() (by update_image()) draws the data-series layers (lines, data-point markers, uncertainty ellipses and value-labels)
+       again only if data-points of any data-series have changed (for example, by @c svg_2d_plot_series::push_back),
+       or a data-series has been added, or the plot window or its scaling has changed (for example, by autoscaling),
+       since the plot was last written, for example, to update a rolling dashboard.
+       The frame (axes, title, legend...) is always drawn again.
+       \note Other changes to the appearance of the data-series made after writing are shown only when they are next drawn,
+       (or by setting @c incremental_on(true) again).
+       Has no effect if @c arena_on (as the arena frees all elements before drawing again), or @c streaming_on.
+     */
+     incremental_on_ = b;
+     drawn_changes_.clear();
+     drawn_window_.clear(); // So draw again.
+     return *this; //! \return Reference to svg_2d_plot to make chainable.
+   }
+
+   bool svg_2d_plot::incremental_on()
+   { //! \return @c true if write() draws the data-series layers again only if changed.
+     return incremental_on_;
+   }
   } // namespace svg
 } // namespace boost
 
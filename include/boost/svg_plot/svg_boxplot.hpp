@@ -1881,6 +1881,7 @@ public:
 
   svg_boxplot& write(const std::string& file); //! Write SVG boxplot to file.
   svg_boxplot& write(std::ostream& s_out); //! Write SVG boxplot to ostream.
+  svg_boxplot& write(output_sink& sink); //! Write SVG boxplot directly to a sink, for example, a @c string_sink.
   svg_boxplot& title_on(bool cmd); //! true if to include title in plot.
   svg_boxplot& x_label_on(bool cmd);
   svg_boxplot& median_values_on(bool cmd);
@@ -2114,8 +2115,16 @@ public:
   { //! Write SVG image to file.
     std::string filename(file); // Copy to avoid problems with const if need to append.
     if (filename.find(".svg") == std::string::npos)
-    { // No file type suffix, so provide the default .svg.
-      filename.append(".svg");
+    { // No file type suffix, so provide the default .svg (or .svgz).
+      filename.append(image_.compress_on() ? ".svgz" : ".svg");
+    }
+    if (detail::is_compressed(image_.compress_on(), filename))
+    { // Deflate while writing.
+      gzip_sink zout(filename); // Throws if unable to open.
+      image_.image_filename(filename);
+      svg_boxplot::write(zout);
+      zout.close();
+      return *this;
     }
     std::ofstream fout(filename.c_str());
     if(fout.fail())
@@ -2137,6 +2146,14 @@ public:
     return *this; //! \return Reference to svg_boxplot to make chainable.
   }
 
+  svg_boxplot& svg_boxplot::write(output_sink& sink)
+  { //! Write SVG image directly to a sink, for example, a @c string_sink or @c file_sink.
+    std::ostream s_out(&sink);
+    svg_boxplot::write(s_out); // Use the ostream version.
+    s_out.flush();
+    return *this; //! \return Reference to svg_boxplot to make chainable.
+  }
+
   svg_boxplot& svg_boxplot::title_on(bool cmd)
   { //! Set true to show whole boxplot title.
     title_on_ = cmd;
@@ -56,6 +56,16 @@ using boost::svg::detail::plot_doc_structure;
 
 // enum plot_doc_structure; // ISO C++ forbids forward references to 'enum' types
 
+// detail/output_sink.hpp contains definitions.
+class output_sink;
+class string_sink;
+class file_sink;
+class ostream_sink;
+// detail/minify_sink.hpp contains definition.
+class minify_sink;
+// detail/value_span.hpp contains definition.
+class value_span;
+
 // svg.hpp
 // Chainable set and get member functions for:
 // Image size x and y, and both.
@@ -99,6 +109,7 @@ const std::string& stretch, const std::string& decoration, align_style align,  i
 // Write image out to ostream and file:
 svg& write(std::ostream& s_out);
 svg& write(const std::string& file);
+svg& write(output_sink& sink);
 
 // Load a stylesheet into string css from an input file.
 svg& load_stylesheet(const std::string& input);
@@ -139,6 +150,8 @@ class circle_element; // Represents a single circle.
 class ellipse_element; // Represents a single ellipse.
 class line_element; // Represents a single line.
 class clip_path_element; // Restricts the region to which paint can be applied.
+class use_element; // Reference to a symbol, drawn at (x, y).
+class glyphs_element; // The same glyph drawn at many positions, as one text element.
 struct path_point; // Base class for m_path, z_path, q_path, h_path, v_path, c_path, s_path & point_path.
 struct point_path; // for polyline & polygon
 class polygon_element; // closed shape consisting of a set of connected straight line segments.
@@ -155,6 +168,7 @@ struct s_path; // Draws a cubic Bezier curve from the current point to (x,y).
 struct t_path; // Draws a quadratic Bezier curve from the current point to (x,y).
 struct a_path; // Draws a elliptical arc from the current point to (x,y).
 class g_element; // 'g' element is a container element for grouping together related graphics elements.
+class symbol_element; // Group defined once, and drawn by use_element(s).
 
 // Note don't try to use accent in Bezier! - causes failure in autodoc .xml files - not UTF-8.
 
@@ -26,6 +26,7 @@
 // using boost::svg::svg_color
 #include <boost/svg_plot/svg_style.hpp> // Font and other styles. // For not_a_text_style etc
 #include <boost/svg_plot/detail/svg_style_detail.hpp> // For enum plot_doc_structure.
+#include <boost/svg_plot/detail/number_format.hpp> // For coord.
 
 #include <iostream>
 // using std::ostream;
@@ -417,7 +418,7 @@ public:
     if(width_on_ && (width_ > 0))
     { // We never want a 0 (or <0) width output?
         os << " stroke-width=\""
-            << width_
+            << detail::coord(width_)
             << "\"";
     }
  } // void svg_style::write(std::ostream& os)
@@ -829,7 +830,7 @@ void text_style::write(std::ostream& os)
   }
   if (text_length() > 0)
   {
-    os << " textLength=\"" << text_length_ << "\"";
+    os << " textLength=\"" << detail::coord(text_length_) << "\"";
   }
 } //   void svg_style::write(std::ostream& os)
 
@@ -982,6 +983,15 @@ enum point_shape
   */
 }; // enum point_shape
 
+//! \enum marker_policy How data-point markers of the same shape, size and font are written, see @c svg::markers.
+enum marker_policy
+{
+  inline_markers = 0, //!< Each data-point marker is written in full (default).
+  use_markers, //!< Each marker shape is defined once as a @c <symbol>, and each data-point is a @c <use> of it.
+  smallest_markers, //!< Whichever of the full marker, or a @c <use> of its @c <symbol>, is smaller.
+  batched_markers //!< Glyph markers of each data-series are written as a few @c <text> elements, each with lists of X and Y coordinates.
+}; // enum marker_policy
+
 class plot_point_style
 { /*! \class boost::svg::plot_point_style
     \brief Shape, color, and symbol or shape of data-point markers.
@@ -1861,6 +1871,14 @@ enum histogram_option
   //! Column is the most common histogram style.
 };
 
+//! \enum downsample_option Options to draw only some data-points of (very) long data-series, see @c svg_2d_plot_series::downsample.
+enum downsample_option
+{
+  no_downsample = 0, //!< Draw all data-points.
+  m4 = 1, //!< Line joins only the first, last, minimum and maximum data-points in each pixel column (so looks the same).
+  lttb = 2 //!< Only a number of data-points that keep the shape of the data-series (Largest-Triangle-Three-Buckets) are drawn.
+};
+
  /*! \class boost::svg::histogram_style
      \brief Histogram options.
 */
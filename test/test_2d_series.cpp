@@ -0,0 +1,362 @@
+/*! \file test_2d_series.cpp
+   \brief Tests of 2-D data-series drawn by svg_2d_plot.
+   \details Tests that the different ways of adding, holding and writing data-series
+   draw the same SVG as the plain way, and tests of the detail functions used to draw them.
+*/
+
+// Copyright Paul A. Bristow 2020
+
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_TEST_MAIN
+// NB define BOOST_TEST_MAIN must come BEFORE this include.
+#include <boost/test/unit_test.hpp>
+
+#include <boost/svg_plot/svg_2d_plot.hpp>
+  using namespace boost::svg;
+#include <boost/quan/unc.hpp>
+  using boost::quan::unc;
+
+#include <cmath>
+  // using std::sin;
+#include <limits>
+  using std::numeric_limits;
+#include <map>
+  using std::map;
+  using std::multimap;
+#include <sstream>
+  using std::ostringstream;
+#include <string>
+  using std::string;
+#include <utility>
+  using std::pair;
+#include <vector>
+  using std::vector;
+
+namespace
+{
+  struct window_plot : public svg_2d_plot
+  { // To test the protected functions that transform data-points to SVG coordinates.
+    using svg_2d_plot::transform_x;
+    using svg_2d_plot::transform_y;
+    using svg_2d_plot::transform_values;
+    using svg_2d_plot::where_in_window;
+  };
+
+  string svg_of(svg_2d_plot& plot)
+  { //! \return SVG written by plot.
+    ostringstream out;
+    plot.write(out);
+    return out.str();
+  }
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_duplicate_x)
+{ // data-points with the same X are drawn in the order added (as kept by a multimap), after a stable sort.
+  const double xs[] = {3., 1., 2., 1., 3., 1., 2.};
+  const double ys[] = {0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7};
+  vector<pair<double, double> > data;
+  multimap<double, double> map_data;
+  for (std::size_t i = 0; i != sizeof(xs) / sizeof(xs[0]); ++i)
+  {
+    data.push_back(std::make_pair(xs[i], ys[i]));
+    map_data.insert(std::make_pair(xs[i], ys[i]));
+  }
+  svg_2d_plot plot;
+  plot.x_range(0, 4).y_range(0, 1);
+  svg_2d_plot_series& series = plot.plot(data, "duplicates").line_on(true);
+  BOOST_REQUIRE_EQUAL(series.values_size(), map_data.size());
+  std::size_t j = 0;
+  for (multimap<double, double>::const_iterator it = map_data.begin(); it != map_data.end(); ++it, ++j)
+  { // X 1 with Y 0.2, 0.4, 0.6, X 2 with Y 0.3, 0.7, and X 3 with Y 0.1, 0.5.
+    BOOST_CHECK_EQUAL(series.x_value(j), it->first);
+    BOOST_CHECK_EQUAL(series.y_value(j), it->second);
+  }
+  svg_2d_plot map_plot;
+  map_plot.x_range(0, 4).y_range(0, 1);
+  map_plot.plot(map_data, "duplicates").line_on(true);
+  BOOST_CHECK(svg_of(plot) == svg_of(map_plot));
+} // BOOST_AUTO_TEST_CASE(test_duplicate_x)
+
+BOOST_AUTO_TEST_CASE(test_plain_series)
+{ // A data-series of plain doubles (held without uncertainty) is drawn the same as the same values with (no) uncertainty.
+  vector<pair<double, double> > data;
+  multimap<unc<false>, unc<false> > unc_data;
+  for (int i = 0; i != 50; ++i)
+  {
+    const double x = (i * 37) % 50 * 0.2; // Not in order.
+    data.push_back(std::make_pair(x, std::sin(x)));
+    unc_data.insert(std::make_pair(unc<false>(x), unc<false>(std::sin(x))));
+  }
+  data.push_back(std::make_pair(5., numeric_limits<double>::quiet_NaN())); // And 'at limit'.
+  unc_data.insert(std::make_pair(unc<false>(5.), unc<false>(numeric_limits<double>::quiet_NaN())));
+  svg_2d_plot plot;
+  plot.x_range(0, 10).y_range(-1, 1);
+  svg_2d_plot_series& plain = plot.plot(data, "sin").line_on(true).shape(square);
+  BOOST_CHECK(plain.plain());
+  svg_2d_plot unc_plot;
+  unc_plot.x_range(0, 10).y_range(-1, 1);
+  svg_2d_plot_series& uncertain = unc_plot.plot(unc_data, "sin").line_on(true).shape(square);
+  BOOST_CHECK(!uncertain.plain());
+  BOOST_CHECK_EQUAL(plain.values_count(), uncertain.values_count());
+  BOOST_CHECK_EQUAL(plain.limits_count(), 1);
+  BOOST_CHECK(svg_of(plot) == svg_of(unc_plot));
+} // BOOST_AUTO_TEST_CASE(test_plain_series)
+
+BOOST_AUTO_TEST_CASE(test_sorted_series)
+{ // data-points already in order of X, found so or assumed, are drawn the same as when sorted.
+  vector<pair<double, double> > sorted;
+  for (int i = 0; i != 200; ++i)
+  {
+    sorted.push_back(std::make_pair(i * 0.05, std::cos(i * 0.05)));
+  }
+  sorted[100].second = numeric_limits<double>::infinity(); // 'at limit'.
+  sorted.insert(sorted.begin() + 50, sorted[50]); // And a duplicate.
+  vector<pair<double, double> > shuffled(sorted);
+  for (std::size_t i = 0; i + 7 < shuffled.size(); i += 7)
+  { // Out of order, but with duplicate X values still in the same order.
+    std::swap(shuffled[i], shuffled[i + 7]);
+  }
+  svg_2d_plot shuffled_plot;
+  shuffled_plot.x_range(0, 10).y_range(-1, 1);
+  shuffled_plot.plot(shuffled, "cos").line_on(true);
+  const string expected = svg_of(shuffled_plot);
+
+  svg_2d_plot found_plot; // Found to be in order.
+  found_plot.x_range(0, 10).y_range(-1, 1);
+  found_plot.plot(sorted, "cos").line_on(true);
+  BOOST_CHECK(svg_of(found_plot) == expected);
+
+  svg_2d_plot assumed_plot; // Caller guarantees order.
+  assumed_plot.x_range(0, 10).y_range(-1, 1);
+  assumed_plot.plot(sorted, "cos", assume_sorted).line_on(true);
+  BOOST_CHECK(svg_of(assumed_plot) == expected);
+
+  svg_2d_plot range_plot; // By iterators.
+  range_plot.x_range(0, 10).y_range(-1, 1);
+  range_plot.plot(sorted.begin(), sorted.end(), "cos", assume_sorted).line_on(true);
+  BOOST_CHECK(svg_of(range_plot) == expected);
+} // BOOST_AUTO_TEST_CASE(test_sorted_series)
+
+BOOST_AUTO_TEST_CASE(test_write_again)
+{ // Writing a plot again draws it afresh, without repeating what was drawn by the write before.
+  multimap<double, double> data;
+  for (int i = 0; i != 20; ++i)
+  {
+    data.insert(std::make_pair(i * 0.5, std::sin(i * 0.5)));
+  }
+  data.insert(std::make_pair(5., numeric_limits<double>::infinity())); // 'at limit'.
+  svg_2d_plot plot;
+  plot.x_range(0, 10).y_range(-1, 1).legend_on(true).x_values_on(true).y_values_on(true);
+  plot.plot(data, "sin").line_on(true).shape(circlet);
+  const string first = svg_of(plot);
+  const string again = svg_of(plot);
+  BOOST_CHECK(again == first); // Lines, value-labels, legend lines, Y tick values and clip path each only once.
+  BOOST_CHECK_EQUAL(first.find("<clipPath id=\"plot_window\">"), first.rfind("<clipPath id=\"plot_window\">"));
+} // BOOST_AUTO_TEST_CASE(test_write_again)
+
+BOOST_AUTO_TEST_CASE(test_live_series)
+{ // A live data-series full to capacity draws just as a plot of its most recent data-points.
+  const std::size_t capacity = 100;
+  vector<pair<double, double> > recent;
+  svg_2d_plot live_plot;
+  live_plot.x_range(0, 300).y_range(-1, 1);
+  svg_2d_plot_series& live = live_plot.plot(vector<pair<double, double> >(), "live").capacity(capacity);
+  for (int i = 0; i != 250; ++i)
+  {
+    live.push_back(i, std::sin(i * 0.1));
+    if (i >= 250 - static_cast<int>(capacity))
+    {
+      recent.push_back(std::make_pair(i, std::sin(i * 0.1)));
+    }
+  }
+  BOOST_CHECK_EQUAL(live.x_min_max().first, 150.);
+  BOOST_CHECK_EQUAL(live.x_min_max().second, 249.);
+  svg_2d_plot recent_plot;
+  recent_plot.x_range(0, 300).y_range(-1, 1);
+  svg_2d_plot_series& last = recent_plot.plot(recent, "live");
+  BOOST_CHECK(live.x_min_max() == last.x_min_max());
+  BOOST_CHECK(svg_of(live_plot) == svg_of(recent_plot));
+
+  // Drawn again only if a data-point has been pushed since the last write.
+  live_plot.incremental_on(true);
+  const string before = svg_of(live_plot);
+  BOOST_CHECK(svg_of(live_plot) == before);
+  live.push_back(250, 0.5);
+  const string after = svg_of(live_plot);
+  BOOST_CHECK(after != before);
+  BOOST_CHECK_EQUAL(live.x_min_max().first, 151.);
+  recent.erase(recent.begin());
+  recent.push_back(std::make_pair(250., 0.5));
+  svg_2d_plot pushed_plot;
+  pushed_plot.x_range(0, 300).y_range(-1, 1);
+  pushed_plot.plot(recent, "live");
+  BOOST_CHECK(after == svg_of(pushed_plot));
+} // BOOST_AUTO_TEST_CASE(test_live_series)
+
+BOOST_AUTO_TEST_CASE(test_limit_mask)
+{ // Arrays of values are classified just as by is_limit, by SSE2 (if available) and the remainder one at a time.
+  const double max = (numeric_limits<double>::max)();
+  const double limit = max / detail::margin; // Largest value not 'at limit'.
+  const double specials[] = {0., -0., 1., -2.5, limit, -limit,
+    std::nextafter(limit, max), -std::nextafter(limit, max), std::nextafter(limit, 0.), -std::nextafter(limit, 0.),
+    max, -max, numeric_limits<double>::infinity(), -numeric_limits<double>::infinity(),
+    numeric_limits<double>::quiet_NaN(), -numeric_limits<double>::quiet_NaN(), numeric_limits<double>::denorm_min()};
+  const std::size_t n_specials = sizeof(specials) / sizeof(specials[0]);
+  vector<double> values(2 * 41);
+  for (std::size_t i = 0; i != values.size(); ++i)
+  { // Each special value in every position of a block of 16.
+    values[i] = specials[(i * 7) % n_specials];
+  }
+  for (std::size_t width = 1; width <= 2; ++width)
+  {
+    for (std::size_t n = 0; n <= 41; ++n)
+    { // All lengths, multiples of 16 or not.
+      vector<unsigned char> mask(n + 1, 0);
+      mask[n] = 7; // Past the end, so unchanged.
+      bool any_limit = false;
+      const bool any = detail::limit_mask(&values[0], n, &mask[0], width);
+      for (std::size_t i = 0; i != n; ++i)
+      {
+        bool at_limit = detail::is_limit(values[i * width]) || detail::is_limit(values[i * width + width - 1]);
+        BOOST_CHECK_MESSAGE(mask[i] == (at_limit ? 1 : 0), "width " << width << ", n " << n << ", data-point " << i);
+        any_limit = any_limit || at_limit;
+      }
+      BOOST_CHECK_EQUAL(any, any_limit);
+      BOOST_CHECK_EQUAL(mask[n], 7);
+    }
+  }
+  vector<unsigned char> mask(20, 1); // Marks already set are kept.
+  BOOST_CHECK(!detail::limit_mask(&specials[0], 4, &mask[0]));
+  BOOST_CHECK_EQUAL(mask[0], 1);
+} // BOOST_AUTO_TEST_CASE(test_limit_mask)
+
+BOOST_AUTO_TEST_CASE(test_transform_values)
+{ // Arrays of data-points are transformed and placed exactly as one at a time.
+  window_plot plot;
+  plot.x_range(0, 10).y_range(0, 10);
+  svg_of(plot); // Set the plot window and scaling.
+  const double max = (numeric_limits<double>::max)();
+  const double xs[] = {5., -20., 30., 5., 5., -0.1, 10., 0., -20., 30., numeric_limits<double>::quiet_NaN(), max, 5.};
+  const double ys[] = {5., 5., 5., -20., 30., 10.1, 5., 0., -20., 30., 5., 5., -numeric_limits<double>::infinity()};
+  const std::size_t n_xy = sizeof(xs) / sizeof(xs[0]); // Inside, beyond each side, near, on edges, at corners, and at limits.
+  const double window_margin = 3.;
+  for (std::size_t n = 1; n <= n_xy; n += 2)
+  { // Odd numbers of data-points, so some done one at a time.
+    vector<double> x(xs, xs + n);
+    vector<double> y(ys, ys + n);
+    vector<unsigned char> where(n);
+    const bool any = plot.transform_values(&x[0], &y[0], n, window_margin, &where[0]);
+    bool any_limit = false;
+    for (std::size_t i = 0; i != n; ++i)
+    {
+      double x1 = xs[i];
+      double y1 = ys[i];
+      plot.transform_x(x1);
+      plot.transform_y(y1);
+      unsigned char where1 = plot.where_in_window(x1, y1, window_margin);
+      if (detail::is_limit(x1) || detail::is_limit(y1))
+      {
+        where1 |= detail::was_limit;
+        any_limit = true;
+      }
+      BOOST_CHECK((x[i] == x1) || (std::isnan(x[i]) && std::isnan(x1)));
+      BOOST_CHECK_EQUAL(y[i], y1);
+      BOOST_CHECK_MESSAGE(where[i] == where1, "data-point " << i << " of " << n << ": " << int(where[i]) << " != " << int(where1));
+    }
+    BOOST_CHECK_EQUAL(any, any_limit);
+  }
+  // The sides beyond which data-points lie.
+  double x[] = {-20., 30., 5., 5., -20.};
+  double y[] = {5., 5., -20., 30., -20.};
+  unsigned char where[5];
+  plot.transform_values(x, y, 5, window_margin, where);
+  BOOST_CHECK_EQUAL(where[0], detail::left_of_window);
+  BOOST_CHECK_EQUAL(where[1], detail::right_of_window);
+  BOOST_CHECK_EQUAL(where[2], detail::below_window);
+  BOOST_CHECK_EQUAL(where[3], detail::above_window);
+  BOOST_CHECK_EQUAL(where[4], detail::left_of_window | detail::below_window);
+} // BOOST_AUTO_TEST_CASE(test_transform_values)
+
+BOOST_AUTO_TEST_CASE(test_clip_segment)
+{ // Lines clipped to a window from (0, 0) to (10, 10).
+  double t0;
+  double t1;
+  BOOST_CHECK(detail::clip_segment(2., 2., 8., 8., 0., 0., 10., 10., t0, t1)); // Inside.
+  BOOST_CHECK_EQUAL(t0, 0.);
+  BOOST_CHECK_EQUAL(t1, 1.);
+  BOOST_CHECK(detail::clip_segment(-5., 5., 15., 5., 0., 0., 10., 10., t0, t1)); // Crossing.
+  BOOST_CHECK_EQUAL(t0, 0.25);
+  BOOST_CHECK_EQUAL(t1, 0.75);
+  BOOST_CHECK(detail::clip_segment(5., 15., 5., 5., 0., 0., 10., 10., t0, t1)); // Entering from below.
+  BOOST_CHECK_EQUAL(t0, 0.5);
+  BOOST_CHECK_EQUAL(t1, 1.);
+  BOOST_CHECK(detail::clip_segment(-10., -10., 20., 20., 0., 0., 10., 10., t0, t1)); // Through corners.
+  BOOST_CHECK_CLOSE_FRACTION(t0, 1. / 3, 1e-15);
+  BOOST_CHECK_CLOSE_FRACTION(t1, 2. / 3, 1e-15);
+  BOOST_CHECK(!detail::clip_segment(-5., -1., 15., -1., 0., 0., 10., 10., t0, t1)); // Parallel, outside.
+  BOOST_CHECK(!detail::clip_segment(12., 0., 12., 10., 0., 0., 10., 10., t0, t1));
+  BOOST_CHECK(!detail::clip_segment(-2., 1., 1., -2., 0., 0., 10., 10., t0, t1)); // Misses a corner.
+  BOOST_CHECK(!detail::clip_segment(12., 9., 9., 12., 0., 0., 10., 10., t0, t1));
+  BOOST_CHECK(!detail::clip_segment(-5., 5., -1., 5., 0., 0., 10., 10., t0, t1)); // Stops short.
+  BOOST_CHECK(detail::clip_segment(-1., 1., 1., -1., 0., 0., 10., 10., t0, t1)); // Touches a corner.
+  BOOST_CHECK_EQUAL(t0, 0.5);
+  BOOST_CHECK_EQUAL(t1, 0.5);
+  BOOST_CHECK(detail::clip_segment(0., -5., 0., 15., 0., 0., 10., 10., t0, t1)); // Along an edge.
+  BOOST_CHECK_EQUAL(t0, 0.25);
+  BOOST_CHECK_EQUAL(t1, 0.75);
+  BOOST_CHECK(detail::clip_segment(-5., 5., 0., 5., 0., 0., 10., 10., t0, t1)); // Ends on an edge.
+  BOOST_CHECK_EQUAL(t0, 1.);
+  BOOST_CHECK_EQUAL(t1, 1.);
+  BOOST_CHECK(detail::clip_segment(5., 5., 5., 5., 0., 0., 10., 10., t0, t1)); // A point, inside.
+} // BOOST_AUTO_TEST_CASE(test_clip_segment)
+
+BOOST_AUTO_TEST_CASE(test_lttb_streaming)
+{ // A data-series downsampled by lttb is streamed the same as written from the document tree.
+  multimap<double, double> data;
+  for (int i = 0; i != 1000; ++i)
+  {
+    data.insert(std::make_pair(i * 0.001, std::sin(i * 0.05)));
+  }
+  svg_2d_plot plot;
+  plot.x_range(0, 1).y_range(-1, 1).streaming_on(true);
+  plot.plot(data, "lttb").line_on(true).shape(circlet).size(3).downsample(lttb, 50);
+  const string streamed = svg_of(plot); // Streamed first, before any update_image().
+  plot.streaming_on(false);
+  const string tree = svg_of(plot);
+  BOOST_CHECK(streamed == tree);
+  BOOST_CHECK(streamed.size() < 20000); // Only 50 data-points drawn.
+  plot.streaming_on(true);
+  BOOST_CHECK(svg_of(plot) == tree);
+} // BOOST_AUTO_TEST_CASE(test_lttb_streaming)
+
+BOOST_AUTO_TEST_CASE(test_streaming)
+{ // With default options, and with markers as symbols, a plot streamed is the same as written from the document tree.
+  map<double, double> data;
+  multimap<unc<false>, unc<false> > unc_data;
+  for (int i = 0; i != 200; ++i)
+  {
+    data[i * 0.05] = std::sin(i * 0.05);
+    unc_data.insert(std::make_pair(unc<false>(i * 0.05, 0.1f), unc<false>(std::cos(i * 0.05), 0.2f)));
+  }
+  data[3.3] = numeric_limits<double>::quiet_NaN(); // And 'at limit'.
+  data[20.] = 0.5; // Outside the plot window.
+  for (int symbols = 0; symbols != 2; ++symbols)
+  {
+    svg_2d_plot plot;
+    plot.x_range(0, 10).y_range(-1, 1).legend_on(true).x_values_on(true).y_values_on(true);
+    plot.plot(data, "sin").line_on(true).shape(circlet);
+    plot.plot(unc_data, "cos").shape(square).bar_opt(y_block);
+    if (symbols == 1)
+    {
+      plot.markers(use_markers);
+    }
+    plot.streaming_on(true);
+    const string streamed = svg_of(plot); // Streamed first, before any update_image().
+    plot.streaming_on(false);
+    BOOST_CHECK(streamed == svg_of(plot));
+  }
+} // BOOST_AUTO_TEST_CASE(test_streaming)
@@ -30,6 +30,17 @@
 #include <boost/svg_plot/svg_fwd.hpp> // Forward declarations.
   // Included here as a cross check.
 
+#include <boost/svg_plot/detail/value_span.hpp>
+#include <boost/svg_plot/detail/downsample.hpp>
+#include <boost/svg_plot/csv_reader.hpp>
+#include <boost/svg_plot/binary_reader.hpp>
+
+#include <cmath>
+  // using std::isnan;
+#include <cstdio>
+  // using std::remove;
+#include <fstream>
+  using std::ofstream;
 #include <iostream>
   using std::cout;
   using std::endl;
@@ -37,6 +48,12 @@
   using std::string;
 #include <sstream>
   using std::ostringstream;
+#include <limits>
+  using std::numeric_limits;
+#include <numeric>
+  using std::accumulate;
+#include <vector>
+  using std::vector;
 
 BOOST_AUTO_TEST_CASE(test_styles)
 {
@@ -300,6 +317,620 @@ BOOST_AUTO_TEST_CASE(test_styles)
 
 } // BOOST_AUTO_TEST_CASE(test_styles)
 
+BOOST_AUTO_TEST_CASE(test_arena)
+{ // Elements allocated from the document arena must write exactly as heap elements.
+  svg heap_svg;
+  svg arena_svg;
+  arena_svg.arena_on(true);
+  BOOST_CHECK(arena_svg.arena_on());
+  BOOST_CHECK(!heap_svg.arena_on());
+
+  svg* svgs[2] = {&heap_svg, &arena_svg};
+  for (int i = 0; i < 2; ++i)
+  {
+    g_element& g = svgs[i]->add_g_element();
+    g.id("points");
+    for (int j = 0; j < 100; ++j)
+    {
+      g.circle(j, j, 2);
+      g.text(j, j + 1, "&#x25CF;").tspan("a");
+    }
+    g.add_g_element().line(1, 2, 3, 4);
+  }
+  BOOST_CHECK_EQUAL(heap_svg.arena().bytes_used(), 0U);
+  BOOST_CHECK(arena_svg.arena().bytes_used() > 0U);
+
+  ostringstream heap_out;
+  ostringstream arena_out;
+  heap_svg.write(heap_out);
+  arena_svg.write(arena_out);
+  BOOST_CHECK_EQUAL(heap_out.str(), arena_out.str());
+
+  // Releasing the arena removes only the elements allocated from it.
+  arena_svg.arena_release();
+  BOOST_CHECK_EQUAL(arena_svg.document_size(), 1U); // Group itself was on the heap.
+  BOOST_CHECK_EQUAL(arena_svg.gs(0).size(), 0U);
+  BOOST_CHECK_EQUAL(arena_svg.arena().bytes_used(), 0U);
+} // BOOST_AUTO_TEST_CASE(test_arena)
+
+BOOST_AUTO_TEST_CASE(test_svg_copy)
+{ // A copy has the image sizes and options for writing of the original (but no elements).
+  svg my_svg;
+  my_svg.x_size(300);
+  my_svg.coord_precision(5);
+  my_svg.compact_paths(true);
+  my_svg.compact_output(true);
+  my_svg.css_classes(true);
+  my_svg.markers(use_markers);
+  my_svg.write_threads(2);
+  my_svg.arena_on(true);
+  my_svg.add_g_element().circle(1, 2, 3);
+  svg copy(my_svg);
+  BOOST_CHECK_EQUAL(copy.x_size(), 300U);
+  BOOST_CHECK_EQUAL(copy.coord_precision(), 5);
+  BOOST_CHECK(copy.compact_paths());
+  BOOST_CHECK(!copy.compress_on());
+  BOOST_CHECK(copy.compact_output());
+  BOOST_CHECK(copy.css_classes());
+  BOOST_CHECK(copy.markers() == use_markers);
+  BOOST_CHECK_EQUAL(copy.write_threads(), 2U);
+  BOOST_CHECK(copy.arena_on());
+  BOOST_CHECK_EQUAL(copy.document_size(), 0U);
+  copy.add_g_element().circle(1, 2, 3);
+  ostringstream out;
+  ostringstream copy_out;
+  my_svg.write(out);
+  copy.write(copy_out);
+  BOOST_CHECK_EQUAL(out.str(), copy_out.str());
+} // BOOST_AUTO_TEST_CASE(test_svg_copy)
+
+BOOST_AUTO_TEST_CASE(test_path)
+{ // All path commands, stored compactly, must write as before.
+  path_element my_path;
+  my_path.M(1, 2).L(3.5, 4).l(-1, 2).h(5).H(6).v(7).V(8).c(1, 2, 3, 4, 5, 6).C(1, 2, 3, 4, 5, 6)
+    .q(1, 2, 3, 4).Q(1, 2, 3, 4).s(1, 2, 3, 4).S(1, 2, 3, 4).t(1, 2).T(1, 2).m(1, 2).z();
+  BOOST_CHECK_EQUAL(my_path.size(), 17U);
+  ostringstream oss;
+  my_path.write(oss);
+  BOOST_CHECK_EQUAL(oss.str(),
+    "\t\t<path d=\"\n"
+    "\t\t\tM1,2 L3.5,4 \n"
+    "l-1,2 \n"
+    "h5 H6 v7 V8 c1,2 3,4 5,6 C1,2 3,4 5,6 q1 2 3 4 Q1 2 3 4 s1,2 3,4 S1,2 3,4 t1,2 T1,2 m1,2 Z"
+    "\t\t\t\" fill=\"none\"/>\n");
+} // BOOST_AUTO_TEST_CASE(test_path)
+
+BOOST_AUTO_TEST_CASE(test_compact_path)
+{ // Compact path data must be shortest relative, horizontal or vertical, and omit implied command letters.
+  path_element my_path;
+  my_path.M(10, 20).L(12.5, 20).L(12.5, 30).L(15, 25).L(100.25, 300.75).l(3, 0).l(0, -2).l(1, 1).Z()
+    .M(5, 5).C(1, 2, 3, 4, 5, 6).h(-3).Q(1, -2, 3, 4);
+  ostringstream oss;
+  oss.precision(3);
+  oss.iword(detail::compact_paths_index()) = true;
+  my_path.write(oss);
+  BOOST_CHECK_EQUAL(oss.str(),
+    "\t\t<path d=\"M10,20h2.5V30L15,25l85,276h3v-2l1,1ZM5,5C1,2 3,4 5,6h-3Q1-2 3,4\" fill=\"none\"/>\n");
+
+  svg my_svg; // Document option, off by default.
+  BOOST_CHECK(!my_svg.compact_paths());
+  my_svg.compact_paths(true);
+  my_svg.path().M(1, 1).L(2, 1).L(3, 1);
+  ostringstream svg_out;
+  my_svg.write(svg_out);
+  BOOST_CHECK(svg_out.str().find("<path d=\"M1,1H2 3\"") != std::string::npos);
+  BOOST_CHECK_EQUAL(svg_out.iword(detail::compact_paths_index()), 0); // Not left set on the caller's stream.
+} // BOOST_AUTO_TEST_CASE(test_compact_path)
+
+BOOST_AUTO_TEST_CASE(test_output_sink)
+{ // Writing to a string_sink must append exactly what is written to a stream, after pre-sizing.
+  svg my_svg;
+  g_element& g = my_svg.add_g_element();
+  for (int i = 0; i < 1000; ++i)
+  {
+    g.circle(i, i, 2);
+  }
+  ostringstream oss;
+  my_svg.write(oss);
+  std::string bytes("<!-- -->");
+  string_sink sink(bytes);
+  my_svg.write(sink);
+  BOOST_CHECK_EQUAL(bytes, "<!-- -->" + oss.str());
+  BOOST_CHECK_GE(bytes.capacity(), my_svg.size_estimate()); // Reserved once.
+  BOOST_CHECK_GE(my_svg.size_estimate(), oss.str().size());
+
+  ostringstream forwarded;
+  ostream_sink to_stream(forwarded);
+  my_svg.write(to_stream);
+  BOOST_CHECK_EQUAL(forwarded.str(), oss.str());
+
+  {
+    file_sink to_file("test_file_sink.svg", 100); // Small buffer, so filled many times.
+    my_svg.write(to_file);
+    to_file.close();
+    to_file.close(); // Closing again does nothing.
+  }
+  std::ifstream in("test_file_sink.svg", std::ios_base::binary);
+  ostringstream from_file;
+  from_file << in.rdbuf();
+  BOOST_CHECK(from_file.str() == oss.str());
+  in.close();
+  std::remove("test_file_sink.svg");
+#ifdef __linux__
+  file_sink full("/dev/full"); // Always full, so output is lost.
+  my_svg.write(full);
+  BOOST_CHECK_THROW(full.close(), std::runtime_error);
+#endif
+
+  BOOST_CHECK(detail::is_svgz("plot.svgz"));
+  BOOST_CHECK(!detail::is_svgz("plot.svg"));
+#ifndef BOOST_SVG_SVGZ
+  my_svg.write("test_svg.svgz"); // Written uncompressed without zlib.
+  std::ifstream svgz("test_svg.svgz", std::ios_base::binary);
+  ostringstream from_svgz;
+  from_svgz << svgz.rdbuf();
+  BOOST_CHECK(from_svgz.str().find("<svg ") != std::string::npos);
+  svgz.close();
+  std::remove("test_svg.svgz");
+  my_svg.compress_on(true);
+  BOOST_CHECK_THROW(my_svg.write("test_svg.svgz"), std::runtime_error); // Needs zlib.
+  my_svg.compress_on(false);
+#endif
+} // BOOST_AUTO_TEST_CASE(test_output_sink)
+
+BOOST_AUTO_TEST_CASE(test_write_threads)
+{ // Layers written in parallel must be exactly the same as written in turn.
+  svg my_svg;
+  my_svg.add_g_element().id("empty");
+  for (int layer = 0; layer < 3; ++layer)
+  {
+    g_element& g = my_svg.add_g_element();
+    g.id("layer");
+    g.style().stroke_color(red);
+    for (int i = 0; i < 3000; ++i)
+    {
+      g.circle(i, layer, 2);
+      g_element& child = g.add_g_element(); // Some large, some empty, child groups.
+      for (int j = 0; j < (i % 1000 == 0 ? 3000 : 0); ++j)
+      {
+        child.line(i, j, j, i);
+      }
+    }
+  }
+  ostringstream sequential;
+  my_svg.write(sequential);
+  my_svg.write_threads(3);
+  BOOST_CHECK_EQUAL(my_svg.write_threads(), 3U);
+  ostringstream parallel;
+  my_svg.write(parallel);
+  BOOST_CHECK(parallel.str() == sequential.str()); // (Too long to show if not equal).
+  BOOST_CHECK_GT(sequential.str().size(), 1000000U);
+
+  svg mixed; // Elements added to the document itself, before, between and after group layers.
+  mixed.line(0, 0, 10, 10);
+  mixed.add_g_element().circle(1, 1, 2);
+  for (int i = 0; i < 20000; ++i)
+  { // Enough to be split into several segments.
+    mixed.circle(i, i, 3);
+  }
+  mixed.rect(1, 2, 3, 4);
+  mixed.add_g_element().line(1, 2, 3, 4);
+  mixed.text(5, 5, "last", text_style(), align_style::left_align, horizontal);
+  ostringstream mixed_sequential;
+  mixed.write(mixed_sequential);
+  mixed.write_threads(3);
+  ostringstream mixed_parallel;
+  mixed.write(mixed_parallel);
+  BOOST_CHECK(mixed_parallel.str() == mixed_sequential.str());
+  BOOST_CHECK(mixed_sequential.str().find("last") != string::npos);
+} // BOOST_AUTO_TEST_CASE(test_write_threads)
+
+BOOST_AUTO_TEST_CASE(test_poly_points)
+{ // Points added in bulk from arrays or ranges must be the same as added one by one.
+  const double xs[] = {1, 3, 5};
+  const double ys[] = {2, 4, 6};
+  polyline_element one_by_one(1, 2);
+  one_by_one.P(3, 4).P(5, 6);
+  polyline_element from_arrays;
+  from_arrays.reserve(3).P(xs, ys, 3);
+  std::vector<double> vx(xs, xs + 3);
+  std::vector<double> vy(ys, ys + 3);
+  polyline_element from_ranges;
+  from_ranges.P(vx, vy);
+  BOOST_CHECK_EQUAL(from_arrays.poly_points.size(), 3U);
+  ostringstream oss1, oss2, oss3;
+  one_by_one.write(oss1);
+  from_arrays.write(oss2);
+  from_ranges.write(oss3);
+  BOOST_CHECK_EQUAL(oss1.str(), oss2.str());
+  BOOST_CHECK_EQUAL(oss1.str(), oss3.str());
+  polygon_element copied(one_by_one.poly_points);
+  polygon_element copy(copied);
+  BOOST_CHECK_EQUAL(copy.poly_points.size(), 3U);
+  BOOST_CHECK_EQUAL(copied.poly_points.size(), 3U); // Copying no longer empties the source.
+} // BOOST_AUTO_TEST_CASE(test_poly_points)
+
+BOOST_AUTO_TEST_CASE(test_stream)
+{ // Groups streamed as children are added must write exactly as the retained tree.
+  svg tree_svg;
+  svg stream_svg;
+  ostringstream tree_out;
+  ostringstream stream_out;
+  tree_svg.add_g_element().id("empty");
+  stream_svg.add_g_element().id("empty");
+  stream_svg.gs(0).stream(&stream_out);
+  svg* svgs[2] = {&tree_svg, &stream_svg};
+  for (int i = 0; i < 2; ++i)
+  {
+    g_element& layer = i == 0 ? svgs[i]->add_g_element() : svgs[i]->add_g_element().stream(&stream_out);
+    layer.id("points");
+    for (int j = 0; j < 100; ++j)
+    {
+      g_element& g = layer.add_g_element();
+      g.style().stroke_color(red);
+      g.circle(j, j, 2);
+      g.text(j, j + 1, "&#x25CF;").tspan("a");
+      layer.add_g_element(); // Empty groups write nothing.
+    }
+    BOOST_CHECK_EQUAL(layer.size(), i == 0 ? 200U : 1U); // Only the last is kept while streaming.
+  }
+  stream_svg.gs(0).end_stream();
+  stream_svg.gs(1).end_stream();
+  BOOST_CHECK(!stream_svg.gs(1).streaming());
+  BOOST_CHECK_EQUAL(stream_svg.gs(1).size(), 0U);
+  tree_svg.gs(0).write(tree_out);
+  tree_svg.gs(1).write(tree_out);
+  BOOST_CHECK_EQUAL(tree_out.str(), stream_out.str());
+
+  // Streaming to a null stream discards children.
+  g_element& discard = stream_svg.add_g_element().stream(0);
+  discard.line(1, 2, 3, 4);
+  discard.line(1, 2, 3, 4);
+  BOOST_CHECK(discard.pending());
+  discard.end_stream();
+  BOOST_CHECK_EQUAL(discard.size(), 0U);
+} // BOOST_AUTO_TEST_CASE(test_stream)
+
+BOOST_AUTO_TEST_CASE(test_number_format)
+{ // Coordinates formatted by detail::coord must be the same as by iostream.
+  const double values[] = {0., -0., 1., -1.5, 0.125, 2.5, 9.9996, 99.95, 123.456, 1234.5, 1e6, 1.23456e-5, 0.0001, 0.00012345,
+    3.14159265358979, 1e22, 1e300, 5e-324, std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN()};
+  for (int precision = 0; precision <= 17; ++precision)
+  {
+    ostringstream coord_out;
+    ostringstream double_out;
+    coord_out.precision(precision);
+    double_out.precision(precision);
+    for (std::size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+    {
+      coord_out << detail::coord(values[i]) << ' ';
+      double_out << values[i] << ' ';
+    }
+    BOOST_CHECK_EQUAL(coord_out.str(), double_out.str());
+  }
+  ostringstream fixed_out;
+  fixed_out << std::fixed << detail::coord(1.5); // Stream flags are respected.
+  BOOST_CHECK_EQUAL(fixed_out.str(), "1.500000");
+
+  double v; // Fields of a .csv file, as read by read_csv.
+  BOOST_CHECK(detail::parse_g("-12.5", 5, v) && v == -12.5);
+  BOOST_CHECK(detail::parse_g("+1E2", 4, v) && v == 100.);
+  BOOST_CHECK(detail::parse_g("0.1234567890123456789", 21, v) && v == 0.1234567890123456789);
+  BOOST_CHECK(!detail::parse_g("---", 3, v));
+  BOOST_CHECK(!detail::parse_g("1e", 2, v));
+  BOOST_CHECK(!detail::parse_g("", 0, v));
+} // BOOST_AUTO_TEST_CASE(test_number_format)
+
+BOOST_AUTO_TEST_CASE(test_compact_output)
+{ // Minified SVG XML, see svg::compact_output.
+  string_sink out;
+  {
+    minify_sink minify(&out);
+    std::ostream os(&minify);
+    os << "<!-- comment -->\n<g id=\"a\" stroke=\"rgb(255,0,0)\" fill=\"rgb(1,2,3)\" stroke-width=\"1\">\n"
+      "\t<rect x=\"0\" y=\"2\" stroke=\"rgb(255,0,0)\"/>\n"
+      "\t<text x=\"1\"  y=\"2\"  text-anchor=\"start\">one  two\n\t\t<tspan fill=\"rgb(1,2,3)\">3</tspan>\n\t</text>\n"
+      "\t<g class=\"c\"><line stroke=\"rgb(255,0,0)\"/></g>\n</g>\n";
+    os.flush();
+    minify.close();
+  }
+  BOOST_CHECK_EQUAL(out.str(), "<g id=\"a\" stroke=\"#f00\" fill=\"#010203\"><rect y=\"2\"/>"
+    "<text x=\"1\" y=\"2\">one two <tspan>3</tspan></text>"
+    "<g class=\"c\"><line stroke=\"#f00\"/></g></g>");
+
+  svg my_svg;
+  my_svg.compact_output(true);
+  g_element& g = my_svg.add_g_element();
+  g.style().stroke_color(blue);
+  g.line(1, 2, 3, 4);
+  ostringstream compact_out;
+  my_svg.write(compact_out);
+  BOOST_CHECK(compact_out.str().find("<!--") == std::string::npos);
+  BOOST_CHECK(compact_out.str().find("<g stroke=\"#00f\"><line x1=\"1\" y1=\"2\" x2=\"3\" y2=\"4\"/></g>") != std::string::npos);
+} // BOOST_AUTO_TEST_CASE(test_compact_output)
+
+BOOST_AUTO_TEST_CASE(test_css_classes)
+{ // Repeated group styles written once as CSS classes, see svg::css_classes.
+  svg my_svg;
+  my_svg.css_classes(true);
+  for (int i = 0; i < 3; ++i)
+  { // Two groups with the same style, and one different.
+    g_element& g = my_svg.add_g_element();
+    g.style().stroke_color(i == 2 ? blue : red).stroke_width(2);
+    g.line(1, 2, 3, 4);
+  }
+  ostringstream css_out;
+  my_svg.write(css_out);
+  const std::string s = css_out.str();
+  BOOST_CHECK(s.find("<![CDATA[.s0{stroke:rgb(255,0,0);stroke-width:2px}\n]]>") != std::string::npos);
+  BOOST_CHECK(s.find(".s1") == std::string::npos); // Blue style is not repeated, so is not a class.
+  BOOST_CHECK(s.find("<g class=\"s0\">") != std::string::npos);
+  BOOST_CHECK(s.find("<g stroke=\"rgb(0,0,255)\" stroke-width=\"2\">") != std::string::npos);
+  BOOST_CHECK(css_out.pword(detail::style_classes_index()) == 0); // Classes are not used after the document.
+
+  detail::style_classes lengths; // Lengths always have units, however written.
+  lengths.count(" stroke-width=\"1e-05\" font-size=\"12.5\"");
+  lengths.count(" stroke-width=\"1e-05\" font-size=\"12.5\"");
+  lengths.name_classes();
+  ostringstream css;
+  lengths.write_css(css);
+  BOOST_CHECK_EQUAL(css.str(), ".s0{stroke-width:1e-05px;font-size:12.5px}\n");
+} // BOOST_AUTO_TEST_CASE(test_css_classes)
+
+BOOST_AUTO_TEST_CASE(test_marker_symbols)
+{ // Markers defined once as a symbol, and drawn by use elements, see svg::markers.
+  svg my_svg;
+  my_svg.markers(use_markers);
+  BOOST_CHECK(my_svg.marker_id("circle") == 0);
+  my_svg.add_marker_symbol("circle").circle(0, 0, 2);
+  BOOST_CHECK_EQUAL(*my_svg.marker_id("circle"), "m0");
+  my_svg.add_marker_symbol("dot").circle(0, 0, 1);
+  my_svg.inline_marker("dot"); // Removes the symbol just added.
+  BOOST_CHECK_EQUAL(*my_svg.marker_id("dot"), "");
+  g_element& g = my_svg.add_g_element();
+  g.use(10, 20, "m0");
+  g.use(30, 40, "m0");
+  ostringstream use_out;
+  my_svg.write(use_out);
+  const std::string s = use_out.str();
+  BOOST_CHECK(s.find("xmlns:xlink=\"http://www.w3.org/1999/xlink\"") != std::string::npos);
+  BOOST_CHECK(s.find("<defs>\n\t<symbol id=\"m0\" overflow=\"visible\">\n\t\t<circle cx=\"0\" cy=\"0\" r=\"2\"/>\n\t</symbol>\n</defs>") != std::string::npos);
+  BOOST_CHECK(s.find("id=\"m1\"") == std::string::npos);
+  BOOST_CHECK(s.find("<use xlink:href=\"#m0\" x=\"30\" y=\"40\"/>") != std::string::npos);
+  my_svg.clear_markers();
+  BOOST_CHECK(my_svg.marker_id("circle") == 0);
+} // BOOST_AUTO_TEST_CASE(test_marker_symbols)
+
+BOOST_AUTO_TEST_CASE(test_glyphs_element)
+{ // The same glyph at many positions as one text element, see svg::markers batched_markers.
+  g_element g;
+  glyphs_element& diamonds = g.glyphs("&#x2666;", text_style(10, ""), align_style::center_align);
+  diamonds.P(1, 2).P(3.5, 4).P(5, 6);
+  BOOST_CHECK_EQUAL(diamonds.size(), 3U);
+  BOOST_CHECK(diamonds.same("&#x2666;", text_style(10, ""), align_style::center_align));
+  BOOST_CHECK(!diamonds.same("&#x2665;", text_style(10, ""), align_style::center_align));
+  ostringstream glyphs_out;
+  diamonds.write(glyphs_out);
+  BOOST_CHECK_EQUAL(glyphs_out.str(),
+    "\t\t<text x=\"1 3.5 5\" y=\"2 4 6\" text-anchor=\"middle\" font-size=\"10\">&#x2666;&#x2666;&#x2666;</text>\n");
+} // BOOST_AUTO_TEST_CASE(test_glyphs_element)
+
+BOOST_AUTO_TEST_CASE(test_value_span)
+{ // Non-owning views of values, contiguous or strided, for plot_view.
+  double column[] = {1., 2., 3.};
+  value_span all(column);
+  BOOST_CHECK_EQUAL(all.size(), 3U);
+  BOOST_CHECK_EQUAL(all[2], 3.);
+
+  struct sample { double time; double volts; int flags; };
+  sample samples[] = {{0., 1.5, 0}, {1., 2.5, 0}};
+  value_span volts(samples, 2, &sample::volts);
+  BOOST_CHECK_EQUAL(volts.stride(), sizeof(sample));
+  BOOST_CHECK_EQUAL(volts[0], 1.5);
+  BOOST_CHECK_EQUAL(volts[1], 2.5);
+  BOOST_CHECK(value_span().empty());
+  // Iterable as a container (random access, by stride).
+  BOOST_CHECK_EQUAL(volts.end() - volts.begin(), 2);
+  BOOST_CHECK_EQUAL(*(volts.begin() + 1), 2.5);
+  BOOST_CHECK_EQUAL(std::accumulate(all.begin(), all.end(), 0.), 6.);
+} // BOOST_AUTO_TEST_CASE(test_value_span)
+
+BOOST_AUTO_TEST_CASE(test_m4_columns)
+{ // Only first, minimum, maximum and last data-points of each pixel column are kept, in order.
+  double x[] = {0.1, 0.2, 0.3, 0.4, 0.5, 1.5, 2.1, 2.2};
+  double y[] = {5., 9., 1., 7., 6., 3., 4., 4.};
+  unsigned char where[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  double kept_x[12];
+  double kept_y[12];
+  unsigned char kept_where[12];
+  detail::m4_columns m4_kept;
+  std::size_t n = m4_kept.add(x, y, where, 8, kept_x, kept_y, kept_where);
+  BOOST_CHECK_EQUAL(n, 5U); // Columns 0 and 1 complete.
+  n += m4_kept.finish(kept_x + n, kept_y + n, kept_where + n);
+  BOOST_CHECK_EQUAL(n, 7U);
+  double expect_x[] = {0.1, 0.2, 0.3, 0.5, 1.5, 2.1, 2.2}; // Without the 4th of column 0.
+  for (std::size_t i = 0; i != n; ++i)
+  {
+    BOOST_CHECK_EQUAL(kept_x[i], expect_x[i]);
+  }
+  BOOST_CHECK_EQUAL(kept_y[2], 1.);
+  BOOST_CHECK_EQUAL(kept_where[3], 5);
+  BOOST_CHECK_EQUAL(m4_kept.finish(kept_x, kept_y, kept_where), 0U);
+} // BOOST_AUTO_TEST_CASE(test_m4_columns)
+
+struct zigzag
+{ // data-points 0, 1, 2... with Y 0, except a spike at X = 5 (for lttb_select).
+  void values(std::size_t first, std::size_t n, double* x, double* y) const
+  {
+    for (std::size_t j = 0; j != n; ++j)
+    {
+      x[j] = static_cast<double>(first + j);
+      y[j] = (first + j == 5) ? 10. : 0.;
+    }
+  }
+};
+
+BOOST_AUTO_TEST_CASE(test_lttb_select)
+{ // First, last, and the data-point of each bucket making the largest triangle are kept.
+  std::vector<std::size_t> kept;
+  detail::lttb_select(zigzag(), 12, 4, kept, 1); // Buckets 1 to 5, and 6 to 10.
+  BOOST_REQUIRE_EQUAL(kept.size(), 4U);
+  BOOST_CHECK_EQUAL(kept[0], 0U);
+  BOOST_CHECK_EQUAL(kept[1], 5U); // The spike.
+  BOOST_CHECK_EQUAL(kept[3], 11U);
+  detail::lttb_select(zigzag(), 12, 12, kept);
+  BOOST_CHECK(kept.empty()); // All drawn.
+} // BOOST_AUTO_TEST_CASE(test_lttb_select)
+
+BOOST_AUTO_TEST_CASE(test_clip_path_replaced)
+{ // A clip path with the same id (as when a plot is drawn again) replaces the one before.
+  svg my_svg;
+  my_svg.clip_path(rect_element(0, 0, 100, 100), "plot_window");
+  my_svg.clip_path(rect_element(10, 10, 50, 50), "plot_window");
+  ostringstream oss;
+  my_svg.write(oss);
+  std::string out = oss.str();
+  BOOST_CHECK_EQUAL(out.find("<clipPath id=\"plot_window\">"), out.rfind("<clipPath id=\"plot_window\">"));
+  BOOST_CHECK(out.find("width=\"50\"") != std::string::npos);
+} // BOOST_AUTO_TEST_CASE(test_clip_path_replaced)
+
+BOOST_AUTO_TEST_CASE(test_read_csv)
+{ // Header names, quoted fields, missing and non-numeric fields, CRLF and blank lines.
+  const char* filename = "test_read_csv.csv";
+  {
+    ofstream csv(filename, std::ios::binary);
+    csv << "No, \"Time, local\" ,Temp\r\n"
+      "1,\"12,5\",-2.5\r\n"
+      "\r\n"
+      "2,3e2,---\r\n"
+      "\n"
+      "3,,4.75\n"
+      "4\n";
+  }
+  csv_columns columns = read_csv(filename);
+  BOOST_REQUIRE_EQUAL(columns.size(), 3U);
+  BOOST_CHECK_EQUAL(columns.names()[0], "No");
+  BOOST_CHECK_EQUAL(columns.names()[1], "Time, local");
+  BOOST_CHECK_EQUAL(columns.names()[2], "Temp");
+  BOOST_REQUIRE_EQUAL(columns.rows(), 4U); // Blank lines skipped.
+  const double no[] = {1., 2., 3., 4.};
+  BOOST_CHECK_EQUAL_COLLECTIONS(columns.column("No").begin(), columns.column("No").end(), no, no + 4);
+  BOOST_CHECK(std::isnan(columns.column(1)[0])); // "12,5" is quoted, so one field, but not a number.
+  BOOST_CHECK_EQUAL(columns.column(1)[1], 300.);
+  BOOST_CHECK(std::isnan(columns.column(1)[2])); // Empty.
+  BOOST_CHECK(std::isnan(columns.column(1)[3])); // Missing.
+  BOOST_CHECK_EQUAL(columns.column("Temp")[0], -2.5); // Not "-2.5\r".
+  BOOST_CHECK(std::isnan(columns.column("Temp")[1])); // "---".
+  BOOST_CHECK_EQUAL(columns.column("Temp")[2], 4.75);
+  BOOST_CHECK(std::isnan(columns.column(2)[3]));
+  BOOST_CHECK_THROW(columns.column("Pressure"), std::runtime_error);
+
+  columns = read_csv(filename, ',', false); // No header, so the first line is (not numbers) values.
+  BOOST_CHECK(columns.names().empty());
+  BOOST_CHECK_EQUAL(columns.rows(), 5U);
+  BOOST_CHECK(std::isnan(columns.column(0)[0]));
+
+  { // Large enough to be split between threads (at least 1 MB each).
+    ofstream csv(filename, std::ios::binary);
+    csv << "x;y\n";
+    for (int i = 0; i != 300000; ++i)
+    {
+      csv << i << ";" << i * 0.5 << ((i % 3 == 0) ? "\r\n" : "\n");
+      if (i % 1000 == 0)
+      {
+        csv << "\n";
+      }
+    }
+  }
+  csv_columns serial = read_csv(filename, ';', true, 1);
+  csv_columns parallel = read_csv(filename, ';', true, 4);
+  std::remove(filename);
+  BOOST_REQUIRE_EQUAL(serial.rows(), 300000U);
+  BOOST_REQUIRE_EQUAL(parallel.rows(), 300000U);
+  BOOST_CHECK(serial.column("x") == parallel.column("x"));
+  BOOST_CHECK(serial.column("y") == parallel.column("y"));
+  BOOST_CHECK_EQUAL(parallel.column(0)[299999], 299999.);
+  BOOST_CHECK_EQUAL(parallel.column(1)[123457], 123457 * 0.5);
+} // BOOST_AUTO_TEST_CASE(test_read_csv)
+
+void write_npy(const char* filename, const std::string& header, const double* values, std::size_t n, int version = 1)
+{ // Write a .npy file with the header dict, and n values (perhaps fewer than its shape).
+  ofstream npy(filename, std::ios::binary);
+  npy.write("\x93NUMPY", 6);
+  npy.put(static_cast<char>(version)).put(0);
+  const std::size_t header_size = header.size() + 1; // And line end.
+  npy.put(static_cast<char>(header_size & 0xFF)).put(static_cast<char>(header_size >> 8));
+  if (version != 1)
+  {
+    npy.put(0).put(0);
+  }
+  npy << header << '\n';
+  npy.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(n * sizeof(double)));
+}
+
+BOOST_AUTO_TEST_CASE(test_read_binary)
+{ // .npy and raw float64 files, mapped as columns.
+  const char* filename = "test_read_binary.npy";
+  const double values[] = {0., 1., 2., 3., 4., 5.};
+  {
+    write_npy(filename, "{'descr': '<f8', 'fortran_order': False, 'shape': (6,), }", values, 6);
+    mapped_columns m = read_npy(filename);
+    BOOST_REQUIRE_EQUAL(m.size(), 1U);
+    BOOST_REQUIRE_EQUAL(m.rows(), 6U);
+    BOOST_CHECK_EQUAL(m.column(0)[5], 5.);
+    BOOST_CHECK_THROW(m.column(1), std::runtime_error);
+  }
+  {
+    write_npy(filename, "{'descr': '<f8', 'fortran_order': False, 'shape': (3, 2), }", values, 6);
+    mapped_columns m = read_npy(filename); // C order, so each row together.
+    BOOST_REQUIRE_EQUAL(m.size(), 2U);
+    BOOST_REQUIRE_EQUAL(m.rows(), 3U);
+    const double x[] = {0., 2., 4.};
+    const double y[] = {1., 3., 5.};
+    BOOST_CHECK_EQUAL_COLLECTIONS(m.column(0).begin(), m.column(0).end(), x, x + 3);
+    BOOST_CHECK_EQUAL_COLLECTIONS(m.column(1).begin(), m.column(1).end(), y, y + 3);
+  }
+  {
+    write_npy(filename, "{'descr': '<f8', 'fortran_order': True, 'shape': (3, 2), }", values, 6, 2);
+    mapped_columns m = read_npy(filename); // Fortran order, so each column together (and version 2 header).
+    BOOST_REQUIRE_EQUAL(m.size(), 2U);
+    BOOST_REQUIRE_EQUAL(m.rows(), 3U);
+    const double x[] = {0., 1., 2.};
+    const double y[] = {3., 4., 5.};
+    BOOST_CHECK_EQUAL_COLLECTIONS(m.column(0).begin(), m.column(0).end(), x, x + 3);
+    BOOST_CHECK_EQUAL_COLLECTIONS(m.column(1).begin(), m.column(1).end(), y, y + 3);
+  }
+  write_npy(filename, "{'descr': '<f4', 'fortran_order': False, 'shape': (6,), }", values, 3);
+  BOOST_CHECK_THROW(read_npy(filename), std::runtime_error); // Not float64.
+  write_npy(filename, "{'descr': '<f8', 'fortran_order': False, 'shape': (4, 2), }", values, 6);
+  BOOST_CHECK_THROW(read_npy(filename), std::runtime_error); // Fewer values than shape.
+  {
+    ofstream npy(filename, std::ios::binary);
+    npy.write("\x93NUMPY\x02\x00\x10\x00", 10); // Version 2, but no room for a 4-byte header length.
+  }
+  BOOST_CHECK_THROW(read_npy(filename), std::runtime_error);
+  {
+    ofstream npy(filename, std::ios::binary);
+    npy.write("\x93NUMPY\x01\x00\x40\x00{'descr'", 17); // Header length 64, but only 7 bytes.
+  }
+  BOOST_CHECK_THROW(read_npy(filename), std::runtime_error);
+
+  {
+    ofstream raw(filename, std::ios::binary);
+    raw.write(reinterpret_cast<const char*>(values), sizeof(values));
+  }
+  {
+    mapped_columns m = read_float64(filename, 2); // Interleaved X, Y.
+    BOOST_REQUIRE_EQUAL(m.size(), 2U);
+    BOOST_REQUIRE_EQUAL(m.rows(), 3U);
+    BOOST_CHECK_EQUAL(m.column(0)[2], 4.);
+    BOOST_CHECK_EQUAL(m.column(1)[2], 5.);
+    BOOST_CHECK_EQUAL(read_float64(filename).rows(), 6U);
+    BOOST_CHECK_THROW(read_float64(filename, 4), std::runtime_error); // Not whole rows.
+  }
+  std::remove(filename);
+} // BOOST_AUTO_TEST_CASE(test_read_binary)
+
 /*
 
 Output: